@@ -1559,6 +1559,60 @@ nm_utils_ip_route_attribute_to_platform(int                addr_family,
 
 /*****************************************************************************/
 
+/**
+ * nm_utils_ip_address_data_to_dbus:
+ * @addr_family: the address family of @address.
+ * @address: the address to convert.
+ *
+ * Returns: (transfer floating): the "a{sv}" element for @address as exposed
+ *   in the "AddressData" property.
+ */
+GVariant *
+nm_utils_ip_address_data_to_dbus(int addr_family, const NMPlatformIPXAddress *address)
+{
+    const int       IS_IPv4 = NM_IS_IPv4(addr_family);
+    GVariantBuilder addr_builder;
+    char            addr_str[NM_INET_ADDRSTRLEN];
+    gconstpointer   p;
+
+    g_variant_builder_init(&addr_builder, G_VARIANT_TYPE("a{sv}"));
+
+    g_variant_builder_add(
+        &addr_builder,
+        "{sv}",
+        "address",
+        g_variant_new_string(nm_inet_ntop(addr_family, address->ax.address_ptr, addr_str)));
+
+    g_variant_builder_add(&addr_builder, "{sv}", "prefix", g_variant_new_uint32(address->ax.plen));
+
+    p = NULL;
+    if (IS_IPv4) {
+        if (address->a4.peer_address != address->a4.address)
+            p = &address->a4.peer_address;
+    } else {
+        if (!IN6_IS_ADDR_UNSPECIFIED(&address->a6.peer_address)
+            && !IN6_ARE_ADDR_EQUAL(&address->a6.peer_address, &address->a6.address))
+            p = &address->a6.peer_address;
+    }
+    if (p) {
+        g_variant_builder_add(&addr_builder,
+                              "{sv}",
+                              "peer",
+                              g_variant_new_string(nm_inet_ntop(addr_family, p, addr_str)));
+    }
+
+    if (IS_IPv4) {
+        if (*address->a4.label) {
+            g_variant_builder_add(&addr_builder,
+                                  "{sv}",
+                                  NM_IP_ADDRESS_ATTRIBUTE_LABEL,
+                                  g_variant_new_string(address->a4.label));
+        }
+    }
+
+    return g_variant_builder_end(&addr_builder);
+}
+
 void
 nm_utils_ip_addresses_to_dbus(int                          addr_family,
                               const NMDedupMultiHeadEntry *head_entry,
@@ -1569,10 +1623,8 @@ nm_utils_ip_addresses_to_dbus(int                          addr_family,
     const int        IS_IPv4 = NM_IS_IPv4(addr_family);
     GVariantBuilder  builder_data;
     GVariantBuilder  builder_legacy;
-    char             addr_str[NM_INET_ADDRSTRLEN];
     NMDedupMultiIter iter;
     const NMPObject *obj;
-    const gsize      MAX_ADDRESSES = 100;
     gsize            i;
 
     nm_assert_addr_family(addr_family);
@@ -1595,54 +1647,14 @@ nm_utils_ip_addresses_to_dbus(int                          addr_family,
         nm_platform_dedup_multi_iter_next_obj(&iter, &obj, NMP_OBJECT_TYPE_IP_ADDRESS(IS_IPv4))) {
         const NMPlatformIPXAddress *address = NMP_OBJECT_CAST_IPX_ADDRESS(obj);
 
-        if (i > MAX_ADDRESSES) {
+        if (i >= NM_UTILS_IP_ADDRESSES_TO_DBUS_MAX) {
             /* Limited. The rest is hidden. */
             break;
         }
 
         if (out_address_data) {
-            GVariantBuilder addr_builder;
-            gconstpointer   p;
-
-            g_variant_builder_init(&addr_builder, G_VARIANT_TYPE("a{sv}"));
-
-            g_variant_builder_add(
-                &addr_builder,
-                "{sv}",
-                "address",
-                g_variant_new_string(nm_inet_ntop(addr_family, address->ax.address_ptr, addr_str)));
-
-            g_variant_builder_add(&addr_builder,
-                                  "{sv}",
-                                  "prefix",
-                                  g_variant_new_uint32(address->ax.plen));
-
-            p = NULL;
-            if (IS_IPv4) {
-                if (address->a4.peer_address != address->a4.address)
-                    p = &address->a4.peer_address;
-            } else {
-                if (!IN6_IS_ADDR_UNSPECIFIED(&address->a6.peer_address)
-                    && !IN6_ARE_ADDR_EQUAL(&address->a6.peer_address, &address->a6.address))
-                    p = &address->a6.peer_address;
-            }
-            if (p) {
-                g_variant_builder_add(&addr_builder,
-                                      "{sv}",
-                                      "peer",
-                                      g_variant_new_string(nm_inet_ntop(addr_family, p, addr_str)));
-            }
-
-            if (IS_IPv4) {
-                if (*address->a4.label) {
-                    g_variant_builder_add(&addr_builder,
-                                          "{sv}",
-                                          NM_IP_ADDRESS_ATTRIBUTE_LABEL,
-                                          g_variant_new_string(address->a4.label));
-                }
-            }
-
-            g_variant_builder_add(&builder_data, "a{sv}", &addr_builder);
+            g_variant_builder_add_value(&builder_data,
+                                        nm_utils_ip_address_data_to_dbus(addr_family, address));
         }
 
         if (out_addresses) {
@@ -1677,9 +1689,73 @@ out:
     NM_SET_OUT(out_addresses, g_variant_builder_end(&builder_legacy));
 }
 
+/**
+ * nm_utils_ip_route_data_to_dbus:
+ * @addr_family: the address family of @r.
+ * @r: the route to convert.
+ *
+ * Returns: (transfer floating): the "a{sv}" element for @r as exposed in
+ *   the "RouteData" property.
+ */
+GVariant *
+nm_utils_ip_route_data_to_dbus(int addr_family, const NMPlatformIPXRoute *r)
+{
+    GVariantBuilder route_builder;
+    char            addr_str[NM_INET_ADDRSTRLEN];
+    gconstpointer   gateway;
+
+    g_variant_builder_init(&route_builder, G_VARIANT_TYPE("a{sv}"));
+
+    g_variant_builder_add(
+        &route_builder,
+        "{sv}",
+        "dest",
+        g_variant_new_string(nm_inet_ntop(addr_family, r->rx.network_ptr, addr_str)));
+
+    g_variant_builder_add(&route_builder, "{sv}", "prefix", g_variant_new_uint32(r->rx.plen));
+
+    gateway = nm_platform_ip_route_get_gateway(addr_family, &r->rx);
+    if (!nm_ip_addr_is_null(addr_family, gateway)) {
+        g_variant_builder_add(&route_builder,
+                              "{sv}",
+                              "next-hop",
+                              g_variant_new_string(nm_inet_ntop(addr_family, gateway, addr_str)));
+    }
+
+    g_variant_builder_add(&route_builder, "{sv}", "metric", g_variant_new_uint32(r->rx.metric));
+
+    if (!nm_platform_route_table_is_main(r->rx.table_coerced)) {
+        g_variant_builder_add(
+            &route_builder,
+            "{sv}",
+            "table",
+            g_variant_new_uint32(nm_platform_route_table_uncoerce(r->rx.table_coerced, TRUE)));
+    }
+
+    return g_variant_builder_end(&route_builder);
+}
+
+/**
+ * nm_utils_ip_routes_to_dbus:
+ * @addr_family: the address family.
+ * @head_entry: the routes from the platform cache.
+ * @route_data_cache_old: (nullable): a hash table from route #NMPObject to
+ *   its "RouteData" element, as filled by a previous call. Routes found there
+ *   are not converted again.
+ * @route_data_cache_new: (nullable): if given, is filled with the "RouteData"
+ *   elements for the exported routes. Pass it as @route_data_cache_old on the
+ *   next call.
+ * @out_route_data: (out) (optional): the "RouteData" property value.
+ * @out_routes: (out) (optional): the legacy "Routes" property value.
+ *
+ * Since objects in the platform cache are immutable, the route object itself
+ * is a valid key for the cache.
+ */
 void
 nm_utils_ip_routes_to_dbus(int                          addr_family,
                            const NMDedupMultiHeadEntry *head_entry,
+                           GHashTable                  *route_data_cache_old,
+                           GHashTable                  *route_data_cache_new,
                            GVariant                   **out_route_data,
                            GVariant                   **out_routes)
 {
@@ -1688,8 +1764,6 @@ nm_utils_ip_routes_to_dbus(int                          addr_family,
     const NMPObject *obj;
     GVariantBuilder  builder_data;
     GVariantBuilder  builder_legacy;
-    char             addr_str[NM_INET_ADDRSTRLEN];
-    const gsize      MAX_ROUTES = 100;
     gsize            i;
 
     nm_assert_addr_family(addr_family);
@@ -1722,7 +1796,7 @@ nm_utils_ip_routes_to_dbus(int                          addr_family,
         if (r->rx.type_coerced != nm_platform_route_type_coerce(RTN_UNICAST))
             continue;
 
-        if (i >= MAX_ROUTES) {
+        if (i >= NM_UTILS_IP_ROUTES_TO_DBUS_MAX) {
             /* Limited. The rest is hidden. */
             break;
         }
@@ -1730,46 +1804,21 @@ nm_utils_ip_routes_to_dbus(int                          addr_family,
         i++;
 
         if (out_route_data) {
-            GVariantBuilder route_builder;
-            gconstpointer   gateway;
-
-            g_variant_builder_init(&route_builder, G_VARIANT_TYPE("a{sv}"));
-
-            g_variant_builder_add(
-                &route_builder,
-                "{sv}",
-                "dest",
-                g_variant_new_string(nm_inet_ntop(addr_family, r->rx.network_ptr, addr_str)));
-
-            g_variant_builder_add(&route_builder,
-                                  "{sv}",
-                                  "prefix",
-                                  g_variant_new_uint32(r->rx.plen));
-
-            gateway = nm_platform_ip_route_get_gateway(addr_family, &r->rx);
-            if (!nm_ip_addr_is_null(addr_family, gateway)) {
-                g_variant_builder_add(
-                    &route_builder,
-                    "{sv}",
-                    "next-hop",
-                    g_variant_new_string(nm_inet_ntop(addr_family, gateway, addr_str)));
-            }
+            GVariant *v = NULL;
 
-            g_variant_builder_add(&route_builder,
-                                  "{sv}",
-                                  "metric",
-                                  g_variant_new_uint32(r->rx.metric));
+            if (route_data_cache_old)
+                v = g_hash_table_lookup(route_data_cache_old, obj);
+            if (v)
+                g_variant_ref(v);
+            else
+                v = g_variant_ref_sink(nm_utils_ip_route_data_to_dbus(addr_family, r));
 
-            if (!nm_platform_route_table_is_main(r->rx.table_coerced)) {
-                g_variant_builder_add(
-                    &route_builder,
-                    "{sv}",
-                    "table",
-                    g_variant_new_uint32(
-                        nm_platform_route_table_uncoerce(r->rx.table_coerced, TRUE)));
-            }
+            g_variant_builder_add_value(&builder_data, v);
 
-            g_variant_builder_add(&builder_data, "a{sv}", &route_builder);
+            if (route_data_cache_new)
+                g_hash_table_insert(route_data_cache_new, (gpointer) nmp_object_ref(obj), v);
+            else
+                g_variant_unref(v);
         }
 
         if (out_routes) {
@@ -1803,6 +1852,59 @@ nm_utils_ip_routes_to_dbus(int                          addr_family,
     NM_SET_OUT(out_routes, g_variant_builder_end(&builder_legacy));
 }
 
+/**
+ * nm_utils_ip_objs_to_dbus_page:
+ * @addr_family: the address family.
+ * @objs: (nullable): the exported addresses or routes, as #NMPObject
+ *   instances of one type.
+ * @data_cache: (nullable): a hash table from #NMPObject to its "a{sv}"
+ *   element, as filled by nm_utils_ip_routes_to_dbus().
+ * @offset: the number of elements of @objs to skip.
+ * @limit: the maximum number of elements to return.
+ *
+ * Returns: (transfer floating): an "aa{sv}" with the elements of @objs in
+ *   the range [@offset, @offset + @limit), in the format of the "AddressData"
+ *   or "RouteData" property. It is empty if @offset is past the end or
+ *   @limit is zero.
+ */
+GVariant *
+nm_utils_ip_objs_to_dbus_page(int              addr_family,
+                              const GPtrArray *objs,
+                              GHashTable      *data_cache,
+                              guint32          offset,
+                              guint32          limit)
+{
+    const int       IS_IPv4 = NM_IS_IPv4(addr_family);
+    GVariantBuilder builder;
+    guint           len = nm_g_ptr_array_len(objs);
+    guint           i;
+    guint           end;
+
+    nm_assert_addr_family(addr_family);
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("aa{sv}"));
+
+    if (offset < len) {
+        end = offset + MIN(limit, len - offset);
+        for (i = offset; i < end; i++) {
+            const NMPObject *obj = objs->pdata[i];
+            GVariant        *v;
+
+            v = nm_g_hash_table_lookup(data_cache, obj);
+            if (!v) {
+                if (NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_IP_ADDRESS(IS_IPv4))
+                    v = nm_utils_ip_address_data_to_dbus(addr_family,
+                                                         NMP_OBJECT_CAST_IPX_ADDRESS(obj));
+                else
+                    v = nm_utils_ip_route_data_to_dbus(addr_family, NMP_OBJECT_CAST_IPX_ROUTE(obj));
+            }
+            g_variant_builder_add_value(&builder, v);
+        }
+    }
+
+    return g_variant_builder_end(&builder);
+}
+
 /*****************************************************************************/
 
 NMSetting *
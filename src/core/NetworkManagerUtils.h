@@ -183,17 +183,35 @@ void nm_utils_ip_route_attribute_to_platform(int                addr_family,
                                              NMPlatformIPRoute *r,
                                              gint64             route_table);
 
+/* The maximum number of addresses exposed in the "AddressData" and "Addresses" properties. */
+#define NM_UTILS_IP_ADDRESSES_TO_DBUS_MAX 100u
+
+GVariant *nm_utils_ip_address_data_to_dbus(int addr_family, const NMPlatformIPXAddress *address);
+
 void nm_utils_ip_addresses_to_dbus(int                          addr_family,
                                    const NMDedupMultiHeadEntry *head_entry,
                                    const NMPObject             *best_default_route,
                                    GVariant                   **out_address_data,
                                    GVariant                   **out_addresses);
 
+/* The maximum number of routes exposed in the "RouteData" and "Routes" properties. */
+#define NM_UTILS_IP_ROUTES_TO_DBUS_MAX 100u
+
+GVariant *nm_utils_ip_route_data_to_dbus(int addr_family, const NMPlatformIPXRoute *r);
+
 void nm_utils_ip_routes_to_dbus(int                          addr_family,
                                 const NMDedupMultiHeadEntry *head_entry,
+                                GHashTable                  *route_data_cache_old,
+                                GHashTable                  *route_data_cache_new,
                                 GVariant                   **out_route_data,
                                 GVariant                   **out_routes);
 
+GVariant *nm_utils_ip_objs_to_dbus_page(int              addr_family,
+                                        const GPtrArray *objs,
+                                        GHashTable      *data_cache,
+                                        guint32          offset,
+                                        guint32          limit);
+
 /*****************************************************************************/
 
 typedef enum _nm_packed {
@@ -11455,7 +11455,7 @@ _dev_ipdhcpx_notify(NMDhcpClient *client, const NMDhcpClientNotifyData *notify_d
                                             FALSE);
 
         if (notify_data->lease_update.accepted) {
-            nm_manager_write_device_state(priv->manager, self, NULL);
+            nm_manager_schedule_write_device_state(priv->manager, self);
             nm_dispatcher_call_device(NM_DISPATCHER_ACTION_DHCP_CHANGE_X(IS_IPv4),
                                       self,
                                       NULL,
@@ -11618,6 +11618,7 @@ _dev_ipdhcpx_start(NMDevice *self, int addr_family)
             .anycast_address         = _device_get_dhcp_anycast_address(self),
             .vendor_class_identifier = vendor_class_identifier,
             .use_fqdn                = hostname_is_fqdn,
+            .default_route           = !nm_setting_ip_config_get_never_default(s_ip),
             .reject_servers          = reject_servers,
             .v4 =
                 {
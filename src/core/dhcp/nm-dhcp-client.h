@@ -85,6 +85,22 @@ typedef struct {
     };
 } NMDhcpClientNotifyData;
 
+/* Whether the client got its first lease or gave up. It then no longer
+ * counts against "main.dhcp-max-inflight". */
+static inline gboolean
+nm_dhcp_client_notify_data_is_settled(const NMDhcpClientNotifyData *notify_data)
+{
+    switch (notify_data->notify_type) {
+    case NM_DHCP_CLIENT_NOTIFY_TYPE_LEASE_UPDATE:
+        return !!notify_data->lease_update.l3cd;
+    case NM_DHCP_CLIENT_NOTIFY_TYPE_NO_LEASE_TIMEOUT:
+    case NM_DHCP_CLIENT_NOTIFY_TYPE_IT_LOOKS_BAD:
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
 const char *nm_dhcp_client_event_type_to_string(NMDhcpClientEventType client_event_type);
 
 typedef struct {
@@ -151,6 +167,11 @@ typedef struct {
      * For DHCPv6 this is always TRUE. */
     bool use_fqdn : 1;
 
+    /* Whether the profile may provide the default route. NMDhcpManager
+     * starts such clients first when it limits concurrent starts. Only
+     * set for IPv4, DHCPv6 does not provide a default route. */
+    bool default_route : 1;
+
     union {
         struct {
             /* The address from the previous lease */
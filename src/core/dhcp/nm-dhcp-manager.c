@@ -25,6 +25,7 @@
 
 typedef struct {
     const NMDhcpClientFactory *client_factory;
+    NMDhcpStartQueue          *start_queue;
 } NMDhcpManagerPrivate;
 
 struct _NMDhcpManager {
@@ -71,6 +72,138 @@ const char *nm_dhcp_helper_path = LIBEXECDIR "/nm-dhcp-helper";
 
 /*****************************************************************************/
 
+/* A started client holds its slot in the start queue at most this long,
+ * even when its DHCP timeout is longer or infinite. Then the next client
+ * is started anyway. This is the default of ipv4.dhcp-timeout. */
+#define QUEUE_ADMISSION_TIMEOUT_MSEC (45 * NM_UTILS_MSEC_PER_SEC)
+
+
+static guint
+_queue_get_max_inflight(void)
+{
+    return nm_config_data_get_value_int64(NM_CONFIG_GET_DATA,
+                                          NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                          NM_CONFIG_KEYFILE_KEY_MAIN_DHCP_MAX_INFLIGHT,
+                                          10,
+                                          0,
+                                          G_MAXINT32,
+                                          NM_CONFIG_DEFAULT_MAIN_DHCP_MAX_INFLIGHT);
+}
+
+static guint
+_queue_get_start_jitter(void)
+{
+    return nm_config_data_get_value_int64(NM_CONFIG_GET_DATA,
+                                          NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                          NM_CONFIG_KEYFILE_KEY_MAIN_DHCP_START_JITTER,
+                                          10,
+                                          0,
+                                          60000,
+                                          NM_CONFIG_DEFAULT_MAIN_DHCP_START_JITTER);
+}
+
+static void _queue_client_notify_cb(NMDhcpClient                 *client,
+                                    const NMDhcpClientNotifyData *notify_data,
+                                    NMDhcpManager                *self);
+
+static void
+_queue_client_weak_cb(gpointer user_data, GObject *where_the_object_was)
+{
+    NMDhcpManager *self = user_data;
+
+    /* The client is gone, its signal handlers too. */
+    nm_dhcp_start_queue_remove(NM_DHCP_MANAGER_GET_PRIVATE(self)->start_queue,
+                               where_the_object_was);
+}
+
+static void
+_queue_client_release(gpointer item, gpointer user_data)
+{
+    NMDhcpClient  *client = item;
+    NMDhcpManager *self   = user_data;
+
+    g_signal_handlers_disconnect_by_func(client, G_CALLBACK(_queue_client_notify_cb), self);
+    g_object_weak_unref(G_OBJECT(client), _queue_client_weak_cb, self);
+}
+
+static void
+_queue_client_notify_cb(NMDhcpClient                 *client,
+                        const NMDhcpClientNotifyData *notify_data,
+                        NMDhcpManager                *self)
+{
+    if (!nm_dhcp_client_notify_data_is_settled(notify_data))
+        return;
+
+    /* The client got its lease (or gave up), make room for the next one. */
+    if (nm_dhcp_start_queue_remove(NM_DHCP_MANAGER_GET_PRIVATE(self)->start_queue, client))
+        _queue_client_release(client, self);
+}
+
+static gboolean
+_queue_start_cb(gpointer item, guint64 queue_msec, gpointer user_data)
+{
+    NMDhcpManager                *self        = user_data;
+    NMDhcpManagerPrivate         *priv        = NM_DHCP_MANAGER_GET_PRIVATE(self);
+    const NMDhcpStartQueueStats  *stats       = nm_dhcp_start_queue_get_stats(priv->start_queue);
+    gs_unref_object NMDhcpClient *client      = g_object_ref(item);
+    gs_free_error GError         *error       = NULL;
+    const int                     addr_family = nm_dhcp_client_get_addr_family(client);
+
+    _LOGD(addr_family,
+          "queue: starting client for %s after %" G_GUINT64_FORMAT
+          " msec (%u in flight, %u waiting)",
+          nm_dhcp_client_get_iface(client),
+          queue_msec,
+          stats->n_inflight,
+          stats->n_waiting);
+
+    if (!nm_dhcp_client_start(client, &error)) {
+        _LOGW(addr_family,
+              "queue: failed to start client for %s: %s",
+              nm_dhcp_client_get_iface(client),
+              error->message);
+        g_object_weak_unref(G_OBJECT(client), _queue_client_weak_cb, self);
+        /* This arms the no-lease timeout, after which the device gives up. */
+        _nm_dhcp_client_notify(client, NM_DHCP_CLIENT_EVENT_TYPE_FAIL, NULL);
+        return FALSE;
+    }
+
+    g_signal_connect(client, NM_DHCP_CLIENT_NOTIFY, G_CALLBACK(_queue_client_notify_cb), self);
+    return TRUE;
+}
+
+static gboolean
+_queue_add(NMDhcpManager *self, NMDhcpClient *client, const NMDhcpClientConfig *config)
+{
+    NMDhcpManagerPrivate        *priv = NM_DHCP_MANAGER_GET_PRIVATE(self);
+    const NMDhcpStartQueueStats *stats;
+
+    if (config->previous_lease) {
+        /* During a reapply, the device keeps using the previous lease
+         * only for a short time. Don't make it wait. */
+        return FALSE;
+    }
+
+    if (!nm_dhcp_start_queue_add(priv->start_queue,
+                                 client,
+                                 config->default_route,
+                                 _queue_get_max_inflight(),
+                                 _queue_get_start_jitter()))
+        return FALSE;
+
+    g_object_weak_ref(G_OBJECT(client), _queue_client_weak_cb, self);
+
+    stats = nm_dhcp_start_queue_get_stats(priv->start_queue);
+    _LOGT(config->addr_family,
+          "queue: client for %s waits (%u in flight, %u waiting)",
+          config->iface,
+          stats->n_inflight,
+          stats->n_waiting);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
 static const NMDhcpClientFactory *
 _client_factory_find_by_name(const char *name)
 {
@@ -231,6 +364,9 @@ nm_dhcp_manager_start_client(NMDhcpManager *self, NMDhcpClientConfig *config, GE
      * default outside of NetworkManager API.
      */
 
+    if (_queue_add(self, client, config))
+        return g_steal_pointer(&client);
+
     if (!nm_dhcp_client_start(client, error))
         return NULL;
 
@@ -248,6 +384,14 @@ nm_dhcp_manager_get_config(NMDhcpManager *self)
     return factory ? factory->name : NULL;
 }
 
+const NMDhcpStartQueueStats *
+nm_dhcp_manager_get_queue_stats(NMDhcpManager *self)
+{
+    g_return_val_if_fail(NM_IS_DHCP_MANAGER(self), NULL);
+
+    return nm_dhcp_start_queue_get_stats(NM_DHCP_MANAGER_GET_PRIVATE(self)->start_queue);
+}
+
 /*****************************************************************************/
 
 NM_DEFINE_SINGLETON_GETTER(NMDhcpManager, nm_dhcp_manager_get, NM_TYPE_DHCP_MANAGER);
@@ -268,6 +412,9 @@ nm_dhcp_manager_init(NMDhcpManager *self)
     int                        i;
     const NMDhcpClientFactory *client_factory = NULL;
 
+    priv->start_queue =
+        nm_dhcp_start_queue_new(_queue_start_cb, QUEUE_ADMISSION_TIMEOUT_MSEC, self);
+
     for (i = 0; i < (int) G_N_ELEMENTS(_nm_dhcp_manager_factories); i++) {
         const NMDhcpClientFactory *f = _nm_dhcp_manager_factories[i];
 
@@ -326,6 +473,21 @@ nm_dhcp_manager_init(NMDhcpManager *self)
     priv->client_factory = client_factory;
 }
 
+static void
+dispose(GObject *object)
+{
+    NMDhcpManagerPrivate *priv = NM_DHCP_MANAGER_GET_PRIVATE(object);
+
+    /* Clients that still wait are not started anymore. */
+    nm_dhcp_start_queue_free(g_steal_pointer(&priv->start_queue), _queue_client_release);
+
+    G_OBJECT_CLASS(nm_dhcp_manager_parent_class)->dispose(object);
+}
+
 static void
 nm_dhcp_manager_class_init(NMDhcpManagerClass *manager_class)
-{}
+{
+    GObjectClass *object_class = G_OBJECT_CLASS(manager_class);
+
+    object_class->dispose = dispose;
+}
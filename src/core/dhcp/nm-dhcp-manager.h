@@ -29,6 +29,8 @@ NMDhcpManager *nm_dhcp_manager_get(void);
 
 const char *nm_dhcp_manager_get_config(NMDhcpManager *self);
 
+const NMDhcpStartQueueStats *nm_dhcp_manager_get_queue_stats(NMDhcpManager *self);
+
 void nm_dhcp_manager_set_default_hostname(NMDhcpManager *manager, const char *hostname);
 
 NMDhcpClient *
@@ -10,6 +10,7 @@
 
 #include "libnm-std-aux/unaligned.h"
 #include "libnm-glib-aux/nm-dedup-multi.h"
+#include "libnm-glib-aux/nm-random-utils.h"
 #include "libnm-glib-aux/nm-str-buf.h"
 #include "libnm-systemd-shared/nm-sd-utils-shared.h"
 
@@ -1299,3 +1300,351 @@ nm_dhcp_lease_data_parse_search_list(const guint8 *data,
     g_ptr_array_add(array, NULL);
     return (char **) g_ptr_array_free(array, FALSE);
 }
+
+/*****************************************************************************/
+
+/* With "main.dhcp-max-inflight" or "main.dhcp-start-jitter", DHCP clients are
+ * not started right away, but queued. A client leaves the queue when its
+ * (random) start time arrived and fewer than the maximum number of clients
+ * are waiting for their first lease. The client stays accounted as in
+ * flight until it is removed, because it got a lease, gave up, or went away,
+ * or until the admission timeout expires. The latter does not depend on the
+ * DHCP timeout of the client, which may be infinite. */
+
+typedef struct {
+    /* Links the entry into the list of waiting or of in flight entries.
+     * Entries whose admission timeout expired are in neither. */
+    CList    queue_lst;
+    gpointer item;
+    gint64   queued_msec;
+    gint64   start_msec;
+    gint64   admitted_msec;
+    bool     default_route : 1;
+    bool     inflight : 1;
+    bool     expired : 1;
+} StartQueueEntry;
+
+struct _NMDhcpStartQueue {
+    NMDhcpStartQueueStartFunc start_func;
+    gpointer                  user_data;
+
+    /* item -> StartQueueEntry, for waiting and in flight items. */
+    GHashTable *entries;
+
+    /* Items that wait to be started, ordered by when they may start. */
+    CList pending_lst_head;
+
+    /* Started items, ordered by when they were started. */
+    CList inflight_lst_head;
+
+    GSource *timeout_source;
+    guint    max_inflight;
+    guint    admission_timeout_msec;
+
+    NMDhcpStartQueueStats stats;
+};
+
+static void _start_queue_schedule(NMDhcpStartQueue *queue);
+
+static void
+_start_queue_entry_free(gpointer ptr)
+{
+    StartQueueEntry *entry = ptr;
+
+    c_list_unlink(&entry->queue_lst);
+    nm_g_slice_free(entry);
+}
+
+static void
+_start_queue_entry_remove(NMDhcpStartQueue *queue, StartQueueEntry *entry)
+{
+    if (entry->inflight)
+        queue->stats.n_inflight--;
+    else if (!entry->expired)
+        queue->stats.n_waiting--;
+    g_hash_table_remove(queue->entries, entry->item);
+}
+
+static void
+_start_queue_expire(NMDhcpStartQueue *queue, gint64 now_msec)
+{
+    StartQueueEntry *entry;
+
+    if (queue->admission_timeout_msec == 0)
+        return;
+
+    while ((entry = c_list_first_entry(&queue->inflight_lst_head, StartQueueEntry, queue_lst))) {
+        if (entry->admitted_msec + queue->admission_timeout_msec > now_msec)
+            return;
+
+        /* The item keeps running, but it no longer blocks the others. It
+         * stays in @entries until it gets removed. */
+        c_list_unlink(&entry->queue_lst);
+        entry->inflight = FALSE;
+        entry->expired  = TRUE;
+        queue->stats.n_inflight--;
+        queue->stats.n_expired++;
+
+        nm_log_dbg(LOGD_DHCP,
+                   "dhcp: queue: client did not settle within %u msec, free its slot",
+                   queue->admission_timeout_msec);
+    }
+}
+
+static gboolean
+_start_queue_timeout_cb(gpointer user_data)
+{
+    NMDhcpStartQueue *queue   = user_data;
+    gboolean          started = FALSE;
+    StartQueueEntry  *entry;
+    gint64            now_msec;
+
+    nm_clear_g_source_inst(&queue->timeout_source);
+
+    now_msec = nm_utils_get_monotonic_timestamp_msec();
+
+    _start_queue_expire(queue, now_msec);
+
+    while ((entry = c_list_first_entry(&queue->pending_lst_head, StartQueueEntry, queue_lst))) {
+        gpointer item;
+        guint64  queue_msec;
+
+        if (queue->max_inflight > 0 && queue->stats.n_inflight >= queue->max_inflight)
+            break;
+        if (entry->start_msec > now_msec)
+            break;
+
+        item       = entry->item;
+        queue_msec = now_msec - entry->queued_msec;
+
+        c_list_unlink(&entry->queue_lst);
+        c_list_link_tail(&queue->inflight_lst_head, &entry->queue_lst);
+        entry->inflight      = TRUE;
+        entry->admitted_msec = now_msec;
+
+        queue->stats.n_waiting--;
+        queue->stats.n_inflight++;
+        queue->stats.n_queued++;
+        queue->stats.queue_msec_total += queue_msec;
+        queue->stats.queue_msec_max = NM_MAX(queue->stats.queue_msec_max, queue_msec);
+        started                     = TRUE;
+
+        if (!queue->start_func(item, queue_msec, queue->user_data)) {
+            /* The item failed to start, it does not take a slot. */
+            entry = g_hash_table_lookup(queue->entries, item);
+            if (entry)
+                _start_queue_entry_remove(queue, entry);
+        }
+    }
+
+    if (started && c_list_is_empty(&queue->pending_lst_head)) {
+        const NMDhcpStartQueueStats *stats = &queue->stats;
+
+        nm_log_dbg(LOGD_DHCP,
+                   "dhcp: queue: empty, %" G_GUINT64_FORMAT
+                   " clients started through the queue, %" G_GUINT64_FORMAT
+                   " msec average and %" G_GUINT64_FORMAT " msec maximum waiting time",
+                   stats->n_queued,
+                   stats->n_queued > 0 ? stats->queue_msec_total / stats->n_queued : 0u,
+                   stats->queue_msec_max);
+    }
+
+    _start_queue_schedule(queue);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_start_queue_schedule(NMDhcpStartQueue *queue)
+{
+    StartQueueEntry *entry;
+    gint64           expiry_msec = G_MAXINT64;
+    gint64           now_msec;
+
+    nm_clear_g_source_inst(&queue->timeout_source);
+
+    entry = c_list_first_entry(&queue->pending_lst_head, StartQueueEntry, queue_lst);
+    if (entry && (queue->max_inflight == 0 || queue->stats.n_inflight < queue->max_inflight))
+        expiry_msec = entry->start_msec;
+
+    /* While items wait for a free slot, wake up when the oldest slot
+     * gets freed by the admission timeout. */
+    if (entry && queue->admission_timeout_msec > 0) {
+        entry = c_list_first_entry(&queue->inflight_lst_head, StartQueueEntry, queue_lst);
+        if (entry)
+            expiry_msec =
+                NM_MIN(expiry_msec, entry->admitted_msec + queue->admission_timeout_msec);
+    }
+
+    if (expiry_msec == G_MAXINT64)
+        return;
+
+    now_msec              = nm_utils_get_monotonic_timestamp_msec();
+    queue->timeout_source = nm_g_timeout_add_source(NM_MAX(expiry_msec - now_msec, 0),
+                                                    _start_queue_timeout_cb,
+                                                    queue);
+}
+
+static int
+_start_queue_entry_cmp(const StartQueueEntry *a, const StartQueueEntry *b)
+{
+    NM_CMP_FIELD_BOOL(b, a, default_route);
+    NM_CMP_FIELD(a, b, start_msec);
+    return 0;
+}
+
+/**
+ * nm_dhcp_start_queue_new:
+ * @start_func: called to start an item that leaves the queue.
+ * @admission_timeout_msec: how long a started item may hold its slot
+ *   before the next item is started anyway, or 0 for no limit.
+ * @user_data: the user data for @start_func.
+ *
+ * Returns: (transfer full): a new, empty queue.
+ */
+NMDhcpStartQueue *
+nm_dhcp_start_queue_new(NMDhcpStartQueueStartFunc start_func,
+                        guint                     admission_timeout_msec,
+                        gpointer                  user_data)
+{
+    NMDhcpStartQueue *queue;
+
+    nm_assert(start_func);
+
+    queue  = g_slice_new(NMDhcpStartQueue);
+    *queue = (NMDhcpStartQueue) {
+        .start_func             = start_func,
+        .user_data              = user_data,
+        .admission_timeout_msec = admission_timeout_msec,
+        .pending_lst_head       = C_LIST_INIT(queue->pending_lst_head),
+        .inflight_lst_head      = C_LIST_INIT(queue->inflight_lst_head),
+    };
+    queue->entries = g_hash_table_new_full(nm_direct_hash, NULL, NULL, _start_queue_entry_free);
+    return queue;
+}
+
+/**
+ * nm_dhcp_start_queue_free:
+ * @queue: the queue.
+ * @release_func: (nullable): called with each item that is still
+ *   waiting or in flight, and the user data of @queue.
+ *
+ * Frees @queue. Items that still wait are not started anymore.
+ */
+void
+nm_dhcp_start_queue_free(NMDhcpStartQueue *queue, GFunc release_func)
+{
+    GHashTableIter iter;
+    gpointer       item;
+
+    if (!queue)
+        return;
+
+    if (release_func) {
+        g_hash_table_iter_init(&iter, queue->entries);
+        while (g_hash_table_iter_next(&iter, &item, NULL))
+            release_func(item, queue->user_data);
+    }
+
+    nm_clear_g_source_inst(&queue->timeout_source);
+    g_hash_table_destroy(queue->entries);
+    nm_g_slice_free(queue);
+}
+
+/**
+ * nm_dhcp_start_queue_add:
+ * @queue: the queue.
+ * @item: the item to start. It must not be in @queue already.
+ * @default_route: whether the item may provide the default route. Such
+ *   items are not delayed by @start_jitter_msec, and go before other
+ *   waiting items.
+ * @max_inflight: the maximum number of items that are started and were
+ *   not yet removed, or 0 for no limit.
+ * @start_jitter_msec: the maximum random delay of the start.
+ *
+ * Returns: %TRUE if @item was queued and @queue will start it later.
+ *   %FALSE if the caller should start it right away, because there are
+ *   no limits and no other items are waiting.
+ */
+gboolean
+nm_dhcp_start_queue_add(NMDhcpStartQueue *queue,
+                        gpointer          item,
+                        gboolean          default_route,
+                        guint             max_inflight,
+                        guint             start_jitter_msec)
+{
+    StartQueueEntry *entry;
+    CList           *iter;
+    gint64           now_msec;
+
+    nm_assert(queue);
+    nm_assert(item);
+    nm_assert(!g_hash_table_contains(queue->entries, item));
+
+    queue->max_inflight = max_inflight;
+
+    if (max_inflight == 0 && start_jitter_msec == 0 && c_list_is_empty(&queue->pending_lst_head))
+        return FALSE;
+
+    now_msec = nm_utils_get_monotonic_timestamp_msec();
+
+    entry  = g_slice_new(StartQueueEntry);
+    *entry = (StartQueueEntry) {
+        .item          = item,
+        .queued_msec   = now_msec,
+        .start_msec    = now_msec,
+        .default_route = default_route,
+    };
+
+    /* Profiles with the default route are on the critical path of
+     * the activation, they only wait for a free slot. */
+    if (!default_route && start_jitter_msec > 0)
+        entry->start_msec += nm_random_u64_range(0, start_jitter_msec + 1u);
+
+    /* Keep the list sorted. Most items go to the end. */
+    iter = queue->pending_lst_head.prev;
+    while (iter != &queue->pending_lst_head
+           && _start_queue_entry_cmp(c_list_entry(iter, StartQueueEntry, queue_lst), entry) > 0)
+        iter = iter->prev;
+    c_list_link_after(iter, &entry->queue_lst);
+
+    g_hash_table_insert(queue->entries, item, entry);
+    queue->stats.n_waiting++;
+
+    _start_queue_schedule(queue);
+    return TRUE;
+}
+
+/**
+ * nm_dhcp_start_queue_remove:
+ * @queue: the queue.
+ * @item: the item to remove.
+ *
+ * Removes @item, because it got its first lease, gave up, or went away.
+ * If it was started and still holds its slot, this frees the slot for the
+ * next waiting item. Otherwise, it won't be started anymore.
+ *
+ * Returns: %TRUE if @item was in @queue.
+ */
+gboolean
+nm_dhcp_start_queue_remove(NMDhcpStartQueue *queue, gpointer item)
+{
+    StartQueueEntry *entry;
+
+    nm_assert(queue);
+
+    entry = g_hash_table_lookup(queue->entries, item);
+    if (!entry)
+        return FALSE;
+
+    _start_queue_entry_remove(queue, entry);
+    _start_queue_schedule(queue);
+    return TRUE;
+}
+
+const NMDhcpStartQueueStats *
+nm_dhcp_start_queue_get_stats(NMDhcpStartQueue *queue)
+{
+    nm_assert(queue);
+
+    return &queue->stats;
+}
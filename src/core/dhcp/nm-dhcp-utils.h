@@ -109,4 +109,48 @@ char   **nm_dhcp_lease_data_parse_search_list(const guint8 *data,
                                               int           addr_family,
                                               guint         option);
 
+/*****************************************************************************/
+
+typedef struct {
+    /* The number of items that were started through the queue. */
+    guint64 n_queued;
+
+    /* The time these items waited in the queue. */
+    guint64 queue_msec_total;
+    guint64 queue_msec_max;
+
+    /* The number of items that lost their slot because they did not
+     * get removed within the admission timeout. */
+    guint64 n_expired;
+
+    /* The number of items currently waiting, and the number of
+     * started items that were not removed or expired yet. */
+    guint n_waiting;
+    guint n_inflight;
+} NMDhcpStartQueueStats;
+
+typedef struct _NMDhcpStartQueue NMDhcpStartQueue;
+
+/* Returns %FALSE if @item could not be started. It then no
+ * longer counts as in flight. */
+typedef gboolean (*NMDhcpStartQueueStartFunc)(gpointer item,
+                                              guint64  queue_msec,
+                                              gpointer user_data);
+
+NMDhcpStartQueue *nm_dhcp_start_queue_new(NMDhcpStartQueueStartFunc start_func,
+                                          guint                     admission_timeout_msec,
+                                          gpointer                  user_data);
+
+void nm_dhcp_start_queue_free(NMDhcpStartQueue *queue, GFunc release_func);
+
+gboolean nm_dhcp_start_queue_add(NMDhcpStartQueue *queue,
+                                 gpointer          item,
+                                 gboolean          default_route,
+                                 guint             max_inflight,
+                                 guint             start_jitter_msec);
+
+gboolean nm_dhcp_start_queue_remove(NMDhcpStartQueue *queue, gpointer item);
+
+const NMDhcpStartQueueStats *nm_dhcp_start_queue_get_stats(NMDhcpStartQueue *queue);
+
 #endif /* __NETWORKMANAGER_DHCP_UTILS_H__ */
@@ -14,6 +14,7 @@
 
 #include "dhcp/nm-dhcp-utils.h"
 #include "dhcp/nm-dhcp-options.h"
+#include "dhcp/nm-dhcp-client.h"
 #include "libnm-platform/nm-platform.h"
 
 #include "nm-test-utils-core.h"
@@ -817,6 +818,211 @@ test_dhcp_opt_list(gconstpointer test_data)
 
 /*****************************************************************************/
 
+typedef struct {
+    GMainLoop *loop;
+    GArray    *started;
+    guint      n_wait;
+    guint      n_released;
+    int        fail_item;
+} StartQueueData;
+
+static gboolean
+_start_queue_start_cb(gpointer item, guint64 queue_msec, gpointer user_data)
+{
+    StartQueueData *data = user_data;
+    int             i    = GPOINTER_TO_INT(item);
+
+    g_array_append_val(data->started, i);
+    if (data->started->len == data->n_wait)
+        g_main_loop_quit(data->loop);
+    return i != data->fail_item;
+}
+
+static void
+_start_queue_release_cb(gpointer item, gpointer user_data)
+{
+    StartQueueData *data = user_data;
+
+    data->n_released++;
+}
+
+#define _start_queue_assert_started(data, ...)                                              \
+    G_STMT_START                                                                            \
+    {                                                                                       \
+        const int _expected[] = {__VA_ARGS__};                                              \
+        guint     _i;                                                                       \
+                                                                                            \
+        (data)->n_wait = G_N_ELEMENTS(_expected);                                           \
+        if ((data)->started->len < (data)->n_wait)                                          \
+            nmtst_main_loop_run_assert((data)->loop, 1000);                                 \
+        g_assert_cmpint((data)->started->len, ==, G_N_ELEMENTS(_expected));                 \
+        for (_i = 0; _i < G_N_ELEMENTS(_expected); _i++)                                    \
+            g_assert_cmpint(nm_g_array_index((data)->started, int, _i), ==, _expected[_i]); \
+                                                                                            \
+        /* Nothing else gets started. */                                                    \
+        (data)->n_wait = 0;                                                                 \
+        g_assert(!nmtst_main_loop_run((data)->loop, 50));                                   \
+        g_assert_cmpint((data)->started->len, ==, G_N_ELEMENTS(_expected));                 \
+    }                                                                                       \
+    G_STMT_END
+
+static void
+test_start_queue_limit(void)
+{
+    nm_auto_unref_dedup_multi_index NMDedupMultiIndex *multi_idx = nm_dedup_multi_index_new();
+    nm_auto_unref_l3cd_init NML3ConfigData            *l3cd      = NULL;
+    nm_auto_unref_gmainloop GMainLoop                 *loop      = g_main_loop_new(NULL, FALSE);
+    gs_unref_array GArray                             *started   = NULL;
+    StartQueueData                                     data;
+    NMDhcpStartQueue                                  *queue;
+    const NMDhcpStartQueueStats                       *stats;
+    NMDhcpClientNotifyData                             notify_data;
+    int                                                i;
+
+    started = g_array_new(FALSE, FALSE, sizeof(int));
+    data    = (StartQueueData) {.loop = loop, .started = started};
+    queue   = nm_dhcp_start_queue_new(_start_queue_start_cb, 0, &data);
+    stats   = nm_dhcp_start_queue_get_stats(queue);
+
+    /* Without limits, the caller starts right away. */
+    g_assert(!nm_dhcp_start_queue_add(queue, GINT_TO_POINTER(100), FALSE, 0, 0));
+    g_assert(!nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(100)));
+
+    /* More clients than the limit. */
+    for (i = 1; i <= 5; i++)
+        g_assert(nm_dhcp_start_queue_add(queue, GINT_TO_POINTER(i), FALSE, 2, 0));
+    g_assert_cmpint(started->len, ==, 0);
+    _start_queue_assert_started(&data, 1, 2);
+    g_assert_cmpint(stats->n_inflight, ==, 2);
+    g_assert_cmpint(stats->n_waiting, ==, 3);
+
+    /* Getting a lease frees a slot. */
+    l3cd        = nm_l3_config_data_new(multi_idx, 1, NM_IP_CONFIG_SOURCE_DHCP);
+    notify_data = (NMDhcpClientNotifyData) {
+        .notify_type       = NM_DHCP_CLIENT_NOTIFY_TYPE_LEASE_UPDATE,
+        .lease_update.l3cd = l3cd,
+    };
+    g_assert(nm_dhcp_client_notify_data_is_settled(&notify_data));
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(1)));
+    _start_queue_assert_started(&data, 1, 2, 3);
+
+    /* So do the no-lease timeout and "it looks bad". */
+    notify_data = (NMDhcpClientNotifyData) {
+        .notify_type = NM_DHCP_CLIENT_NOTIFY_TYPE_NO_LEASE_TIMEOUT,
+    };
+    g_assert(nm_dhcp_client_notify_data_is_settled(&notify_data));
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(2)));
+    _start_queue_assert_started(&data, 1, 2, 3, 4);
+
+    notify_data = (NMDhcpClientNotifyData) {
+        .notify_type = NM_DHCP_CLIENT_NOTIFY_TYPE_IT_LOOKS_BAD,
+    };
+    g_assert(nm_dhcp_client_notify_data_is_settled(&notify_data));
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(3)));
+    _start_queue_assert_started(&data, 1, 2, 3, 4, 5);
+    g_assert_cmpint(stats->n_inflight, ==, 2);
+    g_assert_cmpint(stats->n_waiting, ==, 0);
+
+    /* A lost lease or a delegated prefix keep the slot. */
+    notify_data = (NMDhcpClientNotifyData) {
+        .notify_type = NM_DHCP_CLIENT_NOTIFY_TYPE_LEASE_UPDATE,
+    };
+    g_assert(!nm_dhcp_client_notify_data_is_settled(&notify_data));
+    notify_data = (NMDhcpClientNotifyData) {
+        .notify_type = NM_DHCP_CLIENT_NOTIFY_TYPE_PREFIX_DELEGATED,
+    };
+    g_assert(!nm_dhcp_client_notify_data_is_settled(&notify_data));
+
+    /* A removed waiting client is not started, and a client that fails
+     * to start does not take a slot. */
+    data.fail_item = 7;
+    for (i = 6; i <= 8; i++)
+        g_assert(nm_dhcp_start_queue_add(queue, GINT_TO_POINTER(i), FALSE, 2, 0));
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(6)));
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(4)));
+    _start_queue_assert_started(&data, 1, 2, 3, 4, 5, 7, 8);
+    g_assert_cmpint(stats->n_inflight, ==, 2);
+    g_assert_cmpint(stats->n_waiting, ==, 0);
+    g_assert_cmpint(stats->n_queued, ==, 7);
+
+    nm_dhcp_start_queue_free(queue, _start_queue_release_cb);
+    g_assert_cmpint(data.n_released, ==, 2);
+}
+
+static void
+test_start_queue_order(void)
+{
+    nm_auto_unref_gmainloop GMainLoop *loop    = g_main_loop_new(NULL, FALSE);
+    gs_unref_array GArray             *started = g_array_new(FALSE, FALSE, sizeof(int));
+    StartQueueData                     data    = {.loop = loop, .started = started};
+    NMDhcpStartQueue                  *queue;
+
+    queue = nm_dhcp_start_queue_new(_start_queue_start_cb, 0, &data);
+
+    g_assert(nm_dhcp_start_queue_add(queue, GINT_TO_POINTER(1), FALSE, 1, 0));
+    _start_queue_assert_started(&data, 1);
+
+    /* Waiting clients start in FIFO order, but clients that may provide
+     * the default route go first. */
+    g_assert(nm_dhcp_start_queue_add(queue, GINT_TO_POINTER(2), FALSE, 1, 0));
+    g_assert(nm_dhcp_start_queue_add(queue, GINT_TO_POINTER(3), FALSE, 1, 0));
+    g_assert(nm_dhcp_start_queue_add(queue, GINT_TO_POINTER(4), TRUE, 1, 0));
+    g_assert(nm_dhcp_start_queue_add(queue, GINT_TO_POINTER(5), FALSE, 1, 0));
+    g_assert(nm_dhcp_start_queue_add(queue, GINT_TO_POINTER(6), TRUE, 1, 0));
+
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(1)));
+    _start_queue_assert_started(&data, 1, 4);
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(4)));
+    _start_queue_assert_started(&data, 1, 4, 6);
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(6)));
+    _start_queue_assert_started(&data, 1, 4, 6, 2);
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(2)));
+    _start_queue_assert_started(&data, 1, 4, 6, 2, 3);
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(3)));
+    _start_queue_assert_started(&data, 1, 4, 6, 2, 3, 5);
+
+    nm_dhcp_start_queue_free(queue, NULL);
+}
+
+static void
+test_start_queue_admission_timeout(void)
+{
+    nm_auto_unref_gmainloop GMainLoop *loop    = g_main_loop_new(NULL, FALSE);
+    gs_unref_array GArray             *started = g_array_new(FALSE, FALSE, sizeof(int));
+    StartQueueData                     data    = {.loop = loop, .started = started};
+    NMDhcpStartQueue                  *queue;
+    const NMDhcpStartQueueStats       *stats;
+    int                                i;
+
+    queue = nm_dhcp_start_queue_new(_start_queue_start_cb, 500, &data);
+    stats = nm_dhcp_start_queue_get_stats(queue);
+
+    for (i = 1; i <= 3; i++)
+        g_assert(nm_dhcp_start_queue_add(queue, GINT_TO_POINTER(i), FALSE, 1, 0));
+    _start_queue_assert_started(&data, 1);
+
+    /* A client that never settles (for example, with an infinite DHCP
+     * timeout) only holds its slot until the admission timeout. */
+    _start_queue_assert_started(&data, 1, 2);
+    g_assert_cmpint(stats->n_expired, ==, 1);
+    g_assert_cmpint(stats->n_inflight, ==, 1);
+    g_assert_cmpint(stats->n_waiting, ==, 1);
+
+    /* Removing the expired client does not free another slot. */
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(1)));
+    g_assert_cmpint(stats->n_inflight, ==, 1);
+    _start_queue_assert_started(&data, 1, 2);
+
+    g_assert(nm_dhcp_start_queue_remove(queue, GINT_TO_POINTER(2)));
+    _start_queue_assert_started(&data, 1, 2, 3);
+    g_assert_cmpint(stats->n_expired, ==, 1);
+
+    nm_dhcp_start_queue_free(queue, _start_queue_release_cb);
+    g_assert_cmpint(data.n_released, ==, 1);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -855,6 +1061,9 @@ main(int argc, char **argv)
     g_test_add_func("/dhcp/parse-search-list", test_parse_search_list);
     g_test_add_data_func("/dhcp/test_dhcp_opt_list/IPv4", GINT_TO_POINTER(0), test_dhcp_opt_list);
     g_test_add_data_func("/dhcp/test_dhcp_opt_list/IPv6", GINT_TO_POINTER(1), test_dhcp_opt_list);
+    g_test_add_func("/dhcp/start-queue/limit", test_start_queue_limit);
+    g_test_add_func("/dhcp/start-queue/order", test_start_queue_order);
+    g_test_add_func("/dhcp/start-queue/admission-timeout", test_start_queue_admission_timeout);
 
     return g_test_run();
 }
@@ -680,6 +680,10 @@ typedef struct {
 
     GVariant *set_server_ex_args;
 
+    /* The arguments of the last SetServersEx call that was sent
+     * to the current dnsmasq instance. */
+    GVariant *sent_server_ex_args;
+
     GCancellable *update_cancellable;
 
     GCancellable *main_cancellable;
@@ -688,9 +692,12 @@ typedef struct {
 
     GSource *main_timeout_source;
     GSource *burst_retry_timeout_source;
+    GSource *update_delay_source;
 
     gint64 burst_start_at;
 
+    gint64 update_start_nsec;
+
     GPid process_pid;
 
     guint name_owner_changed_id;
@@ -953,9 +960,12 @@ dnsmasq_update_done(GObject *source_object, GAsyncResult *res, gpointer user_dat
 
     nm_clear_g_cancellable(&priv->update_cancellable);
 
-    if (!response)
+    _nm_dns_plugin_push_done(NM_DNS_PLUGIN(self), priv->update_start_nsec, !!response);
+
+    if (!response) {
         _LOGW("dnsmasq update failed: %s", error->message);
-    else
+        nm_clear_pointer(&priv->sent_server_ex_args, g_variant_unref);
+    } else
         _LOGD("dnsmasq update successful");
 
     _update_pending_maybe_changed(self);
@@ -966,9 +976,22 @@ send_dnsmasq_update(NMDnsDnsmasq *self)
 {
     NMDnsDnsmasqPrivate *priv = NM_DNS_DNSMASQ_GET_PRIVATE(self);
 
+    nm_clear_g_source_inst(&priv->update_delay_source);
+
     if (!priv->name_owner || !priv->set_server_ex_args)
         return;
 
+    if (priv->sent_server_ex_args
+        && g_variant_equal(priv->sent_server_ex_args, priv->set_server_ex_args)) {
+        if (priv->set_server_ex_args_dirty) {
+            _LOGD("dnsmasq nameservers are up to date");
+            _nm_dns_plugin_push_skipped(NM_DNS_PLUGIN(self));
+            priv->set_server_ex_args_dirty = FALSE;
+            _update_pending_maybe_changed(self);
+        }
+        return;
+    }
+
     _LOGD("trying to update dnsmasq nameservers");
 
     nm_clear_g_cancellable(&priv->update_cancellable);
@@ -976,6 +999,10 @@ send_dnsmasq_update(NMDnsDnsmasq *self)
 
     priv->set_server_ex_args_dirty = FALSE;
 
+    nm_clear_pointer(&priv->sent_server_ex_args, g_variant_unref);
+    priv->sent_server_ex_args = g_variant_ref(priv->set_server_ex_args);
+    priv->update_start_nsec   = nm_utils_get_monotonic_timestamp_nsec();
+
     g_dbus_connection_call(priv->dbus_connection,
                            priv->name_owner,
                            DNSMASQ_DBUS_PATH,
@@ -1004,6 +1031,7 @@ _main_cleanup(NMDnsDnsmasq *self, gboolean emit_failed)
 
     priv->process_pid = 0;
     nm_clear_g_free(&priv->name_owner);
+    nm_clear_pointer(&priv->sent_server_ex_args, g_variant_unref);
 
     nm_clear_g_dbus_connection_signal(priv->dbus_connection, &priv->name_owner_changed_id);
 
@@ -1035,6 +1063,9 @@ name_owner_changed(NMDnsDnsmasq *self, const char *name_owner)
     g_free(priv->name_owner);
     priv->name_owner = g_strdup(name_owner);
 
+    /* This is a new dnsmasq instance, that has no servers from us. */
+    nm_clear_pointer(&priv->sent_server_ex_args, g_variant_unref);
+
     if (!name_owner) {
         _LOGT("D-Bus name for dnsmasq disappeared");
         _main_cleanup(self, TRUE);
@@ -1205,6 +1236,16 @@ start_dnsmasq(NMDnsDnsmasq *self, gboolean force_start, GError **error)
     return TRUE;
 }
 
+static gboolean
+_update_delay_cb(gpointer user_data)
+{
+    NMDnsDnsmasq *self = user_data;
+
+    send_dnsmasq_update(self);
+    _update_pending_maybe_changed(self);
+    return G_SOURCE_CONTINUE;
+}
+
 static gboolean
 update(NMDnsPlugin             *plugin,
        const NMGlobalDnsConfig *global_config,
@@ -1223,7 +1264,10 @@ update(NMDnsPlugin             *plugin,
         g_variant_ref_sink(create_update_args(self, global_config, ip_data_lst_head, hostdomain));
     priv->set_server_ex_args_dirty = TRUE;
 
-    send_dnsmasq_update(self);
+    if (!_nm_dns_plugin_schedule_push(NM_DNS_PLUGIN(self),
+                                      &priv->update_delay_source,
+                                      _update_delay_cb))
+        send_dnsmasq_update(self);
 
     _update_pending_maybe_changed(self);
     return TRUE;
@@ -1240,6 +1284,7 @@ stop(NMDnsPlugin *plugin)
     priv->is_stopped     = TRUE;
     priv->burst_start_at = 0;
     nm_clear_g_source_inst(&priv->burst_retry_timeout_source);
+    nm_clear_g_source_inst(&priv->update_delay_source);
 
     /* Cancelling the cancellable will also terminate the
      * process (in the background). */
@@ -1269,6 +1314,7 @@ dispose(GObject *object)
     priv->is_stopped = TRUE;
 
     nm_clear_g_source_inst(&priv->burst_retry_timeout_source);
+    nm_clear_g_source_inst(&priv->update_delay_source);
 
     _main_cleanup(self, FALSE);
 
@@ -69,6 +69,16 @@ typedef struct {
     const char *nis_domain;
     GPtrArray  *nis_servers;
     NMTernary   has_trust_ad;
+
+    /* Indexes of the arrays above, to find duplicates by hash. The keys
+     * are owned by the arrays. */
+    GHashTable *nameservers_idx;
+    GHashTable *searches_idx;
+    GHashTable *options_idx;
+    GHashTable *nis_servers_idx;
+
+    /* The (owned) names of the valid options in @options. */
+    GHashTable *option_names_idx;
 } NMResolvConfData;
 
 /*****************************************************************************/
@@ -110,11 +120,16 @@ typedef struct {
 
     bool update_pending : 1;
 
+    /* Whether @plugin_hash is the configuration that all plugins
+     * successfully got. */
+    bool plugin_hash_valid : 1;
+
     char *hostdomain;
     guint updates_queue;
 
     guint8 hash[HASH_LEN];      /* SHA1 hash of current DNS config */
     guint8 prev_hash[HASH_LEN]; /* Hash when begin_updates() was called */
+    guint8 plugin_hash[HASH_LEN]; /* Hash of the config last pushed to the plugins */
 
     NMDnsManagerResolvConfManager rc_manager;
     char                         *mode;
@@ -522,34 +537,53 @@ nm_dns_manager_get_systemd_resolved(NMDnsManager *self)
 /*****************************************************************************/
 
 static void
-add_string_item(GPtrArray *array, const char *str, gboolean dup)
+add_string_item(GPtrArray *array, GHashTable *idx, const char *str, gboolean dup)
 {
-    int i;
-
     g_return_if_fail(array != NULL);
     g_return_if_fail(str != NULL);
 
-    /* Check for dupes before adding */
-    for (i = 0; i < array->len; i++) {
-        const char *candidate = g_ptr_array_index(array, i);
-
-        if (candidate && !strcmp(candidate, str))
+    /* Check for dupes before adding. Without index, @array is expected
+     * to be short. */
+    if (idx) {
+        if (g_hash_table_contains(idx, str))
             return;
-    }
+    } else if (nm_strv_ptrarray_contains(array, str))
+        return;
 
     /* No dupes, add the new item */
-    g_ptr_array_add(array, dup ? g_strdup(str) : (gpointer) str);
+    if (dup)
+        str = g_strdup(str);
+    g_ptr_array_add(array, (gpointer) str);
+    if (idx)
+        g_hash_table_add(idx, (gpointer) str);
 }
 
 static void
-add_dns_option_item(GPtrArray *array, const char *str)
+add_dns_option_item(NMResolvConfData *rc, const char *str, gboolean match_name)
 {
-    if (_nm_utils_dns_option_find_idx((const char *const *) array->pdata, array->len, str) < 0)
-        g_ptr_array_add(array, g_strdup(str));
+    gs_free char *name = NULL;
+    gboolean      valid;
+
+    valid = _nm_utils_dns_option_validate(str, &name, NULL, AF_UNSPEC, NULL);
+
+    if (match_name) {
+        /* Like _nm_utils_dns_option_find_idx(), only the name of valid
+         * options is compared and the value is ignored. */
+        if (valid && g_hash_table_contains(rc->option_names_idx, name))
+            return;
+    } else if (g_hash_table_contains(rc->options_idx, str))
+        return;
+
+    str = g_strdup(str);
+    g_ptr_array_add(rc->options, (gpointer) str);
+    g_hash_table_add(rc->options_idx, (gpointer) str);
+    if (valid)
+        g_hash_table_add(rc->option_names_idx, g_steal_pointer(&name));
 }
 
 static void
 add_dns_domains(GPtrArray            *array,
+                GHashTable           *idx,
                 int                   addr_family,
                 const NML3ConfigData *l3cd,
                 gboolean              include_routing,
@@ -571,7 +605,7 @@ add_dns_domains(GPtrArray            *array,
             continue;
         if (!domain_is_valid(nm_utils_parse_dns_domain(str, NULL), FALSE, TRUE))
             continue;
-        add_string_item(array, str, dup);
+        add_string_item(array, idx, str, dup);
     }
     if (num_domains > 1 || num_searches == 0) {
         for (i = 0; i < num_domains; i++) {
@@ -580,7 +614,7 @@ add_dns_domains(GPtrArray            *array,
                 continue;
             if (!domain_is_valid(nm_utils_parse_dns_domain(str, NULL), FALSE, TRUE))
                 continue;
-            add_string_item(array, str, dup);
+            add_string_item(array, idx, str, dup);
         }
     }
 }
@@ -621,10 +655,10 @@ merge_one_l3cd(NMResolvConfData *rc, int addr_family, int ifindex, const NML3Con
             }
         }
 
-        add_string_item(rc->nameservers, buf, TRUE);
+        add_string_item(rc->nameservers, rc->nameservers_idx, buf, TRUE);
     }
 
-    add_dns_domains(rc->searches, addr_family, l3cd, FALSE, TRUE);
+    add_dns_domains(rc->searches, rc->searches_idx, addr_family, l3cd, FALSE, TRUE);
 
     has_trust_ad = FALSE;
     strarr       = nm_l3_config_data_get_dns_options(l3cd, addr_family, &num);
@@ -635,7 +669,7 @@ merge_one_l3cd(NMResolvConfData *rc, int addr_family, int ifindex, const NML3Con
             has_trust_ad = TRUE;
             continue;
         }
-        add_dns_option_item(rc->options, option);
+        add_dns_option_item(rc, option, TRUE);
     }
 
     if (num_nameservers == 0) {
@@ -655,7 +689,10 @@ merge_one_l3cd(NMResolvConfData *rc, int addr_family, int ifindex, const NML3Con
 
         nis_servers = nm_l3_config_data_get_nis_servers(l3cd, &num);
         for (i = 0; i < num; i++)
-            add_string_item(rc->nis_servers, nm_inet4_ntop(nis_servers[i], buf), TRUE);
+            add_string_item(rc->nis_servers,
+                            rc->nis_servers_idx,
+                            nm_inet4_ntop(nis_servers[i], buf),
+                            TRUE);
 
         if ((nis_domain = nm_l3_config_data_get_nis_domain(l3cd))) {
             /* FIXME: handle multiple domains */
@@ -1226,6 +1263,27 @@ update_resolv_conf(NMDnsManager                 *self,
     return write_file_result;
 }
 
+static const guint8 *
+_dns_config_ip_data_get_hash(NMDnsConfigIPData *ip_data)
+{
+    if (!ip_data->dns_hash_valid || ip_data->dns_hash_type != ip_data->ip_config_type) {
+        nm_auto_free_checksum GChecksum *sum = NULL;
+
+        sum = g_checksum_new(G_CHECKSUM_SHA1);
+        ip_data->dns_hash_empty = !nm_l3_config_data_hash_dns(ip_data->l3cd,
+                                                              sum,
+                                                              ip_data->addr_family,
+                                                              ip_data->ip_config_type);
+        nm_utils_checksum_get_digest_len(sum, ip_data->dns_hash, HASH_LEN);
+        ip_data->dns_hash_type  = ip_data->ip_config_type;
+        ip_data->dns_hash_valid = TRUE;
+    }
+
+    if (ip_data->dns_hash_empty)
+        return NULL;
+    return ip_data->dns_hash;
+}
+
 static void
 compute_hash(NMDnsManager *self, const NMGlobalDnsConfig *global, guint8 buffer[static HASH_LEN])
 {
@@ -1242,19 +1300,110 @@ compute_hash(NMDnsManager *self, const NMGlobalDnsConfig *global, guint8 buffer[
         const CList *head;
 
         /* FIXME(ip-config-checksum): this relies on the fact that an IP
-         * configuration without DNS parameters gives a zero checksum. */
+         * configuration without DNS parameters gives a zero checksum.
+         *
+         * The hash of each IP configuration is cached, so only the configurations
+         * that changed since the last time get hashed again. */
         head = _mgr_get_ip_data_lst_head(self);
         c_list_for_each_entry (ip_data, head, ip_data_lst) {
-            nm_l3_config_data_hash_dns(ip_data->l3cd,
-                                       sum,
-                                       ip_data->addr_family,
-                                       ip_data->ip_config_type);
+            const guint8 *ip_data_hash;
+
+            ip_data_hash = _dns_config_ip_data_get_hash(ip_data);
+            if (ip_data_hash)
+                g_checksum_update(sum, ip_data_hash, HASH_LEN);
         }
     }
 
     nm_utils_checksum_get_digest_len(sum, buffer, HASH_LEN);
 }
 
+static gboolean
+_dns_config_ip_data_get_add_wildcard(const NMDnsConfigIPData *ip_data)
+{
+    guint num;
+
+    nm_l3_config_data_get_nameservers(ip_data->l3cd, ip_data->addr_family, &num);
+    if (num == 0)
+        return FALSE;
+
+    if (nm_l3_config_data_get_best_default_route(ip_data->l3cd, ip_data->addr_family)) {
+        /* FIXME(l3cfg): the best-default route of a l3cd is not significant! */
+        return TRUE;
+    }
+
+    /* If a VPN has never-default=no but doesn't get a default
+     * route (this can happen for example when the server
+     * pushes routes with openconnect), and there are no
+     * search or routing domains, then the name servers pushed
+     * by the server would be unused. It is preferable in this
+     * case to use the VPN DNS server for all queries. */
+    return ip_data->ip_config_type == NM_DNS_IP_CONFIG_TYPE_VPN
+           && nm_l3_config_data_get_never_default(ip_data->l3cd, ip_data->addr_family)
+                  == NM_TERNARY_FALSE
+           && !nm_l3_config_data_get_searches(ip_data->l3cd, ip_data->addr_family, &num)
+           && !nm_l3_config_data_get_domains(ip_data->l3cd, ip_data->addr_family, &num);
+}
+
+/**
+ * nm_dns_config_ip_data_hash_plugin:
+ * @ip_data: the IP configuration.
+ * @sum: the checksum to update.
+ *
+ * Hashes what the DNS plugins get from @ip_data, beyond the DNS parameters
+ * that are already part of nm_l3_config_data_hash_dns().
+ */
+void
+nm_dns_config_ip_data_hash_plugin(const NMDnsConfigIPData *ip_data, GChecksum *sum)
+{
+    const struct {
+        int               ifindex;
+        int               addr_family;
+        int               dns_priority;
+        NMDnsIPConfigType ip_config_type;
+        int               has_best_default_route;
+        NMTernary         never_default;
+        int               add_wildcard;
+    } h = {
+        .ifindex        = ip_data->data->ifindex,
+        .addr_family    = ip_data->addr_family,
+        .dns_priority   = _dns_config_ip_data_get_dns_priority(ip_data),
+        .ip_config_type = ip_data->ip_config_type,
+        .has_best_default_route =
+            !!nm_l3_config_data_get_best_default_route(ip_data->l3cd, ip_data->addr_family),
+        .never_default = ip_data->ip_config_type == NM_DNS_IP_CONFIG_TYPE_VPN
+                             ? nm_l3_config_data_get_never_default(ip_data->l3cd,
+                                                                   ip_data->addr_family)
+                             : NM_TERNARY_DEFAULT,
+        .add_wildcard  = _dns_config_ip_data_get_add_wildcard(ip_data),
+    };
+
+    g_checksum_update(sum, (const guint8 *) &h, sizeof(h));
+}
+
+static void
+compute_plugin_hash(NMDnsManager *self, guint8 buffer[static HASH_LEN])
+{
+    NMDnsManagerPrivate             *priv = NM_DNS_MANAGER_GET_PRIVATE(self);
+    nm_auto_free_checksum GChecksum *sum  = NULL;
+    NMDnsConfigIPData               *ip_data;
+    const CList                     *head;
+
+    /* The plugins get the DNS configuration from priv->hash (which must
+     * be up to date), but also the interface, priority and default route of
+     * each IP configuration (even without DNS parameters) and the host domain. */
+    sum = g_checksum_new(G_CHECKSUM_SHA1);
+    g_checksum_update(sum, priv->hash, HASH_LEN);
+
+    head = _mgr_get_ip_data_lst_head(self);
+    c_list_for_each_entry (ip_data, head, ip_data_lst)
+        nm_dns_config_ip_data_hash_plugin(ip_data, sum);
+
+    if (priv->hostdomain)
+        g_checksum_update(sum, (const guint8 *) priv->hostdomain, strlen(priv->hostdomain) + 1);
+
+    nm_utils_checksum_get_digest_len(sum, buffer, HASH_LEN);
+}
+
 static gboolean
 merge_global_dns_config(NMResolvConfData *rc, NMGlobalDnsConfig *global_conf)
 {
@@ -1274,14 +1423,14 @@ merge_global_dns_config(NMResolvConfData *rc, NMGlobalDnsConfig *global_conf)
                 continue;
             if (!domain_is_valid(searches[i], FALSE, TRUE))
                 continue;
-            add_string_item(rc->searches, searches[i], TRUE);
+            add_string_item(rc->searches, rc->searches_idx, searches[i], TRUE);
         }
     }
 
     options = nm_global_dns_config_get_options(global_conf);
     if (options) {
         for (i = 0; options[i]; i++)
-            add_string_item(rc->options, options[i], TRUE);
+            add_dns_option_item(rc, options[i], FALSE);
     }
 
     default_domain = nm_global_dns_config_lookup_domain(global_conf, "*");
@@ -1299,7 +1448,7 @@ merge_global_dns_config(NMResolvConfData *rc, NMGlobalDnsConfig *global_conf)
         if (!nm_dns_uri_parse_plain(AF_UNSPEC, servers[i], addrstr, NULL))
             continue;
 
-        add_string_item(rc->nameservers, addrstr, TRUE);
+        add_string_item(rc->nameservers, rc->nameservers_idx, addrstr, TRUE);
     }
 
     return TRUE;
@@ -1344,12 +1493,17 @@ _collect_resolv_conf_data(NMDnsManager      *self,
 {
     NMDnsManagerPrivate *priv;
     NMResolvConfData     rc = {
-            .nameservers  = g_ptr_array_new(),
-            .searches     = g_ptr_array_new(),
-            .options      = g_ptr_array_new(),
-            .nis_domain   = NULL,
-            .nis_servers  = g_ptr_array_new(),
-            .has_trust_ad = NM_TERNARY_DEFAULT,
+            .nameservers      = g_ptr_array_new(),
+            .searches         = g_ptr_array_new(),
+            .options          = g_ptr_array_new(),
+            .nis_domain       = NULL,
+            .nis_servers      = g_ptr_array_new(),
+            .has_trust_ad     = NM_TERNARY_DEFAULT,
+            .nameservers_idx  = g_hash_table_new(nm_str_hash, g_str_equal),
+            .searches_idx     = g_hash_table_new(nm_str_hash, g_str_equal),
+            .options_idx      = g_hash_table_new(nm_str_hash, g_str_equal),
+            .nis_servers_idx  = g_hash_table_new(nm_str_hash, g_str_equal),
+            .option_names_idx = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL),
     };
 
     priv = NM_DNS_MANAGER_GET_PRIVATE(self);
@@ -1396,11 +1550,17 @@ _collect_resolv_conf_data(NMDnsManager      *self,
     }
 
     if (priv->hostdomain)
-        add_string_item(rc.searches, priv->hostdomain, TRUE);
+        add_string_item(rc.searches, rc.searches_idx, priv->hostdomain, TRUE);
 
     if (rc.has_trust_ad == NM_TERNARY_TRUE)
         g_ptr_array_add(rc.options, g_strdup(NM_SETTING_DNS_OPTION_TRUST_AD));
 
+    g_hash_table_unref(rc.nameservers_idx);
+    g_hash_table_unref(rc.searches_idx);
+    g_hash_table_unref(rc.options_idx);
+    g_hash_table_unref(rc.nis_servers_idx);
+    g_hash_table_unref(rc.option_names_idx);
+
     *out_searches    = _ptrarray_to_strv(rc.searches);
     *out_options     = _ptrarray_to_strv(rc.options);
     *out_nameservers = _ptrarray_to_strv(rc.nameservers);
@@ -1533,31 +1693,7 @@ _mgr_configs_data_construct(NMDnsManager *self)
 #endif
 
     c_list_for_each_entry (ip_data, head, ip_data_lst) {
-        gboolean add_wildcard = FALSE;
-        guint    num;
-
-        nm_l3_config_data_get_nameservers(ip_data->l3cd, ip_data->addr_family, &num);
-        if (num == 0)
-            continue;
-        if (nm_l3_config_data_get_best_default_route(ip_data->l3cd, ip_data->addr_family)) {
-            /* FIXME(l3cfg): the best-default route of a l3cd is not significant! */
-            add_wildcard = TRUE;
-        } else {
-            /* If a VPN has never-default=no but doesn't get a default
-             * route (this can happen for example when the server
-             * pushes routes with openconnect), and there are no
-             * search or routing domains, then the name servers pushed
-             * by the server would be unused. It is preferable in this
-             * case to use the VPN DNS server for all queries. */
-            if (ip_data->ip_config_type == NM_DNS_IP_CONFIG_TYPE_VPN
-                && nm_l3_config_data_get_never_default(ip_data->l3cd, ip_data->addr_family)
-                       == NM_TERNARY_FALSE
-                && !nm_l3_config_data_get_searches(ip_data->l3cd, ip_data->addr_family, &num)
-                && !nm_l3_config_data_get_domains(ip_data->l3cd, ip_data->addr_family, &num))
-                add_wildcard = TRUE;
-        }
-
-        if (add_wildcard) {
+        if (_dns_config_ip_data_get_add_wildcard(ip_data)) {
             if (!wildcard_entries)
                 wildcard_entries = g_hash_table_new(nm_direct_hash, NULL);
             g_hash_table_add(wildcard_entries, ip_data);
@@ -1767,6 +1903,9 @@ update_dns(NMDnsManager *self, gboolean no_caching, gboolean force_emit, GError
     gboolean              do_update           = TRUE;
     gboolean              resolv_conf_updated = FALSE;
     SpawnResult           result              = SR_SUCCESS;
+    gboolean              plugin_skip_update  = FALSE;
+    gboolean              plugin_all_updated  = TRUE;
+    guint8                plugin_hash[HASH_LEN];
     NMConfigData         *data;
     NMGlobalDnsConfig    *global_config;
     gs_free_error GError *local_error   = NULL;
@@ -1807,10 +1946,15 @@ update_dns(NMDnsManager *self, gboolean no_caching, gboolean force_emit, GError
                               &nis_servers,
                               &nis_domain);
 
-    if (priv->plugin || priv->sd_resolve_plugin)
-        _mgr_configs_data_construct(self);
+    if (priv->plugin || priv->sd_resolve_plugin) {
+        compute_plugin_hash(self, plugin_hash);
+        if (priv->plugin_hash_valid && memcmp(plugin_hash, priv->plugin_hash, HASH_LEN) == 0)
+            plugin_skip_update = TRUE;
+        else
+            _mgr_configs_data_construct(self);
+    }
 
-    if (priv->sd_resolve_plugin) {
+    if (priv->sd_resolve_plugin && !plugin_skip_update) {
         nm_dns_plugin_update(priv->sd_resolve_plugin,
                              global_config,
                              _mgr_get_ip_data_lst_head(self),
@@ -1827,11 +1971,17 @@ update_dns(NMDnsManager *self, gboolean no_caching, gboolean force_emit, GError
         if (nm_dns_plugin_is_caching(plugin)) {
             if (no_caching) {
                 _LOGD("update-dns: plugin %s ignored (caching disabled)", plugin_name);
+                plugin_all_updated = FALSE;
                 goto plugin_skip;
             }
             caching = TRUE;
         }
 
+        if (plugin_skip_update) {
+            _LOGD("update-dns: plugin %s already up to date", plugin_name);
+            goto plugin_skip;
+        }
+
         _LOGD("update-dns: updating plugin %s", plugin_name);
         if (!nm_dns_plugin_update(plugin,
                                   global_config,
@@ -1843,12 +1993,20 @@ update_dns(NMDnsManager *self, gboolean no_caching, gboolean force_emit, GError
             /* If the plugin failed to update, we shouldn't write out a local
              * caching DNS configuration to resolv.conf.
              */
-            caching = FALSE;
+            caching            = FALSE;
+            plugin_all_updated = FALSE;
         }
 
 plugin_skip:;
     }
 
+    if ((priv->plugin || priv->sd_resolve_plugin) && !plugin_skip_update) {
+        /* Remember what the plugins got, to skip the next update if the configuration
+         * is still the same. If any plugin didn't get it, update all of them again. */
+        priv->plugin_hash_valid = plugin_all_updated;
+        memcpy(priv->plugin_hash, plugin_hash, HASH_LEN);
+    }
+
     /* Clear the generated search list as it points to
      * strings owned by IP configurations and we can't
      * guarantee they stay alive. */
@@ -2546,6 +2704,9 @@ again:
             plugin_changed = TRUE;
     }
 
+    if (plugin_changed)
+        priv->plugin_hash_valid = FALSE;
+
     if (rc_manager == NM_DNS_MANAGER_RESOLV_CONF_MAN_AUTO) {
         rc_manager_was_auto = TRUE;
         if (nm_streq(mode, "systemd-resolved") || nm_streq(mode, "dnsconfd"))
@@ -2579,6 +2740,9 @@ again:
     } else if (_clear_sd_resolved_plugin(self))
         systemd_resolved_changed = TRUE;
 
+    if (systemd_resolved_changed)
+        priv->plugin_hash_valid = FALSE;
+
     g_object_freeze_notify(G_OBJECT(self));
 
     if (!nm_streq0(priv->mode, mode)) {
@@ -2658,7 +2822,9 @@ config_changed_cb(NMConfig           *config,
                          | NM_CONFIG_CHANGE_GLOBAL_DNS_CONFIG)) {
         gs_free_error GError *error = NULL;
 
-        priv->config_changed = TRUE;
+        /* Push the configuration to the plugins again, even if it didn't change. */
+        priv->config_changed    = TRUE;
+        priv->plugin_hash_valid = FALSE;
         if (!update_dns(self, FALSE, TRUE, &error))
             _LOGW("could not commit DNS changes: %s", error->message);
     }
@@ -2764,7 +2930,12 @@ _get_config_variant(NMDnsManager *self)
             else
                 g_ptr_array_set_size(array_domains, 0);
 
-            add_dns_domains(array_domains, ip_data->addr_family, ip_data->l3cd, TRUE, FALSE);
+            add_dns_domains(array_domains,
+                            NULL,
+                            ip_data->addr_family,
+                            ip_data->l3cd,
+                            TRUE,
+                            FALSE);
             if (array_domains->len) {
                 g_variant_builder_add(&entry_builder,
                                       "{sv}",
@@ -23,6 +23,15 @@ typedef struct {
     CList                    ip_data_lst;
     NMDnsIPConfigType        ip_config_type;
     int                      addr_family;
+
+    /* The cached result of nm_l3_config_data_hash_dns(). Since @l3cd is
+     * sealed and never replaced, this only needs to be recomputed when
+     * @ip_config_type changes. */
+    guint8            dns_hash[NM_UTILS_CHECKSUM_LENGTH_SHA1];
+    NMDnsIPConfigType dns_hash_type;
+    bool              dns_hash_valid : 1;
+    bool              dns_hash_empty : 1;
+
     struct {
         const char **search;
         char       **reverse;
@@ -58,6 +67,8 @@ typedef struct _NMDnsConfigData {
     CList                 configs_lst;
 } NMDnsConfigData;
 
+void nm_dns_config_ip_data_hash_plugin(const NMDnsConfigIPData *ip_data, GChecksum *sum);
+
 /*****************************************************************************/
 
 #define NM_TYPE_DNS_MANAGER (nm_dns_manager_get_type())
@@ -14,6 +14,7 @@
 
 #include "libnm-core-intern/nm-core-internal.h"
 #include "NetworkManagerUtils.h"
+#include "nm-config.h"
 
 /*****************************************************************************/
 
@@ -24,9 +25,17 @@ enum {
 
 static guint signals[LAST_SIGNAL] = {0};
 
+typedef struct {
+    const char *operation;
+    GVariant   *argument;
+    int         ifindex;
+} SentItem;
+
 typedef struct _NMDnsPluginPrivate {
-    bool update_pending_inited : 1;
-    bool update_pending : 1;
+    NMDnsPluginStats stats;
+    GHashTable      *sent_items;
+    bool             update_pending_inited : 1;
+    bool             update_pending : 1;
 } NMDnsPluginPrivate;
 
 G_DEFINE_ABSTRACT_TYPE(NMDnsPlugin, nm_dns_plugin, G_TYPE_OBJECT)
@@ -73,6 +82,8 @@ nm_dns_plugin_update(NMDnsPlugin             *self,
 {
     g_return_val_if_fail(NM_DNS_PLUGIN_GET_CLASS(self)->update != NULL, FALSE);
 
+    NM_DNS_PLUGIN_GET_PRIVATE(self)->stats.n_updates++;
+
     return NM_DNS_PLUGIN_GET_CLASS(self)->update(self,
                                                  global_config,
                                                  ip_config_lst_head,
@@ -101,13 +112,266 @@ nm_dns_plugin_get_name(NMDnsPlugin *self)
 void
 nm_dns_plugin_stop(NMDnsPlugin *self)
 {
-    NMDnsPluginClass *klass;
+    NMDnsPluginClass       *klass;
+    const NMDnsPluginStats *stats;
 
     g_return_if_fail(NM_IS_DNS_PLUGIN(self));
 
     klass = NM_DNS_PLUGIN_GET_CLASS(self);
     if (klass->stop)
         klass->stop(self);
+
+    stats = &NM_DNS_PLUGIN_GET_PRIVATE(self)->stats;
+    _LOGD("[%s] statistics: %" G_GUINT64_FORMAT " updates, %" G_GUINT64_FORMAT
+          " requests sent (%" G_GUINT64_FORMAT " failed), %" G_GUINT64_FORMAT
+          " requests skipped, %" G_GUINT64_FORMAT " msec average and %" G_GUINT64_FORMAT
+          " msec maximum request time",
+          nm_dns_plugin_get_name(self),
+          stats->n_updates,
+          stats->n_pushes,
+          stats->n_pushes_failed,
+          stats->n_pushes_skipped,
+          stats->n_pushes > 0 ? stats->push_usec_total / stats->n_pushes / 1000u : 0u,
+          stats->push_usec_max / 1000u);
+}
+
+/*****************************************************************************/
+
+const NMDnsPluginStats *
+nm_dns_plugin_get_stats(NMDnsPlugin *self)
+{
+    g_return_val_if_fail(NM_IS_DNS_PLUGIN(self), NULL);
+
+    return &NM_DNS_PLUGIN_GET_PRIVATE(self)->stats;
+}
+
+/**
+ * _nm_dns_plugin_schedule_push:
+ * @self: the #NMDnsPlugin
+ * @p_source: (inout): the timeout source of the plugin.
+ * @func: the callback that sends the pending configuration.
+ *
+ * Plugins call this when the configuration changed, to combine
+ * changes that happen in short succession. The timeout is not
+ * extended by later changes, so a change waits at most
+ * "dns-update-delay" milliseconds.
+ *
+ * Returns: %TRUE if @func is scheduled to send the configuration
+ *   and %FALSE if the caller should send it right away.
+ */
+gboolean
+_nm_dns_plugin_schedule_push(NMDnsPlugin *self, GSource **p_source, GSourceFunc func)
+{
+    guint delay_msec;
+
+    delay_msec = nm_config_data_get_dns_update_delay(NM_CONFIG_GET_DATA);
+    return _nm_dns_plugin_schedule_push_delay(self, p_source, func, delay_msec);
+}
+
+gboolean
+_nm_dns_plugin_schedule_push_delay(NMDnsPlugin *self,
+                                   GSource    **p_source,
+                                   GSourceFunc  func,
+                                   guint        delay_msec)
+{
+    nm_assert(NM_IS_DNS_PLUGIN(self));
+    nm_assert(p_source);
+
+    if (*p_source)
+        return TRUE;
+
+    if (delay_msec == 0)
+        return FALSE;
+
+    *p_source = nm_g_timeout_add_source(delay_msec, func, self);
+    return TRUE;
+}
+
+void
+_nm_dns_plugin_push_skipped(NMDnsPlugin *self)
+{
+    nm_assert(NM_IS_DNS_PLUGIN(self));
+
+    NM_DNS_PLUGIN_GET_PRIVATE(self)->stats.n_pushes_skipped++;
+}
+
+void
+_nm_dns_plugin_push_done(NMDnsPlugin *self, gint64 start_nsec, gboolean success)
+{
+    NMDnsPluginStats *stats;
+    guint64           usec;
+
+    nm_assert(NM_IS_DNS_PLUGIN(self));
+
+    stats = &NM_DNS_PLUGIN_GET_PRIVATE(self)->stats;
+    usec  = (nm_utils_get_monotonic_timestamp_nsec() - start_nsec) / 1000;
+
+    stats->n_pushes++;
+    if (!success)
+        stats->n_pushes_failed++;
+    stats->push_usec_total += usec;
+    stats->push_usec_max = NM_MAX(stats->push_usec_max, usec);
+}
+
+/*****************************************************************************/
+
+/* We remember the last argument that we sent for each operation and link.
+ * If the same request gets queued again, there is no need to send it. */
+
+static guint
+_sent_item_hash(gconstpointer ptr)
+{
+    const SentItem *sent_item = ptr;
+    NMHashState     h;
+
+    nm_hash_init(&h, 1623307447u);
+    nm_hash_update_val(&h, sent_item->ifindex);
+    nm_hash_update_str(&h, sent_item->operation);
+    return nm_hash_complete(&h);
+}
+
+static gboolean
+_sent_item_equal(gconstpointer ptr_a, gconstpointer ptr_b)
+{
+    const SentItem *a = ptr_a;
+    const SentItem *b = ptr_b;
+
+    return a->ifindex == b->ifindex && nm_streq(a->operation, b->operation);
+}
+
+static void
+_sent_item_free(gpointer ptr)
+{
+    SentItem *sent_item = ptr;
+
+    g_variant_unref(sent_item->argument);
+    nm_g_slice_free(sent_item);
+}
+
+/**
+ * _nm_dns_plugin_push_check_and_add:
+ * @self: the #NMDnsPlugin
+ * @operation: the name of the request. Must be a static string.
+ * @ifindex: the interface of the request, or 0.
+ * @argument: the argument of the request.
+ *
+ * Returns: %TRUE if the same request was already sent, and counts it
+ *   as skipped. Otherwise, remembers it as sent and returns %FALSE.
+ */
+gboolean
+_nm_dns_plugin_push_check_and_add(NMDnsPlugin *self,
+                                  const char  *operation,
+                                  int          ifindex,
+                                  GVariant    *argument)
+{
+    NMDnsPluginPrivate *priv;
+    SentItem           *sent_item;
+    const SentItem      needle = {
+             .operation = operation,
+             .ifindex   = ifindex,
+    };
+
+    nm_assert(NM_IS_DNS_PLUGIN(self));
+    nm_assert(operation);
+    nm_assert(argument);
+
+    priv = NM_DNS_PLUGIN_GET_PRIVATE(self);
+
+    if (!priv->sent_items) {
+        priv->sent_items =
+            g_hash_table_new_full(_sent_item_hash, _sent_item_equal, _sent_item_free, NULL);
+    }
+
+    sent_item = g_hash_table_lookup(priv->sent_items, &needle);
+    if (sent_item) {
+        if (g_variant_equal(sent_item->argument, argument)) {
+            _nm_dns_plugin_push_skipped(self);
+            return TRUE;
+        }
+        g_variant_unref(sent_item->argument);
+        sent_item->argument = g_variant_ref(argument);
+        return FALSE;
+    }
+
+    sent_item  = g_slice_new(SentItem);
+    *sent_item = (SentItem) {
+        .operation = operation,
+        .argument  = g_variant_ref(argument),
+        .ifindex   = ifindex,
+    };
+    g_hash_table_add(priv->sent_items, sent_item);
+    return FALSE;
+}
+
+/**
+ * _nm_dns_plugin_push_forget:
+ * @self: the #NMDnsPlugin
+ * @operation: the name of the request.
+ * @ifindex: the interface of the request, or 0.
+ * @argument: the argument of the request.
+ *
+ * Forgets that the request was sent, for example because it failed. This
+ * only has an effect if @argument is still the last argument that was sent
+ * for @operation and @ifindex.
+ */
+void
+_nm_dns_plugin_push_forget(NMDnsPlugin *self,
+                           const char  *operation,
+                           int          ifindex,
+                           GVariant    *argument)
+{
+    NMDnsPluginPrivate *priv;
+    SentItem           *sent_item;
+    const SentItem      needle = {
+             .operation = operation,
+             .ifindex   = ifindex,
+    };
+
+    nm_assert(NM_IS_DNS_PLUGIN(self));
+
+    priv = NM_DNS_PLUGIN_GET_PRIVATE(self);
+
+    if (!priv->sent_items)
+        return;
+
+    sent_item = g_hash_table_lookup(priv->sent_items, &needle);
+    if (sent_item && sent_item->argument == argument)
+        g_hash_table_remove(priv->sent_items, sent_item);
+}
+
+/**
+ * _nm_dns_plugin_push_forget_all:
+ * @self: the #NMDnsPlugin
+ * @keep_ifindexes: (nullable): if given, a set of interface indexes
+ *   (as GINT_TO_POINTER()) whose requests are still remembered.
+ *
+ * Forgets which requests were sent, so that they will all be sent
+ * again.
+ */
+void
+_nm_dns_plugin_push_forget_all(NMDnsPlugin *self, GHashTable *keep_ifindexes)
+{
+    NMDnsPluginPrivate *priv;
+    GHashTableIter      iter;
+    SentItem           *sent_item;
+
+    nm_assert(NM_IS_DNS_PLUGIN(self));
+
+    priv = NM_DNS_PLUGIN_GET_PRIVATE(self);
+
+    if (!priv->sent_items)
+        return;
+
+    if (!keep_ifindexes) {
+        g_hash_table_remove_all(priv->sent_items);
+        return;
+    }
+
+    g_hash_table_iter_init(&iter, priv->sent_items);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &sent_item, NULL)) {
+        if (!g_hash_table_contains(keep_ifindexes, GINT_TO_POINTER(sent_item->ifindex)))
+            g_hash_table_iter_remove(&iter);
+    }
 }
 
 /*****************************************************************************/
@@ -200,6 +464,17 @@ nm_dns_plugin_init(NMDnsPlugin *self)
     nm_shutdown_wait_obj_register_object(self, "dns-plugin");
 }
 
+static void
+finalize(GObject *object)
+{
+    NMDnsPlugin        *self = NM_DNS_PLUGIN(object);
+    NMDnsPluginPrivate *priv = NM_DNS_PLUGIN_GET_PRIVATE(self);
+
+    nm_clear_pointer(&priv->sent_items, g_hash_table_destroy);
+
+    G_OBJECT_CLASS(nm_dns_plugin_parent_class)->finalize(object);
+}
+
 static void
 nm_dns_plugin_class_init(NMDnsPluginClass *klass)
 {
@@ -207,6 +482,8 @@ nm_dns_plugin_class_init(NMDnsPluginClass *klass)
 
     g_type_class_add_private(object_class, sizeof(NMDnsPluginPrivate));
 
+    object_class->finalize = finalize;
+
     signals[UPDATE_PENDING_CHANGED] = g_signal_new(NM_DNS_PLUGIN_UPDATE_PENDING_CHANGED,
                                                    G_OBJECT_CLASS_TYPE(klass),
                                                    G_SIGNAL_RUN_FIRST,
@@ -23,6 +23,24 @@
 
 struct _NMDnsPluginPrivate;
 
+typedef struct {
+    /* The number of calls to nm_dns_plugin_update(). */
+    guint64 n_updates;
+
+    /* The number of requests sent to the DNS service, and how many
+     * of them failed. */
+    guint64 n_pushes;
+    guint64 n_pushes_failed;
+
+    /* The number of requests that were not sent, because the DNS service
+     * already has that configuration. */
+    guint64 n_pushes_skipped;
+
+    /* The time between sending a request and receiving the reply. */
+    guint64 push_usec_total;
+    guint64 push_usec_max;
+} NMDnsPluginStats;
+
 typedef struct {
     GObject                     parent;
     struct _NMDnsPluginPrivate *_priv;
@@ -72,6 +90,31 @@ void nm_dns_plugin_stop(NMDnsPlugin *self);
 
 gboolean nm_dns_plugin_get_update_pending(NMDnsPlugin *self);
 
+const NMDnsPluginStats *nm_dns_plugin_get_stats(NMDnsPlugin *self);
+
 void _nm_dns_plugin_update_pending_maybe_changed(NMDnsPlugin *self);
 
+gboolean _nm_dns_plugin_schedule_push(NMDnsPlugin *self, GSource **p_source, GSourceFunc func);
+
+gboolean _nm_dns_plugin_schedule_push_delay(NMDnsPlugin *self,
+                                            GSource    **p_source,
+                                            GSourceFunc  func,
+                                            guint        delay_msec);
+
+void _nm_dns_plugin_push_skipped(NMDnsPlugin *self);
+
+void _nm_dns_plugin_push_done(NMDnsPlugin *self, gint64 start_nsec, gboolean success);
+
+gboolean _nm_dns_plugin_push_check_and_add(NMDnsPlugin *self,
+                                           const char  *operation,
+                                           int          ifindex,
+                                           GVariant    *argument);
+
+void _nm_dns_plugin_push_forget(NMDnsPlugin *self,
+                                const char  *operation,
+                                int          ifindex,
+                                GVariant    *argument);
+
+void _nm_dns_plugin_push_forget_all(NMDnsPlugin *self, GHashTable *keep_ifindexes);
+
 #endif /* __NM_DNS_PLUGIN_H__ */
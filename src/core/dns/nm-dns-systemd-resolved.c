@@ -33,6 +33,10 @@
 #define SYSTEMD_RESOLVED_MANAGER_IFACE "org.freedesktop.resolve1.Manager"
 #define SYSTEMD_RESOLVED_DBUS_PATH     "/org/freedesktop/resolve1"
 
+/* How often we send the full configuration again, regardless of what we
+ * remember to have sent. */
+#define RESYNC_TIMEOUT_SEC 300
+
 /* define a variable, so that we can compare the operation with pointer equality. */
 static const char *const DBUS_OP_SET_LINK_DEFAULT_ROUTE = "SetLinkDefaultRoute";
 static const char *const DBUS_OP_SET_LINK_DNS_OVER_TLS  = "SetLinkDNSOverTLS";
@@ -50,6 +54,7 @@ typedef struct {
     const char           *operation;
     GVariant             *argument;
     NMDnsSystemdResolved *self;
+    gint64                start_nsec;
     int                   ifindex;
     int                   ref_count;
 } RequestItem;
@@ -78,6 +83,8 @@ struct _NMDnsSystemdResolvedResolveHandle {
 typedef struct {
     GDBusConnection *dbus_connection;
     GHashTable      *dirty_interfaces;
+    GSource         *send_updates_delay_source;
+    GSource         *resync_source;
     GCancellable    *cancellable;
     GCancellable    *service_start_cancellable;
     CList            request_queue_lst_head;
@@ -270,13 +277,15 @@ _interface_config_free(InterfaceConfig *config)
 static void
 call_done(GObject *source, GAsyncResult *r, gpointer user_data)
 {
-    gs_unref_variant GVariant   *v     = NULL;
-    gs_free_error GError        *error = NULL;
+    gs_unref_variant GVariant   *v        = NULL;
+    gs_unref_variant GVariant   *argument = NULL;
+    gs_free_error GError        *error    = NULL;
     NMDnsSystemdResolved        *self;
     NMDnsSystemdResolvedPrivate *priv;
     RequestItem                 *request_item;
     NMLogLevel                   log_level;
     const char                  *operation;
+    gint64                       start_nsec;
     int                          ifindex;
     gboolean                     reconfigure = FALSE;
 
@@ -284,6 +293,8 @@ call_done(GObject *source, GAsyncResult *r, gpointer user_data)
     self         = request_item->self;
     operation    = request_item->operation;
     ifindex      = request_item->ifindex;
+    start_nsec   = request_item->start_nsec;
+    argument     = g_variant_ref(request_item->argument);
     _request_item_unref(request_item);
 
     priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
@@ -292,6 +303,13 @@ call_done(GObject *source, GAsyncResult *r, gpointer user_data)
     if (nm_utils_error_is_cancelled(error))
         goto out_dec_pending;
 
+    _nm_dns_plugin_push_done(NM_DNS_PLUGIN(self), start_nsec, !!v);
+
+    if (!v) {
+        /* Send it again with the next update. */
+        _nm_dns_plugin_push_forget(NM_DNS_PLUGIN(self), operation, ifindex, argument);
+    }
+
     if (v) {
         if (operation == DBUS_OP_SET_LINK_DEFAULT_ROUTE) {
             if (priv->has_set_link_default_route == NM_TERNARY_DEFAULT) {
@@ -698,12 +716,17 @@ ensure_resolved_running(NMDnsSystemdResolved *self)
     return NM_TERNARY_TRUE;
 }
 
+static gboolean _resync_cb(gpointer user_data);
+
 static void
 send_updates(NMDnsSystemdResolved *self)
 {
     NMDnsSystemdResolvedPrivate       *priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
     RequestItem                       *request_item;
     NMDnsSystemdResolvedResolveHandle *handle;
+    guint                              n_skipped = 0;
+
+    nm_clear_g_source_inst(&priv->send_updates_delay_source);
 
     if (!priv->send_updates_waiting) {
         /* nothing to do. */
@@ -713,6 +736,12 @@ send_updates(NMDnsSystemdResolved *self)
     if (ensure_resolved_running(self) != NM_TERNARY_TRUE)
         return;
 
+    if (priv->n_pending > 0) {
+        /* We are about to cancel the requests in flight. We don't know whether
+         * they reached systemd-resolved, so send everything again. */
+        _nm_dns_plugin_push_forget_all(NM_DNS_PLUGIN(self), NULL);
+    }
+
     nm_clear_g_cancellable(&priv->cancellable);
 
     if (c_list_is_empty(&priv->request_queue_lst_head)) {
@@ -742,10 +771,20 @@ send_updates(NMDnsSystemdResolved *self)
             continue;
         }
 
+        if (_nm_dns_plugin_push_check_and_add(NM_DNS_PLUGIN(self),
+                                              request_item->operation,
+                                              request_item->ifindex,
+                                              request_item->argument)) {
+            n_skipped++;
+            continue;
+        }
+
         _LOGT("send-updates: %s ( %s )",
               request_item->operation,
               (ss = g_variant_print(request_item->argument, FALSE)));
 
+        request_item->start_nsec = nm_utils_get_monotonic_timestamp_nsec();
+
         if (priv->n_pending++ == 0) {
             /* We are inside send_updates(). All callers are already calling
              * _update_pending_maybe_changed() afterwards. */
@@ -766,6 +805,12 @@ send_updates(NMDnsSystemdResolved *self)
                                _request_item_ref(request_item));
     }
 
+    if (n_skipped > 0)
+        _LOGT("send-updates: skipped %u unchanged requests", n_skipped);
+
+    if (!priv->resync_source)
+        priv->resync_source = nm_g_timeout_add_seconds_source(RESYNC_TIMEOUT_SEC, _resync_cb, self);
+
 start_resolve:
     c_list_for_each_entry (handle, &priv->handle_lst_head, handle_lst) {
         if (handle->handle_cancellable)
@@ -776,6 +821,34 @@ start_resolve:
     }
 }
 
+static gboolean
+_resync_cb(gpointer user_data)
+{
+    NMDnsSystemdResolved        *self = user_data;
+    NMDnsSystemdResolvedPrivate *priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
+
+    nm_clear_g_source_inst(&priv->resync_source);
+
+    /* systemd-resolved might have lost our configuration without restarting,
+     * for example after "resolvectl revert". Send everything again. */
+    _LOGT("send-updates: resync");
+    _nm_dns_plugin_push_forget_all(NM_DNS_PLUGIN(self), NULL);
+    priv->send_updates_waiting = TRUE;
+    send_updates(self);
+    _update_pending_maybe_changed(self);
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+_send_updates_delay_cb(gpointer user_data)
+{
+    NMDnsSystemdResolved *self = user_data;
+
+    send_updates(self);
+    _update_pending_maybe_changed(self);
+    return G_SOURCE_CONTINUE;
+}
+
 static gboolean
 update(NMDnsPlugin             *plugin,
        const NMGlobalDnsConfig *global_config,
@@ -830,6 +903,10 @@ update(NMDnsPlugin             *plugin,
 
     free_pending_updates(self);
 
+    /* Forget what we sent for interfaces that we no longer track. If such
+     * an interface needs clearing below, the requests will be sent. */
+    _nm_dns_plugin_push_forget_all(NM_DNS_PLUGIN(self), interfaces);
+
     interfaces_arr = nm_utils_hash_to_array_with_buffer(interfaces,
                                                         &interfaces_len,
                                                         nm_cmp_int2ptr_p_with_data,
@@ -879,7 +956,10 @@ update(NMDnsPlugin             *plugin,
     }
 
     priv->send_updates_waiting = TRUE;
-    send_updates(self);
+    if (!_nm_dns_plugin_schedule_push(NM_DNS_PLUGIN(self),
+                                      &priv->send_updates_delay_source,
+                                      _send_updates_delay_cb))
+        send_updates(self);
     _update_pending_maybe_changed(self);
     return TRUE;
 }
@@ -901,6 +981,9 @@ name_owner_changed(NMDnsSystemdResolved *self, const char *owner)
     nm_clear_g_cancellable(&priv->service_start_cancellable);
     nm_strdup_reset(&priv->dbus_owner, owner);
 
+    /* A (re)started systemd-resolved has no configuration from us. */
+    _nm_dns_plugin_push_forget_all(NM_DNS_PLUGIN(self), NULL);
+
     if (owner) {
         priv->try_start_blocked    = FALSE;
         priv->send_updates_waiting = TRUE;
@@ -1254,6 +1337,9 @@ stop(NMDnsPlugin *plugin)
 
     free_pending_updates(self);
 
+    nm_clear_g_source_inst(&priv->send_updates_delay_source);
+    nm_clear_g_source_inst(&priv->resync_source);
+
     nm_clear_g_dbus_connection_signal(priv->dbus_connection, &priv->name_owner_changed_id);
 
     nm_clear_g_cancellable(&priv->service_start_cancellable);
@@ -420,6 +420,18 @@ main(int argc, char *argv[])
                                      NM_CONFIG_KEYFILE_KEY_LOGGING_BACKEND,
                                      NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
         nm_logging_init(v, nm_config_get_is_debug(config));
+
+        nm_clear_g_free(&v);
+        v = nm_config_data_get_value(NM_CONFIG_GET_DATA_ORIG,
+                                     NM_CONFIG_KEYFILE_GROUP_LOGGING,
+                                     NM_CONFIG_KEYFILE_KEY_LOGGING_ASYNC_QUEUE_LIMIT,
+                                     NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
+        nm_logging_async_start(
+            _nm_utils_ascii_str_to_int64(v,
+                                         10,
+                                         0,
+                                         1024 * 1024,
+                                         NM_CONFIG_DEFAULT_LOGGING_ASYNC_QUEUE_LIMIT));
     }
 
     nm_log_info(LOGD_CORE,
@@ -543,5 +555,7 @@ done_no_manager:
 
     nm_clear_g_source(&sd_id);
 
+    nm_logging_async_stop();
+
     exit(success ? 0 : 1);
 }
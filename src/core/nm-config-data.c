@@ -23,8 +23,11 @@ typedef struct {
         /* have a separate boolean field @has, because a @spec with
          * value %NULL does not necessarily mean, that the property
          * "match-device" was unspecified. */
-        gboolean has;
-        GSList  *spec;
+        gboolean           has;
+        NMMatchSpecDevice *spec;
+
+        /* index into MatchDeviceMemo.results, if @has. */
+        guint memo_idx;
     } match_device;
     union {
         struct {
@@ -84,6 +87,15 @@ typedef struct {
      * [device] sections. This is to speed up lookup. */
     MatchSectionInfo *device_infos;
 
+    /* Remembers for a device which of the "match-device" specs of the
+     * [connection*] and [device*] sections match. The same device is looked
+     * up many times for different properties. Since NMConfigData is immutable
+     * and replaced on reload, the memo never needs invalidation. The entries are
+     * keyed by the content of NMMatchSpecDeviceData, so a changed device gets
+     * a new entry. */
+    GHashTable *match_device_memo;
+    guint       match_device_memo_len;
+
     struct {
         gboolean enabled;
         char    *uri;
@@ -113,6 +125,8 @@ typedef struct {
 
     bool systemd_resolved : 1;
 
+    guint dns_update_delay;
+
     char *iwd_config_path;
 } NMConfigDataPrivate;
 
@@ -377,6 +391,14 @@ nm_config_data_get_systemd_resolved(const NMConfigData *self)
     return NM_CONFIG_DATA_GET_PRIVATE(self)->systemd_resolved;
 }
 
+guint
+nm_config_data_get_dns_update_delay(const NMConfigData *self)
+{
+    g_return_val_if_fail(self, 0);
+
+    return NM_CONFIG_DATA_GET_PRIVATE(self)->dns_update_delay;
+}
+
 const char *
 nm_config_data_get_iwd_config_path(const NMConfigData *self)
 {
@@ -1664,15 +1686,133 @@ global_dns_equal(NMGlobalDnsConfig *old, NMGlobalDnsConfig *new)
 
 /*****************************************************************************/
 
+#define MATCH_DEVICE_MEMO_MAX_SIZE 1024
+
+typedef struct {
+    /* must be the first field, the entry is hashed as NMMatchSpecDeviceData. */
+    NMMatchSpecDeviceData data;
+
+    /* For each section with "match-device", zero if not yet evaluated,
+     * otherwise 1 + whether the section matches. */
+    guint8 results[];
+} MatchDeviceMemo;
+
+static guint
+_match_device_data_hash(gconstpointer ptr)
+{
+    const NMMatchSpecDeviceData *d = ptr;
+    NMHashState                  h;
+
+    nm_hash_init(&h, 1513464191u);
+    nm_hash_update_str0(&h, d->interface_name);
+    nm_hash_update_str0(&h, d->device_type);
+    nm_hash_update_str0(&h, d->driver);
+    nm_hash_update_str0(&h, d->driver_version);
+    nm_hash_update_str0(&h, d->dhcp_plugin);
+    nm_hash_update_str0(&h, d->hwaddr);
+    nm_hash_update_str0(&h, d->s390_subchannels);
+    return nm_hash_complete(&h);
+}
+
+static gboolean
+_match_device_data_equal(gconstpointer ptr_a, gconstpointer ptr_b)
+{
+    const NMMatchSpecDeviceData *a = ptr_a;
+    const NMMatchSpecDeviceData *b = ptr_b;
+
+    return nm_streq0(a->interface_name, b->interface_name)
+           && nm_streq0(a->device_type, b->device_type) && nm_streq0(a->driver, b->driver)
+           && nm_streq0(a->driver_version, b->driver_version)
+           && nm_streq0(a->dhcp_plugin, b->dhcp_plugin) && nm_streq0(a->hwaddr, b->hwaddr)
+           && nm_streq0(a->s390_subchannels, b->s390_subchannels);
+}
+
+static MatchDeviceMemo *
+_match_device_memo_new(const NMMatchSpecDeviceData *match_data, guint n_results)
+{
+    const char *const *strs[] = {
+        &match_data->interface_name,
+        &match_data->device_type,
+        &match_data->driver,
+        &match_data->driver_version,
+        &match_data->dhcp_plugin,
+        &match_data->hwaddr,
+        &match_data->s390_subchannels,
+    };
+    const char     **dsts[G_N_ELEMENTS(strs)];
+    MatchDeviceMemo *memo;
+    gsize            sizes[G_N_ELEMENTS(strs)];
+    gsize            size;
+    char            *p;
+    guint            i;
+
+    size = sizeof(MatchDeviceMemo) + n_results;
+    for (i = 0; i < G_N_ELEMENTS(strs); i++) {
+        sizes[i] = *strs[i] ? strlen(*strs[i]) + 1 : 0;
+        size += sizes[i];
+    }
+
+    memo = g_malloc(size);
+    memo->data = (NMMatchSpecDeviceData) {};
+    memset(memo->results, 0, n_results);
+
+    dsts[0] = &memo->data.interface_name;
+    dsts[1] = &memo->data.device_type;
+    dsts[2] = &memo->data.driver;
+    dsts[3] = &memo->data.driver_version;
+    dsts[4] = &memo->data.dhcp_plugin;
+    dsts[5] = &memo->data.hwaddr;
+    dsts[6] = &memo->data.s390_subchannels;
+
+    p = (char *) &memo->results[n_results];
+    for (i = 0; i < G_N_ELEMENTS(strs); i++) {
+        if (!*strs[i])
+            continue;
+        *dsts[i] = memcpy(p, *strs[i], sizes[i]);
+        p += sizes[i];
+    }
+
+    return memo;
+}
+
+static guint8 *
+_match_device_memo_get(const NMConfigDataPrivate *priv, const NMMatchSpecDeviceData *match_data)
+{
+    NMConfigDataPrivate *priv_mutable = (NMConfigDataPrivate *) priv;
+    MatchDeviceMemo     *memo;
+
+    nm_assert(priv->match_device_memo_len > 0);
+
+    if (!priv_mutable->match_device_memo) {
+        priv_mutable->match_device_memo = g_hash_table_new_full(_match_device_data_hash,
+                                                                _match_device_data_equal,
+                                                                g_free,
+                                                                NULL);
+    }
+
+    memo = g_hash_table_lookup(priv->match_device_memo, match_data);
+    if (memo)
+        return memo->results;
+
+    /* Devices come and go (and get renamed). Don't grow without bound. */
+    if (g_hash_table_size(priv->match_device_memo) >= MATCH_DEVICE_MEMO_MAX_SIZE)
+        g_hash_table_remove_all(priv->match_device_memo);
+
+    memo = _match_device_memo_new(match_data, priv->match_device_memo_len);
+    g_hash_table_add(priv->match_device_memo, memo);
+    return memo->results;
+}
+
 static const MatchSectionInfo *
-_match_section_infos_lookup(const MatchSectionInfo      *match_section_infos,
-                            GKeyFile                    *keyfile,
+_match_section_infos_lookup(const NMConfigDataPrivate   *priv,
+                            const MatchSectionInfo      *match_section_infos,
                             const char                  *property,
                             const NMMatchSpecDeviceData *match_data,
                             NMDevice                    *device,
                             const char                 **out_value)
 {
     NMMatchSpecDeviceData match_data_local;
+    guint8               *memo = NULL;
 
     /* Caller must either provide a "match_data" or a "device" (actually,
      * neither is also fine, albeit unusual). */
@@ -1693,12 +1833,12 @@ _match_section_infos_lookup(const MatchSectionInfo      *match_section_infos,
          * string_to_value(keyfile_to_string(keyfile)) in one. Optimally, keyfile library would
          * expose both functions, and we would return here keyfile_to_string(keyfile).
          * The caller then could convert the string to the proper value via string_to_value(value). */
-        value = _match_section_info_get_str(match_section_infos, keyfile, property);
+        value = _match_section_info_get_str(match_section_infos, priv->keyfile, property);
         if (!value && !match_section_infos->stop_match)
             continue;
 
         if (match_section_infos->match_device.has) {
-            NMMatchSpecMatchType m;
+            guint8 *result;
 
             if (G_UNLIKELY(!match_data)) {
                 /* In most cases, we don't actually have any matches. So we "optimize"
@@ -1706,9 +1846,18 @@ _match_section_infos_lookup(const MatchSectionInfo      *match_section_infos,
                  * initialize the match-data when needed. */
                 match_data = nm_match_spec_device_data_init_from_device(&match_data_local, device);
             }
+            if (!memo)
+                memo = _match_device_memo_get(priv, match_data);
+
+            result = &memo[match_section_infos->match_device.memo_idx];
+            if (*result == 0) {
+                NMMatchSpecMatchType m;
 
-            m     = nm_match_spec_device(match_section_infos->match_device.spec, match_data);
-            match = nm_match_spec_match_type_to_bool(m, FALSE);
+                m = nm_match_spec_device_match(match_section_infos->match_device.spec,
+                                               match_data);
+                *result = 1 + nm_match_spec_match_type_to_bool(m, FALSE);
+            }
+            match = *result - 1;
         } else
             match = TRUE;
 
@@ -1744,8 +1893,8 @@ _config_data_get_device_config(const NMConfigData          *self,
 
     priv = NM_CONFIG_DATA_GET_PRIVATE(self);
 
-    connection_info = _match_section_infos_lookup(&priv->device_infos[0],
-                                                  priv->keyfile,
+    connection_info = _match_section_infos_lookup(priv,
+                                                  &priv->device_infos[0],
                                                   property,
                                                   match_data,
                                                   device,
@@ -1794,8 +1943,8 @@ nm_config_data_get_device_config_by_pllink(const NMConfigData   *self,
                                                  match_device_type,
                                                  nm_dhcp_manager_get_config(nm_dhcp_manager_get()));
 
-    connection_info = _match_section_infos_lookup(&priv->device_infos[0],
-                                                  priv->keyfile,
+    connection_info = _match_section_infos_lookup(priv,
+                                                  &priv->device_infos[0],
                                                   property,
                                                   &match_data,
                                                   NULL,
@@ -1854,8 +2003,8 @@ nm_config_data_get_device_allowed_connections_specs(const NMConfigData *self,
 
     priv = NM_CONFIG_DATA_GET_PRIVATE(self);
 
-    connection_info = _match_section_infos_lookup(&priv->device_infos[0],
-                                                  priv->keyfile,
+    connection_info = _match_section_infos_lookup(priv,
+                                                  &priv->device_infos[0],
                                                   NM_CONFIG_KEYFILE_KEY_DEVICE_ALLOWED_CONNECTIONS,
                                                   NULL,
                                                   device,
@@ -1898,8 +2047,8 @@ nm_config_data_get_connection_default(const NMConfigData *self,
     }
 #endif
 
-    _match_section_infos_lookup(&priv->connection_infos[0],
-                                priv->keyfile,
+    _match_section_infos_lookup(priv,
+                                &priv->connection_infos[0],
                                 property,
                                 NULL,
                                 device,
@@ -1945,7 +2094,8 @@ static void
 _match_section_info_init(MatchSectionInfo *connection_info,
                          GKeyFile         *keyfile,
                          char             *group,
-                         gboolean          is_device)
+                         gboolean          is_device,
+                         guint            *inout_memo_len)
 {
     char             **keys = NULL;
     gsize              n_keys;
@@ -1956,11 +2106,13 @@ _match_section_info_init(MatchSectionInfo *connection_info,
     /* pass ownership of @group on... */
     connection_info->group_name = group;
 
-    connection_info->match_device.spec =
+    connection_info->match_device.spec = nm_match_spec_device_new(
         nm_config_get_match_spec(keyfile,
                                  group,
                                  NM_CONFIG_KEYFILE_KEY_MATCH_DEVICE,
-                                 &connection_info->match_device.has);
+                                 &connection_info->match_device.has));
+    if (connection_info->match_device.has)
+        connection_info->match_device.memo_idx = (*inout_memo_len)++;
     connection_info->stop_match =
         nm_config_keyfile_get_boolean(keyfile, group, NM_CONFIG_KEYFILE_KEY_STOP_MATCH, FALSE);
 
@@ -2026,7 +2178,7 @@ _match_section_infos_free(MatchSectionInfo *match_section_infos)
 
     for (m = match_section_infos; m->group_name; m++) {
         g_free(m->group_name);
-        g_slist_free_full(m->match_device.spec, g_free);
+        nm_match_spec_device_free(m->match_device.spec);
         if (m->is_device) {
             g_slist_free_full(m->device.allowed_connections, g_free);
         }
@@ -2040,7 +2192,7 @@ _match_section_infos_free(MatchSectionInfo *match_section_infos)
 }
 
 static MatchSectionInfo *
-_match_section_infos_construct(GKeyFile *keyfile, gboolean is_device)
+_match_section_infos_construct(GKeyFile *keyfile, gboolean is_device, guint *inout_memo_len)
 {
     char            **groups;
     gsize             i, j, ngroups;
@@ -2087,11 +2239,16 @@ _match_section_infos_construct(GKeyFile *keyfile, gboolean is_device)
         _match_section_info_init(&match_section_infos[i],
                                  keyfile,
                                  groups[ngroups - i - 1],
-                                 is_device);
+                                 is_device,
+                                 inout_memo_len);
     }
     if (connection_tag) {
         /* pass ownership of @connection_tag on... */
-        _match_section_info_init(&match_section_infos[i], keyfile, connection_tag, is_device);
+        _match_section_info_init(&match_section_infos[i],
+                                 keyfile,
+                                 connection_tag,
+                                 is_device,
+                                 inout_memo_len);
     }
     g_free(groups);
 
@@ -2310,8 +2467,10 @@ constructed(GObject *object)
 
     priv->keyfile = _merge_keyfiles(priv->keyfile_user, priv->keyfile_intern);
 
-    priv->connection_infos = _match_section_infos_construct(priv->keyfile, FALSE);
-    priv->device_infos     = _match_section_infos_construct(priv->keyfile, TRUE);
+    priv->connection_infos =
+        _match_section_infos_construct(priv->keyfile, FALSE, &priv->match_device_memo_len);
+    priv->device_infos =
+        _match_section_infos_construct(priv->keyfile, TRUE, &priv->match_device_memo_len);
 
     priv->connectivity.enabled =
         nm_config_keyfile_get_boolean(priv->keyfile,
@@ -2370,6 +2529,16 @@ constructed(GObject *object)
                                       NM_CONFIG_KEYFILE_GROUP_MAIN,
                                       NM_CONFIG_KEYFILE_KEY_MAIN_SYSTEMD_RESOLVED,
                                       TRUE);
+    str                    = nm_config_keyfile_get_value(priv->keyfile,
+                                      NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                      NM_CONFIG_KEYFILE_KEY_MAIN_DNS_UPDATE_DELAY,
+                                      NM_CONFIG_GET_VALUE_NONE);
+    priv->dns_update_delay = _nm_utils_ascii_str_to_int64(str,
+                                                          10,
+                                                          0,
+                                                          5000,
+                                                          NM_CONFIG_DEFAULT_MAIN_DNS_UPDATE_DELAY);
+    g_free(str);
     priv->ignore_carrier = nm_config_get_match_spec(priv->keyfile,
                                                     NM_CONFIG_KEYFILE_GROUP_MAIN,
                                                     NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER,
@@ -2485,6 +2654,7 @@ finalize(GObject *gobject)
 
     _match_section_infos_free(priv->connection_infos);
     _match_section_infos_free(priv->device_infos);
+    nm_clear_pointer(&priv->match_device_memo, g_hash_table_unref);
 
     g_key_file_unref(priv->keyfile);
     if (priv->keyfile_user)
@@ -193,6 +193,7 @@ gboolean nm_config_data_get_no_auto_default_for_device(const NMConfigData *self,
 const char *nm_config_data_get_dns_mode(const NMConfigData *self);
 const char *nm_config_data_get_rc_manager(const NMConfigData *self);
 gboolean    nm_config_data_get_systemd_resolved(const NMConfigData *self);
+guint       nm_config_data_get_dns_update_delay(const NMConfigData *self);
 
 gboolean nm_config_data_get_ignore_carrier_for_port(const NMConfigData *self,
                                                     const char         *controller,
@@ -9,6 +9,7 @@
 #include "nm-config.h"
 
 #include <stdio.h>
+#include <sys/stat.h>
 
 #include "nm-utils.h"
 #include "nm-dhcp-config.h"
@@ -113,6 +114,12 @@ typedef struct {
      * Hence, we read them once, that's it. */
     GHashTable *device_states;
 
+    /* The device state files as we last wrote them, by ifindex. Unchanged
+     * content is not written again, unless the file changed on disk. */
+    GHashTable *device_states_written;
+
+    NMConfigDeviceStateWriteStats device_state_write_stats;
+
     char **warnings;
 } NMConfigPrivate;
 
@@ -848,7 +855,10 @@ static const ConfigGroup config_groups[] = {
                              NM_CONFIG_KEYFILE_KEY_MAIN_CONFIGURE_AND_QUIT,
                              NM_CONFIG_KEYFILE_KEY_MAIN_DEBUG,
                              NM_CONFIG_KEYFILE_KEY_MAIN_DHCP,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_DHCP_MAX_INFLIGHT,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_DHCP_START_JITTER,
                              NM_CONFIG_KEYFILE_KEY_MAIN_DNS,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_DNS_UPDATE_DELAY,
                              NM_CONFIG_KEYFILE_KEY_MAIN_FIREWALL_BACKEND,
                              NM_CONFIG_KEYFILE_KEY_MAIN_HOSTNAME_MODE,
                              NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER,
@@ -862,10 +872,13 @@ static const ConfigGroup config_groups[] = {
     },
     {
         .group = NM_CONFIG_KEYFILE_GROUP_LOGGING,
-        .keys  = NM_MAKE_STRV(NM_CONFIG_KEYFILE_KEY_LOGGING_AUDIT,
+        .keys  = NM_MAKE_STRV(NM_CONFIG_KEYFILE_KEY_LOGGING_ASYNC_QUEUE_LIMIT,
+                             NM_CONFIG_KEYFILE_KEY_LOGGING_AUDIT,
                              NM_CONFIG_KEYFILE_KEY_LOGGING_BACKEND,
                              NM_CONFIG_KEYFILE_KEY_LOGGING_DOMAINS,
-                             NM_CONFIG_KEYFILE_KEY_LOGGING_LEVEL, ),
+                             NM_CONFIG_KEYFILE_KEY_LOGGING_LEVEL,
+                             NM_CONFIG_KEYFILE_KEY_LOGGING_PLATFORM_EVENT_DUMP_WINDOW,
+                             NM_CONFIG_KEYFILE_KEY_LOGGING_PLATFORM_EVENT_HISTORY, ),
     },
     {
         .group = NM_CONFIG_KEYFILE_GROUP_CONNECTIVITY,
@@ -2581,8 +2594,46 @@ nm_config_device_state_load_all(void)
     return states;
 }
 
+typedef struct {
+    char           *content;
+    dev_t           st_dev;
+    ino_t           st_ino;
+    off_t           st_size;
+    struct timespec st_mtim;
+} DeviceStateWritten;
+
+static void
+_device_state_written_free(gpointer data)
+{
+    DeviceStateWritten *written = data;
+
+    g_free(written->content);
+    nm_g_slice_free(written);
+}
+
+static gboolean
+_device_state_written_check(const DeviceStateWritten *written,
+                            const char               *path,
+                            const char               *content)
+{
+    struct stat st;
+
+    if (!nm_streq(written->content, content))
+        return FALSE;
+
+    /* The file may have been deleted or replaced behind our back. Only trust
+     * the remembered content if the file still looks like we wrote it. */
+    if (stat(path, &st) != 0)
+        return FALSE;
+
+    return st.st_dev == written->st_dev && st.st_ino == written->st_ino
+           && st.st_size == written->st_size && st.st_mtim.tv_sec == written->st_mtim.tv_sec
+           && st.st_mtim.tv_nsec == written->st_mtim.tv_nsec;
+}
+
 gboolean
-nm_config_device_state_write(int                            ifindex,
+nm_config_device_state_write(NMConfig                      *self,
+                             int                            ifindex,
                              NMConfigDeviceStateManagedType managed,
                              const char                    *perm_hw_addr_fake,
                              const char                    *connection_uuid,
@@ -2596,11 +2647,18 @@ nm_config_device_state_write(int                            ifindex,
     char    path[NM_STRLEN(NM_CONFIG_DEVICE_STATE_DIR "/") + DEVICE_STATE_FILENAME_LEN_MAX + 1];
     GError *local                                 = NULL;
     nm_auto_unref_keyfile GKeyFile *kf            = NULL;
+    NMConfigPrivate                *priv;
+    gs_free char                   *content       = NULL;
+    gsize                           content_len;
+    const DeviceStateWritten       *written_old;
+    DeviceStateWritten             *written;
+    struct stat                     st;
     const char                     *root_path     = NULL;
     const char                     *next_server   = NULL;
     const char                     *dhcp_bootfile = NULL;
     int                             IS_IPv4;
 
+    g_return_val_if_fail(NM_IS_CONFIG(self), FALSE);
     g_return_val_if_fail(ifindex > 0, FALSE);
     g_return_val_if_fail(!connection_uuid || *connection_uuid, FALSE);
     g_return_val_if_fail(managed == NM_CONFIG_DEVICE_STATE_MANAGED_TYPE_MANAGED || !connection_uuid,
@@ -2608,6 +2666,8 @@ nm_config_device_state_write(int                            ifindex,
 
     nm_assert(!perm_hw_addr_fake || nm_utils_hwaddr_valid(perm_hw_addr_fake, -1));
 
+    priv = NM_CONFIG_GET_PRIVATE(self);
+
     nm_sprintf_buf(path, "%s/%d", NM_CONFIG_DEVICE_STATE_DIR, ifindex);
 
     kf = nm_config_create_keyfile();
@@ -2707,11 +2767,47 @@ nm_config_device_state_write(int                            ifindex,
         }
     }
 
-    if (!g_key_file_save_to_file(kf, path, &local)) {
+    content = g_key_file_to_data(kf, &content_len, NULL);
+
+    written_old = priv->device_states_written
+                      ? g_hash_table_lookup(priv->device_states_written, GINT_TO_POINTER(ifindex))
+                      : NULL;
+    if (written_old) {
+        if (_device_state_written_check(written_old, path, content)) {
+            priv->device_state_write_stats.unchanged++;
+            _LOGT("device-state: write #%d (%s) skipped (unchanged)", ifindex, path);
+            return TRUE;
+        }
+        g_hash_table_remove(priv->device_states_written, GINT_TO_POINTER(ifindex));
+    }
+
+    if (!g_file_set_contents(path, content, content_len, &local)) {
+        priv->device_state_write_stats.failed++;
         _LOGW("device-state: write #%d (%s) failed: %s", ifindex, path, local->message);
         g_error_free(local);
         return FALSE;
     }
+
+    priv->device_state_write_stats.written++;
+
+    /* Without the stat of the new file we could not tell later whether it
+     * changed behind our back. Then always write it. */
+    if (stat(path, &st) == 0) {
+        written  = g_slice_new(DeviceStateWritten);
+        *written = (DeviceStateWritten) {
+            .content = g_steal_pointer(&content),
+            .st_dev  = st.st_dev,
+            .st_ino  = st.st_ino,
+            .st_size = st.st_size,
+            .st_mtim = st.st_mtim,
+        };
+        if (!priv->device_states_written) {
+            priv->device_states_written =
+                g_hash_table_new_full(nm_direct_hash, NULL, NULL, _device_state_written_free);
+        }
+        g_hash_table_insert(priv->device_states_written, GINT_TO_POINTER(ifindex), written);
+    }
+
     _LOGT("device-state: write #%d (%s); managed=%s%s%s%s%s%s%s%s, "
           "route-metric-default=%" G_GUINT32_FORMAT "-%" G_GUINT32_FORMAT "%s%s%s"
           "%s%s%s"
@@ -2731,9 +2827,12 @@ nm_config_device_state_write(int                            ifindex,
 }
 
 void
-nm_config_device_state_prune_stale(GHashTable *preserve_ifindexes, NMPlatform *preserve_in_platform)
+nm_config_device_state_prune_stale(NMConfig   *self,
+                                   GHashTable *preserve_ifindexes,
+                                   NMPlatform *preserve_in_platform)
 {
-    GDir       *dir;
+    NMConfigPrivate *priv = NM_CONFIG_GET_PRIVATE(self);
+    GDir            *dir;
     const char *fn;
     char        buf[NM_STRLEN(NM_CONFIG_DEVICE_STATE_DIR "/") + DEVICE_STATE_FILENAME_LEN_MAX + 1] =
         NM_CONFIG_DEVICE_STATE_DIR "/";
@@ -2769,11 +2868,21 @@ nm_config_device_state_prune_stale(GHashTable *preserve_ifindexes, NMPlatform *p
         }));
         _LOGT("device-state: prune #%d (%s)", ifindex, buf);
         (void) unlink(buf);
+        if (priv->device_states_written)
+            g_hash_table_remove(priv->device_states_written, GINT_TO_POINTER(ifindex));
     }
 
     g_dir_close(dir);
 }
 
+const NMConfigDeviceStateWriteStats *
+nm_config_device_state_get_write_stats(NMConfig *self)
+{
+    g_return_val_if_fail(NM_IS_CONFIG(self), NULL);
+
+    return &NM_CONFIG_GET_PRIVATE(self)->device_state_write_stats;
+}
+
 /*****************************************************************************/
 
 static GHashTable *
@@ -3197,6 +3306,8 @@ finalize(GObject *gobject)
     g_strfreev(priv->atomic_section_prefixes);
     g_strfreev(priv->warnings);
 
+    nm_clear_pointer(&priv->device_states_written, g_hash_table_unref);
+
     _nm_config_cmd_line_options_clear(&priv->cli);
 
     g_clear_object(&priv->config_data);
@@ -31,6 +31,15 @@
 #define NM_CONFIG_DEFAULT_CONNECTIVITY_TIMEOUT  20
 #define NM_CONFIG_DEFAULT_CONNECTIVITY_RESPONSE "NetworkManager is online" /* NOT LOCALIZED */
 
+#define NM_CONFIG_DEFAULT_MAIN_DNS_UPDATE_DELAY 50
+
+#define NM_CONFIG_DEFAULT_MAIN_DHCP_MAX_INFLIGHT 0
+#define NM_CONFIG_DEFAULT_MAIN_DHCP_START_JITTER 0
+
+#define NM_CONFIG_DEFAULT_LOGGING_ASYNC_QUEUE_LIMIT          0
+#define NM_CONFIG_DEFAULT_LOGGING_PLATFORM_EVENT_DUMP_WINDOW 60
+#define NM_CONFIG_DEFAULT_LOGGING_PLATFORM_EVENT_HISTORY     0
+
 typedef struct NMConfigCmdLineOptions NMConfigCmdLineOptions;
 
 typedef enum {
@@ -183,7 +192,8 @@ struct _NMConfigDeviceStateData {
 
 NMConfigDeviceStateData *nm_config_device_state_load(int ifindex);
 GHashTable              *nm_config_device_state_load_all(void);
-gboolean                 nm_config_device_state_write(int                            ifindex,
+gboolean                 nm_config_device_state_write(NMConfig                      *self,
+                                                      int                            ifindex,
                                                       NMConfigDeviceStateManagedType managed,
                                                       const char                    *perm_hw_addr_fake,
                                                       const char                    *connection_uuid,
@@ -194,9 +204,21 @@ gboolean                 nm_config_device_state_write(int
                                                       NMDhcpConfig                  *dhcp6_config,
                                                       gboolean                       generic);
 
-void nm_config_device_state_prune_stale(GHashTable *preserve_ifindexes,
+void nm_config_device_state_prune_stale(NMConfig   *self,
+                                        GHashTable *preserve_ifindexes,
                                         NMPlatform *preserve_in_platform);
 
+typedef struct {
+    /* number of device state files written. */
+    guint64 written;
+    /* number of writes skipped, because the file content is unchanged. */
+    guint64 unchanged;
+    /* number of failed writes. */
+    guint64 failed;
+} NMConfigDeviceStateWriteStats;
+
+const NMConfigDeviceStateWriteStats *nm_config_device_state_get_write_stats(NMConfig *self);
+
 const GHashTable              *nm_config_device_state_get_all(NMConfig *self);
 const NMConfigDeviceStateData *nm_config_device_state_get(NMConfig *self, int ifindex);
 
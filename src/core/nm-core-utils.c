@@ -1484,6 +1484,367 @@ nm_match_spec_device(const GSList *specs, const NMMatchSpecDeviceData *data)
     return _match_result(has_except, has_not_except, has_match, has_match_except);
 }
 
+/*****************************************************************************/
+
+typedef struct {
+    const char   *driver;
+    gsize         driver_len;
+    GPatternSpec *driver_version;
+} MatchSpecDeviceDriverVersion;
+
+typedef struct {
+    guint32 a;
+    guint32 b;
+    guint32 c;
+} MatchSpecDeviceS390Subchannels;
+
+typedef struct {
+    /* The specs of one kind ("except:" or not), sorted by their tag. All
+     * fields are lazily created, a %NULL field means there are no such specs. */
+    bool        match_all;
+    GHashTable *interface_names;
+    GPtrArray  *interface_name_patterns;
+    GHashTable *device_types;
+    GHashTable *hwaddrs;
+    GHashTable *drivers;
+    GArray     *driver_versions;
+    GArray     *s390_subchannels;
+    GHashTable *dhcp_plugins;
+} MatchSpecDeviceSet;
+
+struct _NMMatchSpecDevice {
+    bool               has_except;
+    bool               has_not_except;
+    MatchSpecDeviceSet sets[2];
+    GSList            *specs;
+};
+
+#define MATCH_HWADDR_KEY_LEN (NM_STRLEN("20/") + (_NM_UTILS_HWADDR_LEN_MAX * 2) + 1)
+
+static const char *
+_match_hwaddr_key(const guint8 *bin, guint len, char buf[static MATCH_HWADDR_KEY_LEN])
+{
+    int n;
+
+    nm_assert(len > 0 && len <= _NM_UTILS_HWADDR_LEN_MAX);
+
+    /* The key is what nm_utils_hwaddr_matches() compares: the address length and
+     * the bytes. For InfiniBand, only the last 8 bytes are relevant. */
+    n = g_snprintf(buf, MATCH_HWADDR_KEY_LEN, "%u/", len);
+    if (len == INFINIBAND_ALEN) {
+        bin = &bin[INFINIBAND_ALEN - 8];
+        len = 8;
+    }
+    nm_utils_bin2hexstr_full(bin, len, '\0', FALSE, &buf[n]);
+    return buf;
+}
+
+static void
+_match_set_add_str(GHashTable **p_hash, const char *str)
+{
+    if (!*p_hash)
+        *p_hash = g_hash_table_new(nm_str_hash, g_str_equal);
+    g_hash_table_add(*p_hash, (gpointer) str);
+}
+
+static void
+_match_set_add_hwaddr(GHashTable **p_hash, const char *spec_str)
+{
+    guint8 bin[_NM_UTILS_HWADDR_LEN_MAX];
+    char   buf[MATCH_HWADDR_KEY_LEN];
+    gsize  l;
+
+    if (!_nm_utils_hwaddr_aton(spec_str, bin, sizeof(bin), &l) || l == 0)
+        return;
+
+    if (!*p_hash)
+        *p_hash = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+    g_hash_table_add(*p_hash, g_strdup(_match_hwaddr_key(bin, l, buf)));
+}
+
+static void
+_match_set_compile(MatchSpecDeviceSet *set, const char *spec_str, gboolean allow_fuzzy)
+{
+    if (spec_str[0] == '*' && spec_str[1] == '\0') {
+        set->match_all = TRUE;
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, DEVICE_TYPE_TAG)) {
+        _match_set_add_str(&set->device_types, spec_str);
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, NM_MATCH_SPEC_MAC_TAG)) {
+        _match_set_add_hwaddr(&set->hwaddrs, spec_str);
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, NM_MATCH_SPEC_INTERFACE_NAME_TAG)) {
+        gboolean use_pattern = FALSE;
+
+        if (spec_str[0] == '=')
+            spec_str += 1;
+        else {
+            if (spec_str[0] == '~')
+                spec_str += 1;
+            use_pattern = TRUE;
+        }
+
+        /* A glob without wildcards only matches itself. */
+        if (use_pattern && strpbrk(spec_str, "*?")) {
+            if (!set->interface_name_patterns)
+                set->interface_name_patterns =
+                    g_ptr_array_new_with_free_func((GDestroyNotify) g_pattern_spec_free);
+            g_ptr_array_add(set->interface_name_patterns, g_pattern_spec_new(spec_str));
+        } else
+            _match_set_add_str(&set->interface_names, spec_str);
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, DRIVER_TAG)) {
+        const char *t;
+
+        /* See match_device_eval() for the supported formats. */
+        t = strrchr(spec_str, '/');
+        if (!t) {
+            _match_set_add_str(&set->drivers, spec_str);
+            return;
+        }
+
+        if (!set->driver_versions)
+            set->driver_versions = g_array_new(FALSE, FALSE, sizeof(MatchSpecDeviceDriverVersion));
+        g_array_append_val(set->driver_versions,
+                           ((MatchSpecDeviceDriverVersion) {
+                               .driver         = spec_str,
+                               .driver_len     = t - spec_str,
+                               .driver_version = g_pattern_spec_new(&t[1]),
+                           }));
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, NM_MATCH_SPEC_S390_SUBCHANNELS_TAG)) {
+        MatchSpecDeviceS390Subchannels s;
+
+        if (!match_device_s390_subchannels_parse(spec_str, &s.a, &s.b, &s.c))
+            return;
+        if (!set->s390_subchannels)
+            set->s390_subchannels =
+                g_array_new(FALSE, FALSE, sizeof(MatchSpecDeviceS390Subchannels));
+        g_array_append_val(set->s390_subchannels, s);
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, DHCP_PLUGIN_TAG)) {
+        _match_set_add_str(&set->dhcp_plugins, spec_str);
+        return;
+    }
+
+    if (allow_fuzzy) {
+        _match_set_add_hwaddr(&set->hwaddrs, spec_str);
+        _match_set_add_str(&set->interface_names, spec_str);
+    }
+}
+
+static gboolean
+_match_set_eval(const MatchSpecDeviceSet *set, MatchSpecDeviceData *match_data)
+{
+    const NMMatchSpecDeviceData *data = match_data->data;
+    guint                        i;
+
+    if (set->match_all)
+        return TRUE;
+
+    if (data->interface_name) {
+        if (nm_g_hash_table_contains(set->interface_names, data->interface_name))
+            return TRUE;
+        if (set->interface_name_patterns) {
+            for (i = 0; i < set->interface_name_patterns->len; i++) {
+                if (g_pattern_match_string(set->interface_name_patterns->pdata[i],
+                                           data->interface_name))
+                    return TRUE;
+            }
+        }
+    }
+
+    if (match_data->device_type
+        && nm_g_hash_table_contains(set->device_types, match_data->device_type))
+        return TRUE;
+
+    if (set->hwaddrs) {
+        char buf[MATCH_HWADDR_KEY_LEN];
+
+        if (G_UNLIKELY(!match_data->hwaddr.is_parsed)) {
+            match_data->hwaddr.is_parsed = TRUE;
+            if (data->hwaddr) {
+                gsize l;
+
+                if (!_nm_utils_hwaddr_aton(data->hwaddr,
+                                           match_data->hwaddr.bin,
+                                           sizeof(match_data->hwaddr.bin),
+                                           &l))
+                    g_return_val_if_reached(FALSE);
+                match_data->hwaddr.len = l;
+            }
+        }
+        if (match_data->hwaddr.len > 0
+            && g_hash_table_contains(
+                set->hwaddrs,
+                _match_hwaddr_key(match_data->hwaddr.bin, match_data->hwaddr.len, buf)))
+            return TRUE;
+    }
+
+    if (match_data->driver) {
+        if (nm_g_hash_table_contains(set->drivers, match_data->driver))
+            return TRUE;
+        if (set->driver_versions) {
+            for (i = 0; i < set->driver_versions->len; i++) {
+                const MatchSpecDeviceDriverVersion *d =
+                    &g_array_index(set->driver_versions, MatchSpecDeviceDriverVersion, i);
+
+                if (strncmp(d->driver, match_data->driver, d->driver_len) == 0
+                    && g_pattern_match_string(d->driver_version,
+                                              match_data->driver_version ?: ""))
+                    return TRUE;
+            }
+        }
+    }
+
+    if (set->s390_subchannels) {
+        if (G_UNLIKELY(!match_data->s390_subchannels.is_parsed)) {
+            match_data->s390_subchannels.is_parsed = TRUE;
+            match_data->s390_subchannels.is_good =
+                data->s390_subchannels
+                && match_device_s390_subchannels_parse(data->s390_subchannels,
+                                                       &match_data->s390_subchannels.a,
+                                                       &match_data->s390_subchannels.b,
+                                                       &match_data->s390_subchannels.c);
+        }
+        if (match_data->s390_subchannels.is_good) {
+            for (i = 0; i < set->s390_subchannels->len; i++) {
+                const MatchSpecDeviceS390Subchannels *s =
+                    &g_array_index(set->s390_subchannels, MatchSpecDeviceS390Subchannels, i);
+
+                if (s->a == match_data->s390_subchannels.a
+                    && s->b == match_data->s390_subchannels.b
+                    && s->c == match_data->s390_subchannels.c)
+                    return TRUE;
+            }
+        }
+    }
+
+    if (match_data->dhcp_plugin
+        && nm_g_hash_table_contains(set->dhcp_plugins, match_data->dhcp_plugin))
+        return TRUE;
+
+    return FALSE;
+}
+
+static void
+_match_set_clear(MatchSpecDeviceSet *set)
+{
+    guint i;
+
+    nm_clear_pointer(&set->interface_names, g_hash_table_unref);
+    nm_clear_pointer(&set->interface_name_patterns, g_ptr_array_unref);
+    nm_clear_pointer(&set->device_types, g_hash_table_unref);
+    nm_clear_pointer(&set->hwaddrs, g_hash_table_unref);
+    nm_clear_pointer(&set->drivers, g_hash_table_unref);
+    if (set->driver_versions) {
+        for (i = 0; i < set->driver_versions->len; i++) {
+            g_pattern_spec_free(
+                g_array_index(set->driver_versions, MatchSpecDeviceDriverVersion, i)
+                    .driver_version);
+        }
+        nm_clear_pointer(&set->driver_versions, g_array_unref);
+    }
+    nm_clear_pointer(&set->s390_subchannels, g_array_unref);
+    nm_clear_pointer(&set->dhcp_plugins, g_hash_table_unref);
+}
+
+/**
+ * nm_match_spec_device_new:
+ * @specs: (transfer full): the list of device specs, as returned by
+ *   nm_match_spec_split().
+ *
+ * Compiles @specs for nm_match_spec_device_match(), which gives the same
+ * result as nm_match_spec_device(), but does not need to parse the specs
+ * again for every device. Exact interface names, MAC addresses, device types
+ * and drivers are looked up in hash tables and globs are only compiled once.
+ *
+ * Returns: (transfer full): the compiled specs. Free with nm_match_spec_device_free().
+ */
+NMMatchSpecDevice *
+nm_match_spec_device_new(GSList *specs)
+{
+    NMMatchSpecDevice *self;
+    const GSList      *iter;
+
+    self = g_slice_new0(NMMatchSpecDevice);
+
+    /* The compiled sets point into the strings of @specs, which we keep. */
+    self->specs = specs;
+
+    for (iter = specs; iter; iter = iter->next) {
+        const char *spec_str = iter->data;
+        gboolean    except;
+
+        if (!spec_str || !*spec_str)
+            continue;
+
+        spec_str = match_except(spec_str, &except);
+
+        if (except)
+            self->has_except = TRUE;
+        else
+            self->has_not_except = TRUE;
+
+        _match_set_compile(&self->sets[except], spec_str, !except);
+    }
+
+    return self;
+}
+
+void
+nm_match_spec_device_free(NMMatchSpecDevice *self)
+{
+    if (!self)
+        return;
+
+    _match_set_clear(&self->sets[0]);
+    _match_set_clear(&self->sets[1]);
+    g_slist_free_full(self->specs, g_free);
+    g_slice_free(NMMatchSpecDevice, self);
+}
+
+NMMatchSpecMatchType
+nm_match_spec_device_match(const NMMatchSpecDevice *self, const NMMatchSpecDeviceData *data)
+{
+    MatchSpecDeviceData match_data;
+    gboolean            has_match;
+    gboolean            has_match_except;
+
+    nm_assert(data);
+    nm_assert(!data->hwaddr || nm_utils_hwaddr_valid(data->hwaddr, -1));
+
+    if (!self || (!self->has_except && !self->has_not_except))
+        return NM_MATCH_SPEC_NO_MATCH;
+
+    match_data = (MatchSpecDeviceData) {
+        .data           = data,
+        .device_type    = nm_str_not_empty(data->device_type),
+        .driver         = nm_str_not_empty(data->driver),
+        .driver_version = nm_str_not_empty(data->driver_version),
+        .dhcp_plugin    = nm_str_not_empty(data->dhcp_plugin),
+    };
+
+    has_match_except = self->has_except && _match_set_eval(&self->sets[1], &match_data);
+    has_match        = !has_match_except && self->has_not_except
+                && _match_set_eval(&self->sets[0], &match_data);
+
+    return _match_result(self->has_except, self->has_not_except, has_match, has_match_except);
+}
+
 int
 nm_match_spec_match_type_to_bool(NMMatchSpecMatchType m, int no_match_value)
 {
@@ -5474,3 +5835,107 @@ nm_utils_shorten_hostname(const char *hostname, char **shortened)
     *shortened = g_steal_pointer(&s);
     return TRUE;
 }
+
+/*****************************************************************************/
+
+struct _NMUtilsBatch {
+    GHashTable      *items;
+    GSource         *source;
+    NMUtilsBatchFunc func;
+    gpointer         user_data;
+    guint            delay_msec;
+};
+
+static gboolean
+_batch_timeout_cb(gpointer user_data)
+{
+    NMUtilsBatch                  *batch = user_data;
+    gs_unref_hashtable GHashTable *items = NULL;
+
+    nm_clear_g_source_inst(&batch->source);
+
+    /* @func may add new items, they go into the next batch. */
+    items = g_steal_pointer(&batch->items);
+    if (items)
+        batch->func(items, batch->user_data);
+
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * nm_utils_batch_new:
+ * @delay_msec: the time after adding the first item, until @func is called.
+ * @func: called with all items that were added in the meantime.
+ * @user_data: user data for @func.
+ *
+ * Coalesces repeated requests for the same items. However often an item is
+ * added until @func gets called, @func sees it only once.
+ *
+ * Returns: (transfer full): the new batch. Free with nm_utils_batch_free().
+ */
+NMUtilsBatch *
+nm_utils_batch_new(guint delay_msec, NMUtilsBatchFunc func, gpointer user_data)
+{
+    NMUtilsBatch *batch;
+
+    nm_assert(func);
+
+    batch  = g_slice_new(NMUtilsBatch);
+    *batch = (NMUtilsBatch) {
+        .func       = func,
+        .user_data  = user_data,
+        .delay_msec = delay_msec,
+    };
+    return batch;
+}
+
+void
+nm_utils_batch_add(NMUtilsBatch *batch, gpointer item)
+{
+    nm_assert(batch);
+
+    if (!batch->items)
+        batch->items = g_hash_table_new(nm_direct_hash, NULL);
+    g_hash_table_add(batch->items, item);
+
+    if (!batch->source) {
+        batch->source = nm_g_source_attach(nm_g_timeout_source_new(batch->delay_msec,
+                                                                   G_PRIORITY_DEFAULT,
+                                                                   _batch_timeout_cb,
+                                                                   batch,
+                                                                   NULL),
+                                           NULL);
+    }
+}
+
+void
+nm_utils_batch_remove(NMUtilsBatch *batch, gpointer item)
+{
+    if (batch && batch->items)
+        g_hash_table_remove(batch->items, item);
+}
+
+/**
+ * nm_utils_batch_cancel:
+ * @batch: the batch.
+ *
+ * Drops the pending items without calling the batch function.
+ */
+void
+nm_utils_batch_cancel(NMUtilsBatch *batch)
+{
+    nm_assert(batch);
+
+    nm_clear_g_source_inst(&batch->source);
+    nm_clear_pointer(&batch->items, g_hash_table_unref);
+}
+
+void
+nm_utils_batch_free(NMUtilsBatch *batch)
+{
+    if (!batch)
+        return;
+
+    nm_utils_batch_cancel(batch);
+    nm_g_slice_free(batch);
+}
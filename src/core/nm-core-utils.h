@@ -207,6 +207,16 @@ typedef struct _NMMatchSpecDeviceData {
 
 NMMatchSpecMatchType nm_match_spec_device(const GSList *specs, const NMMatchSpecDeviceData *data);
 
+typedef struct _NMMatchSpecDevice NMMatchSpecDevice;
+
+NMMatchSpecDevice   *nm_match_spec_device_new(GSList *specs);
+void                 nm_match_spec_device_free(NMMatchSpecDevice *self);
+NMMatchSpecMatchType nm_match_spec_device_match(const NMMatchSpecDevice   *self,
+                                                const NMMatchSpecDeviceData *data);
+
+NM_AUTO_DEFINE_FCN0(NMMatchSpecDevice *, _nm_auto_free_match_spec_device, nm_match_spec_device_free);
+#define nm_auto_free_match_spec_device nm_auto(_nm_auto_free_match_spec_device)
+
 NMMatchSpecMatchType nm_match_spec_config(const GSList *specs, guint nm_version, const char *env);
 GSList              *nm_match_spec_split(const char *value);
 char                *nm_match_spec_join(GSList *specs);
@@ -490,4 +500,16 @@ uid_t nm_utils_get_nm_uid(void);
 
 gid_t nm_utils_get_nm_gid(void);
 
+/*****************************************************************************/
+
+typedef struct _NMUtilsBatch NMUtilsBatch;
+
+typedef void (*NMUtilsBatchFunc)(GHashTable *items, gpointer user_data);
+
+NMUtilsBatch *nm_utils_batch_new(guint delay_msec, NMUtilsBatchFunc func, gpointer user_data);
+void          nm_utils_batch_add(NMUtilsBatch *batch, gpointer item);
+void          nm_utils_batch_remove(NMUtilsBatch *batch, gpointer item);
+void          nm_utils_batch_cancel(NMUtilsBatch *batch);
+void          nm_utils_batch_free(NMUtilsBatch *batch);
+
 #endif /* __NM_CORE_UTILS_H__ */
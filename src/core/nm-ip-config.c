@@ -138,6 +138,58 @@ _notify_platform(NMIPConfig *self, guint32 obj_type_flags)
 
 /*****************************************************************************/
 
+static gboolean
+_objs_update(GPtrArray **p_objs, NMPObjectType obj_type, const NMDedupMultiHeadEntry *head_entry)
+{
+    GPtrArray                   *objs     = *p_objs;
+    gs_unref_ptrarray GPtrArray *objs_new = NULL;
+    NMDedupMultiIter             iter;
+    const NMPObject             *obj;
+    guint                        n = 0;
+    guint                        i;
+
+    /* Keep the exported objects in an array, so that GetAddresses() and
+     * GetRoutes() can page by index. Only unicast routes are exported.
+     *
+     * Objects in the platform cache are immutable. If the objects are the same
+     * instances as last time, there is nothing to re-export. */
+    nm_dedup_multi_iter_init(&iter, head_entry);
+    while (nm_platform_dedup_multi_iter_next_obj(&iter, &obj, obj_type)) {
+        if (NM_IN_SET(obj_type, NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE)
+            && NMP_OBJECT_CAST_IP_ROUTE(obj)->type_coerced
+                   != nm_platform_route_type_coerce(RTN_UNICAST))
+            continue;
+
+        if (!objs_new) {
+            if (n < nm_g_ptr_array_len(objs) && objs->pdata[n] == obj) {
+                n++;
+                continue;
+            }
+            objs_new = g_ptr_array_new_full(head_entry->len, (GDestroyNotify) nmp_object_unref);
+            for (i = 0; i < n; i++)
+                g_ptr_array_add(objs_new, (gpointer) nmp_object_ref(objs->pdata[i]));
+        }
+        g_ptr_array_add(objs_new, (gpointer) nmp_object_ref(obj));
+    }
+
+    if (!objs_new) {
+        if (n == nm_g_ptr_array_len(objs))
+            return FALSE;
+        /* The new objects are a prefix of the old ones. */
+        if (n == 0)
+            nm_clear_pointer(p_objs, g_ptr_array_unref);
+        else
+            g_ptr_array_set_size(objs, n);
+        return TRUE;
+    }
+
+    nm_g_ptr_array_unref(objs);
+    *p_objs = g_steal_pointer(&objs_new);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
 static void
 _l3cfg_notify_cb(NML3Cfg *l3cfg, const NML3ConfigNotifyData *notify_data, NMIPConfig *self)
 {
@@ -156,6 +208,66 @@ _l3cfg_notify_cb(NML3Cfg *l3cfg, const NML3ConfigNotifyData *notify_data, NMIPCo
 
 /*****************************************************************************/
 
+static void
+impl_ip_config_get_addresses(NMDBusObject                      *obj,
+                             const NMDBusInterfaceInfoExtended *interface_info,
+                             const NMDBusMethodInfoExtended    *method_info,
+                             GDBusConnection                   *connection,
+                             const char                        *sender,
+                             GDBusMethodInvocation             *invocation,
+                             GVariant                          *parameters)
+{
+    NMIPConfig        *self = NM_IP_CONFIG(obj);
+    NMIPConfigPrivate *priv = NM_IP_CONFIG_GET_PRIVATE(self);
+    guint32            offset;
+    guint32            limit;
+
+    g_variant_get(parameters, "(uu)", &offset, &limit);
+
+    /* Unlike the "AddressData" property, this is not limited to the first
+     * NM_UTILS_IP_ADDRESSES_TO_DBUS_MAX addresses. It pages through the
+     * same state that was last exported. */
+    g_dbus_method_invocation_return_value(
+        invocation,
+        g_variant_new("(@aa{sv})",
+                      nm_utils_ip_objs_to_dbus_page(nm_ip_config_get_addr_family(self),
+                                                    priv->v_address_objs,
+                                                    NULL,
+                                                    offset,
+                                                    limit)));
+}
+
+static void
+impl_ip_config_get_routes(NMDBusObject                      *obj,
+                          const NMDBusInterfaceInfoExtended *interface_info,
+                          const NMDBusMethodInfoExtended    *method_info,
+                          GDBusConnection                   *connection,
+                          const char                        *sender,
+                          GDBusMethodInvocation             *invocation,
+                          GVariant                          *parameters)
+{
+    NMIPConfig        *self = NM_IP_CONFIG(obj);
+    NMIPConfigPrivate *priv = NM_IP_CONFIG_GET_PRIVATE(self);
+    guint32            offset;
+    guint32            limit;
+
+    g_variant_get(parameters, "(uu)", &offset, &limit);
+
+    /* Unlike the "RouteData" property, this is not limited to the first
+     * NM_UTILS_IP_ROUTES_TO_DBUS_MAX routes. It pages through the unicast
+     * routes that were last exported, in the same order. */
+    g_dbus_method_invocation_return_value(
+        invocation,
+        g_variant_new("(@aa{sv})",
+                      nm_utils_ip_objs_to_dbus_page(nm_ip_config_get_addr_family(self),
+                                                    priv->v_route_objs,
+                                                    priv->v_route_data_cache,
+                                                    offset,
+                                                    limit)));
+}
+
+/*****************************************************************************/
+
 static void
 get_property_ip(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
 {
@@ -300,8 +412,11 @@ finalize(GObject *object)
 
     nm_g_variant_unref(priv->v_address_data);
     nm_g_variant_unref(priv->v_addresses);
+    nm_g_ptr_array_unref(priv->v_address_objs);
     nm_g_variant_unref(priv->v_route_data);
     nm_g_variant_unref(priv->v_routes);
+    nm_g_ptr_array_unref(priv->v_route_objs);
+    nm_g_hash_table_unref(priv->v_route_data_cache);
 
     nmp_object_unref(priv->v_gateway.best_default_route);
 
@@ -503,6 +618,23 @@ get_property_ip4(GObject *object, guint prop_id, GValue *value, GParamSpec *pspe
 static const NMDBusInterfaceInfoExtended interface_info_ip4_config = {
     .parent = NM_DEFINE_GDBUS_INTERFACE_INFO_INIT(
         NM_DBUS_INTERFACE_IP4_CONFIG,
+        .methods = NM_DEFINE_GDBUS_METHOD_INFOS(
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetAddresses",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("offset", "u"),
+                                                         NM_DEFINE_GDBUS_ARG_INFO("limit", "u"), ),
+                    .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("addresses", "aa{sv}"), ), ),
+                .handle = impl_ip_config_get_addresses, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetRoutes",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("offset", "u"),
+                                                         NM_DEFINE_GDBUS_ARG_INFO("limit", "u"), ),
+                    .out_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("routes", "aa{sv}"), ), ),
+                .handle = impl_ip_config_get_routes, ), ),
         .properties = NM_DEFINE_GDBUS_PROPERTY_INFOS(
             NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE(
                 "Addresses",
@@ -642,6 +774,23 @@ G_DEFINE_TYPE(NMIP6Config, nm_ip6_config, NM_TYPE_IP_CONFIG)
 static const NMDBusInterfaceInfoExtended interface_info_ip6_config = {
     .parent = NM_DEFINE_GDBUS_INTERFACE_INFO_INIT(
         NM_DBUS_INTERFACE_IP6_CONFIG,
+        .methods = NM_DEFINE_GDBUS_METHOD_INFOS(
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetAddresses",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("offset", "u"),
+                                                         NM_DEFINE_GDBUS_ARG_INFO("limit", "u"), ),
+                    .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("addresses", "aa{sv}"), ), ),
+                .handle = impl_ip_config_get_addresses, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetRoutes",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("offset", "u"),
+                                                         NM_DEFINE_GDBUS_ARG_INFO("limit", "u"), ),
+                    .out_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("routes", "aa{sv}"), ), ),
+                .handle = impl_ip_config_get_routes, ), ),
         .properties = NM_DEFINE_GDBUS_PROPERTY_INFOS(
             NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE(
                 "Addresses",
@@ -906,13 +1055,19 @@ _handle_platform_change(NMIPConfig *self, guint32 obj_type_flags, gboolean is_in
     if (best_default_route_changed
         || NM_FLAGS_ANY(obj_type_flags,
                         nmp_object_type_to_flags(NMP_OBJECT_TYPE_IP_ADDRESS(IS_IPv4)))) {
-        gs_unref_variant GVariant *x_address_data = NULL;
-        gs_unref_variant GVariant *x_addresses    = NULL;
+        const NMDedupMultiHeadEntry *head_entry_addresses;
+        gs_unref_variant GVariant   *x_address_data = NULL;
+        gs_unref_variant GVariant   *x_addresses    = NULL;
+
+        head_entry_addresses = nm_platform_lookup_object(nm_l3cfg_get_platform(priv->l3cfg),
+                                                         NMP_OBJECT_TYPE_IP_ADDRESS(IS_IPv4),
+                                                         nm_l3cfg_get_ifindex(priv->l3cfg));
+        _objs_update(&priv->v_address_objs,
+                     NMP_OBJECT_TYPE_IP_ADDRESS(IS_IPv4),
+                     head_entry_addresses);
 
         nm_utils_ip_addresses_to_dbus(addr_family,
-                                      nm_platform_lookup_object(nm_l3cfg_get_platform(priv->l3cfg),
-                                                                NMP_OBJECT_TYPE_IP_ADDRESS(IS_IPv4),
-                                                                nm_l3cfg_get_ifindex(priv->l3cfg)),
+                                      head_entry_addresses,
                                       priv->v_gateway.best_default_route,
                                       &x_address_data,
                                       &x_addresses);
@@ -933,11 +1088,25 @@ _handle_platform_change(NMIPConfig *self, guint32 obj_type_flags, gboolean is_in
     if (best_default_route_changed)
         changed_params[n_changed_params++] = obj_properties_ip[PROP_IP_GATEWAY];
 
-    if (NM_FLAGS_ANY(obj_type_flags, nmp_object_type_to_flags(NMP_OBJECT_TYPE_IP_ROUTE(IS_IPv4)))) {
-        gs_unref_variant GVariant *x_route_data = NULL;
-        gs_unref_variant GVariant *x_routes     = NULL;
-
-        nm_utils_ip_routes_to_dbus(addr_family, head_entry_routes, &x_route_data, &x_routes);
+    if (NM_FLAGS_ANY(obj_type_flags, nmp_object_type_to_flags(NMP_OBJECT_TYPE_IP_ROUTE(IS_IPv4)))
+        && (_objs_update(&priv->v_route_objs, NMP_OBJECT_TYPE_IP_ROUTE(IS_IPv4), head_entry_routes)
+            || !priv->v_route_data)) {
+        gs_unref_hashtable GHashTable *route_data_cache = NULL;
+        gs_unref_variant GVariant     *x_route_data     = NULL;
+        gs_unref_variant GVariant     *x_routes         = NULL;
+
+        /* Only routes that are not in the cache from the last export get converted. */
+        route_data_cache = g_hash_table_new_full(nm_direct_hash,
+                                                 NULL,
+                                                 (GDestroyNotify) nmp_object_unref,
+                                                 (GDestroyNotify) g_variant_unref);
+        nm_utils_ip_routes_to_dbus(addr_family,
+                                   head_entry_routes,
+                                   priv->v_route_data_cache,
+                                   route_data_cache,
+                                   &x_route_data,
+                                   &x_routes);
+        NM_SWAP(&priv->v_route_data_cache, &route_data_cache);
 
         if (!nm_g_variant_equal(priv->v_route_data, x_route_data)) {
             changed_params[n_changed_params++] = obj_properties_ip[PROP_IP_ROUTE_DATA];
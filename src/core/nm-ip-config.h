@@ -27,8 +27,11 @@ struct _NMIPConfigPrivate {
     const NML3ConfigData *l3cd;
     GVariant             *v_address_data;
     GVariant             *v_addresses;
+    GPtrArray            *v_address_objs;
     GVariant             *v_route_data;
     GVariant             *v_routes;
+    GPtrArray            *v_route_objs;
+    GHashTable           *v_route_data_cache;
     struct {
         const NMPObject *best_default_route;
     } v_gateway;
@@ -3135,7 +3135,7 @@ nm_l3_config_data_new_from_platform(NMDedupMultiIndex        *multi_idx,
 
 /*****************************************************************************/
 
-void
+gboolean
 nm_l3_config_data_hash_dns(const NML3ConfigData *l3cd,
                            GChecksum            *sum,
                            int                   addr_family,
@@ -3155,8 +3155,8 @@ nm_l3_config_data_hash_dns(const NML3ConfigData *l3cd,
     guint              num_options;
     gboolean           empty = TRUE;
 
-    g_return_if_fail(l3cd);
-    g_return_if_fail(sum);
+    g_return_val_if_fail(l3cd, FALSE);
+    g_return_val_if_fail(sum, FALSE);
 
     strarr = nm_l3_config_data_get_nameservers(l3cd, addr_family, &num_nameservers);
     for (i = 0; i < num_nameservers; i++) {
@@ -3232,6 +3232,8 @@ nm_l3_config_data_hash_dns(const NML3ConfigData *l3cd,
      * not), so it's a bit difficult to add it to checksum maintaining the
      * assumption of checksum(empty)=0
      */
+
+    return !empty;
 }
 
 /*****************************************************************************/
@@ -3524,6 +3526,43 @@ nm_l3_config_data_merge(NML3ConfigData       *self,
         self->routed_dns_6 = TRUE;
 }
 
+/**
+ * nm_l3_config_data_merge_routes:
+ * @self: the #NML3ConfigData to add the routes to
+ * @src: the #NML3ConfigData with the routes
+ *
+ * Adds the routes of @src to @self, without modifying them. Like with
+ * nm_l3_config_data_merge(), routes that already exist in @self are kept.
+ *
+ * This is useful, if @src contains routes that were previously prepared
+ * by nm_l3_config_data_merge() (where the default table and metric got
+ * applied). Then the prepared routes can be merged repeatedly, without
+ * redoing the work.
+ */
+void
+nm_l3_config_data_merge_routes(NML3ConfigData *self, const NML3ConfigData *src)
+{
+    NMDedupMultiIter iter;
+    const NMPObject *obj;
+    int              IS_IPv4;
+
+    nm_assert(_NM_IS_L3_CONFIG_DATA(self, FALSE));
+    nm_assert(_NM_IS_L3_CONFIG_DATA(src, TRUE));
+    nm_assert(self->ifindex == src->ifindex);
+
+    for (IS_IPv4 = 1; IS_IPv4 >= 0; IS_IPv4--) {
+        nm_l3_config_data_iter_obj_for_each (&iter, src, &obj, NMP_OBJECT_TYPE_IP_ROUTE(IS_IPv4)) {
+            nm_l3_config_data_add_route_full(self,
+                                             IS_IPv4 ? AF_INET : AF_INET6,
+                                             obj,
+                                             NULL,
+                                             NM_L3_CONFIG_ADD_FLAGS_EXCLUSIVE,
+                                             NULL,
+                                             NULL);
+        }
+    }
+}
+
 NML3ConfigData *
 nm_l3_config_data_new_clone(const NML3ConfigData *src, int ifindex)
 {
@@ -155,6 +155,8 @@ void nm_l3_config_data_merge(NML3ConfigData       *self,
                              NML3ConfigMergeHookAddObj hook_add_obj,
                              gpointer                  hook_user_data);
 
+void nm_l3_config_data_merge_routes(NML3ConfigData *self, const NML3ConfigData *src);
+
 GPtrArray *nm_l3_config_data_get_blacklisted_ip4_routes(const NML3ConfigData *self,
                                                         gboolean              is_vrf);
 
@@ -612,9 +614,9 @@ nmtst_l3_config_data_get_best_gateway(const NML3ConfigData *self, int addr_famil
     return nm_platform_ip_route_get_gateway(addr_family, NMP_OBJECT_CAST_IP_ROUTE(rt));
 }
 
-void nm_l3_config_data_hash_dns(const NML3ConfigData *l3cd,
-                                GChecksum            *sum,
-                                int                   addr_family,
-                                NMDnsIPConfigType     dns_ip_config_type);
+gboolean nm_l3_config_data_hash_dns(const NML3ConfigData *l3cd,
+                                    GChecksum            *sum,
+                                    int                   addr_family,
+                                    NMDnsIPConfigType     dns_ip_config_type);
 
 #endif /* __NM_L3_CONFIG_DATA_H__ */
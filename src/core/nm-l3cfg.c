@@ -189,6 +189,13 @@ struct _NML3CfgCommitTypeHandle {
 
 typedef struct {
     const NML3ConfigData *l3cd;
+
+    /* The routes of @l3cd, with the default route table, metric and penalty
+     * applied. Routes are the bulk of most configurations and they don't depend
+     * on the ACD state. So we prepare them once, and reuse them whenever we
+     * merge the combined configuration. Cleared when the merge parameters change. */
+    const NML3ConfigData *routes_merged;
+
     NML3CfgConfigFlags    config_flags;
     NML3ConfigMergeFlags  merge_flags;
     union {
@@ -311,6 +318,8 @@ typedef struct _NML3CfgPrivate {
 
     NML3CfgCommitType commit_on_idle_type;
 
+    NML3CfgCommitStats commit_stats;
+
     gint8 commit_reentrant_count;
 
     union {
@@ -3492,6 +3501,7 @@ _l3_config_datas_remove_index_fast(GArray *arr, guint idx)
     l3_config_data = _l3_config_datas_at(arr, idx);
 
     nm_l3_config_data_unref(l3_config_data->l3cd);
+    nm_l3_config_data_unref(l3_config_data->routes_merged);
 
     g_array_remove_index_fast(arr, idx);
 }
@@ -3609,6 +3619,7 @@ nm_l3cfg_add_config(NML3Cfg              *self,
         *l3_config_data = (L3ConfigData) {
             .tag_confdata              = tag,
             .l3cd                      = nm_l3_config_data_ref_and_seal(l3cd),
+            .routes_merged             = NULL,
             .config_flags              = config_flags,
             .merge_flags               = merge_flags,
             .default_route_table_4     = default_route_table_4,
@@ -3688,6 +3699,7 @@ nm_l3cfg_add_config(NML3Cfg              *self,
     nm_assert(l3_config_data->acd_defend_type_confdata == acd_defend_type);
 
     if (changed) {
+        nm_clear_l3cd(&l3_config_data->routes_merged);
         _l3_changed_configs_set_dirty(self, "configuration added");
         nm_l3cfg_commit_on_idle_schedule(self, NM_L3_CFG_COMMIT_TYPE_AUTO);
     }
@@ -4088,9 +4100,10 @@ update_routes:
         if (!_l3cfg_routed_dns_equal(old_routes, new_routes)) {
             if (old_routes) {
                 _LOGT("deleting old DNS routes");
-                for (i = 0; i < old_routes->len; i++) {
-                    nm_platform_object_delete(self->priv.platform, old_routes->pdata[i]);
-                }
+                nm_platform_object_delete_many(self->priv.platform,
+                                               (const NMPObject *const *) old_routes->pdata,
+                                               old_routes->len,
+                                               NULL);
             }
             if (new_routes) {
                 _LOGT("adding new DNS routes");
@@ -4105,6 +4118,43 @@ update_routes:
     }
 }
 
+static gboolean
+_l3_hook_routes_only_cb(const NML3ConfigData      *l3cd,
+                        const NMPObject           *obj,
+                        NML3ConfigMergeHookResult *hook_result,
+                        gpointer                   user_data)
+{
+    return NM_IN_SET(NMP_OBJECT_GET_TYPE(obj), NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE);
+}
+
+static void
+_l3_config_data_ensure_routes_merged(NML3Cfg *self, L3ConfigData *l3_config_data)
+{
+    NML3ConfigData *l3cd;
+
+    if (l3_config_data->routes_merged)
+        return;
+
+    if (NM_FLAGS_HAS(l3_config_data->config_flags, NM_L3CFG_CONFIG_FLAGS_ONLY_FOR_ACD)
+        || NM_FLAGS_ANY(l3_config_data->merge_flags,
+                        NM_L3_CONFIG_MERGE_FLAGS_NO_ROUTES | NM_L3_CONFIG_MERGE_FLAGS_CLONE))
+        return;
+
+    l3cd = nm_l3_config_data_new(nm_platform_get_multi_idx(self->priv.platform),
+                                 self->priv.ifindex,
+                                 NM_IP_CONFIG_SOURCE_UNKNOWN);
+    nm_l3_config_data_merge(l3cd,
+                            l3_config_data->l3cd,
+                            l3_config_data->merge_flags | NM_L3_CONFIG_MERGE_FLAGS_NO_DNS,
+                            l3_config_data->default_route_table_x,
+                            l3_config_data->default_route_metric_x,
+                            l3_config_data->default_route_penalty_x,
+                            l3_config_data->default_dns_priority_x,
+                            _l3_hook_routes_only_cb,
+                            NULL);
+    l3_config_data->routes_merged = nm_l3_config_data_seal(l3cd);
+}
+
 static void
 _l3cfg_update_combined_config(NML3Cfg               *self,
                               gboolean               to_commit,
@@ -4146,8 +4196,12 @@ _l3cfg_update_combined_config(NML3Cfg               *self,
     l3_config_datas_arr = nm_malloc_maybe_a(300,
                                             l3_config_datas_len * sizeof(l3_config_datas_arr[0]),
                                             &l3_config_datas_free);
-    for (i = 0; i < l3_config_datas_len; i++)
-        l3_config_datas_arr[i] = _l3_config_datas_at(self->priv.p->l3_config_datas, i);
+    for (i = 0; i < l3_config_datas_len; i++) {
+        L3ConfigData *l3_config_data = _l3_config_datas_at(self->priv.p->l3_config_datas, i);
+
+        _l3_config_data_ensure_routes_merged(self, l3_config_data);
+        l3_config_datas_arr[i] = l3_config_data;
+    }
 
     if (l3_config_datas_len > 1) {
         /* We are about to merge the l3cds. The order in which we do that matters.
@@ -4192,7 +4246,8 @@ _l3cfg_update_combined_config(NML3Cfg               *self,
                                      NM_IP_CONFIG_SOURCE_UNKNOWN);
 
         for (i = 0; i < l3_config_datas_len; i++) {
-            const L3ConfigData *l3cd_data = l3_config_datas_arr[i];
+            const L3ConfigData  *l3cd_data   = l3_config_datas_arr[i];
+            NML3ConfigMergeFlags merge_flags = l3cd_data->merge_flags;
 
             /* more important entries must be sorted *first*. */
             nm_assert(
@@ -4207,15 +4262,22 @@ _l3cfg_update_combined_config(NML3Cfg               *self,
 
             hook_data.tag = l3cd_data->tag_confdata;
 
+            /* Routes are taken from the prepared @routes_merged, so that a change
+             * of one configuration doesn't require to redo the routes of all others. */
+            if (l3cd_data->routes_merged)
+                merge_flags |= NM_L3_CONFIG_MERGE_FLAGS_NO_ROUTES;
+
             nm_l3_config_data_merge(l3cd,
                                     l3cd_data->l3cd,
-                                    l3cd_data->merge_flags,
+                                    merge_flags,
                                     l3cd_data->default_route_table_x,
                                     l3cd_data->default_route_metric_x,
                                     l3cd_data->default_route_penalty_x,
                                     l3cd_data->default_dns_priority_x,
                                     _l3_hook_add_obj_cb,
                                     &hook_data);
+            if (l3cd_data->routes_merged)
+                nm_l3_config_data_merge_routes(l3cd, l3cd_data->routes_merged);
         }
 
         if (self->priv.ifindex == NM_LOOPBACK_IFINDEX) {
@@ -5204,11 +5266,214 @@ _l3_commit_mptcp(NML3Cfg *self, NML3CfgCommitType commit_type)
     _rp_filter_update(self, reapply);
 }
 
+/*****************************************************************************/
+
+/* A commit that takes longer than this is logged at debug level. */
+#define COMMIT_SLOW_USEC ((gint64) (100 * 1000))
+
+/* Every that many commits, the accumulated statistics are logged. */
+#define COMMIT_STATS_LOG_INTERVAL 256u
+
+typedef struct {
+    gint64                start_nsec;
+    gint64                mark_nsec;
+    gint64                phase_nsec[_NM_L3CFG_COMMIT_PHASE_NUM];
+    NML3CfgCommitObjStats addresses;
+    NML3CfgCommitObjStats routes;
+} L3CommitProfile;
+
+static const char *const _commit_phase_names[_NM_L3CFG_COMMIT_PHASE_NUM] = {
+    [NM_L3CFG_COMMIT_PHASE_COMBINE]      = "combine",
+    [NM_L3CFG_COMMIT_PHASE_NOTIFY]       = "notify",
+    [NM_L3CFG_COMMIT_PHASE_COLLECT]      = "collect",
+    [NM_L3CFG_COMMIT_PHASE_IP6_PARAMS]   = "ip6-params",
+    [NM_L3CFG_COMMIT_PHASE_PRUNE]        = "prune",
+    [NM_L3CFG_COMMIT_PHASE_ADDRESS_SYNC] = "address-sync",
+    [NM_L3CFG_COMMIT_PHASE_ROUTE_SYNC]   = "route-sync",
+    [NM_L3CFG_COMMIT_PHASE_MPTCP]        = "mptcp",
+    [NM_L3CFG_COMMIT_PHASE_ACD]          = "acd",
+    [NM_L3CFG_COMMIT_PHASE_TOTAL]        = "total",
+};
+
+static void
+_l3_commit_profile_start(L3CommitProfile *prof)
+{
+    *prof            = (L3CommitProfile) {};
+    prof->start_nsec = nm_utils_get_monotonic_timestamp_nsec();
+    prof->mark_nsec  = prof->start_nsec;
+}
+
+/* Accounts the time since the previous mark to @phase. */
+static void
+_l3_commit_profile_mark(L3CommitProfile *prof, NML3CfgCommitPhase phase)
+{
+    gint64 now_nsec;
+
+    nm_assert(phase < NM_L3CFG_COMMIT_PHASE_TOTAL);
+
+    now_nsec = nm_utils_get_monotonic_timestamp_nsec();
+    prof->phase_nsec[phase] += now_nsec - prof->mark_nsec;
+    prof->mark_nsec = now_nsec;
+}
+
+static void
+_l3_commit_profile_count(NML3Cfg               *self,
+                         NML3CfgCommitObjStats *obj_stats,
+                         const GPtrArray       *objs,
+                         const GPtrArray       *objs_prune)
+{
+    guint i;
+
+    obj_stats->pruned += nm_g_ptr_array_len(objs_prune);
+
+    if (!objs)
+        return;
+
+    obj_stats->configured += objs->len;
+
+    /* Which objects already exist is only of interest for the debug logging.
+     * Don't do a hash lookup per object on every commit otherwise. */
+    if (!_LOGD_ENABLED())
+        return;
+
+    for (i = 0; i < objs->len; i++) {
+        const NMPObject    *obj = objs->pdata[i];
+        const ObjStateData *obj_state;
+
+        obj_state = g_hash_table_lookup(self->priv.p->obj_state_hash, &obj);
+        if (obj_state && obj_state->os_plobj)
+            obj_stats->present++;
+    }
+}
+
+static void
+_l3_commit_stats_obj_add(NML3CfgCommitObjStats *dst, const NML3CfgCommitObjStats *src)
+{
+    dst->configured += src->configured;
+    dst->present += src->present;
+    dst->pruned += src->pruned;
+    dst->failed += src->failed;
+}
+
+static void
+_l3_commit_stats_log(NML3Cfg *self)
+{
+    const NML3CfgCommitStats *stats = &self->priv.p->commit_stats;
+    guint                     phase;
+    guint                     i;
+
+    if (!_LOGD_ENABLED())
+        return;
+
+    _LOGD("commit-stats: %" G_GUINT64_FORMAT " commits; addresses: %" G_GUINT64_FORMAT
+          " configured, %" G_GUINT64_FORMAT " present, %" G_GUINT64_FORMAT
+          " pruned; routes: %" G_GUINT64_FORMAT " configured, %" G_GUINT64_FORMAT
+          " present, %" G_GUINT64_FORMAT " pruned, %" G_GUINT64_FORMAT " failed",
+          stats->n_commits,
+          stats->addresses.configured,
+          stats->addresses.present,
+          stats->addresses.pruned,
+          stats->routes.configured,
+          stats->routes.present,
+          stats->routes.pruned,
+          stats->routes.failed);
+
+    for (phase = 0; phase < _NM_L3CFG_COMMIT_PHASE_NUM; phase++) {
+        char  sbuf[400];
+        char *s = sbuf;
+        gsize l = sizeof(sbuf);
+
+        sbuf[0] = '\0';
+        for (i = 0; i < NM_L3CFG_COMMIT_STATS_HIST_LEN; i++) {
+            if (stats->phase_hist[phase][i] > 0)
+                nm_strbuf_append(&s, &l, " %u:%u", 1u << i, stats->phase_hist[phase][i]);
+        }
+        _LOGD("commit-stats: %s: %" G_GUINT64_FORMAT " usec; histogram (usec:count):%s",
+              _commit_phase_names[phase],
+              stats->phase_usec[phase],
+              sbuf);
+    }
+}
+
+static void
+_l3_commit_profile_finish(NML3Cfg *self, L3CommitProfile *prof, NML3CfgCommitType commit_type)
+{
+    NML3CfgCommitStats *stats = &self->priv.p->commit_stats;
+    gint64              usec[_NM_L3CFG_COMMIT_PHASE_NUM];
+    gboolean            slow;
+    guint               phase;
+
+    prof->phase_nsec[NM_L3CFG_COMMIT_PHASE_TOTAL] =
+        nm_utils_get_monotonic_timestamp_nsec() - prof->start_nsec;
+
+    stats->n_commits++;
+    for (phase = 0; phase < _NM_L3CFG_COMMIT_PHASE_NUM; phase++) {
+        guint bucket;
+
+        usec[phase] = prof->phase_nsec[phase] / 1000;
+        stats->phase_usec[phase] += usec[phase];
+
+        bucket = g_bit_storage((gulong) NM_MIN(usec[phase], G_MAXUINT32)) - 1u;
+        stats->phase_hist[phase][NM_MIN(bucket, NM_L3CFG_COMMIT_STATS_HIST_LEN - 1u)]++;
+    }
+
+    slow = (usec[NM_L3CFG_COMMIT_PHASE_TOTAL] >= COMMIT_SLOW_USEC);
+    _l3_commit_stats_obj_add(&stats->addresses, &prof->addresses);
+    _l3_commit_stats_obj_add(&stats->routes, &prof->routes);
+
+    if (_LOGT_ENABLED() || (slow && _LOGD_ENABLED())) {
+        char  sbuf_ct[30];
+        char  sbuf[400];
+        char *s = sbuf;
+        gsize l = sizeof(sbuf);
+
+        sbuf[0] = '\0';
+        for (phase = 0; phase < NM_L3CFG_COMMIT_PHASE_TOTAL; phase++) {
+            nm_strbuf_append(&s,
+                             &l,
+                             "%s%s=%" G_GINT64_FORMAT,
+                             phase == 0 ? "" : ", ",
+                             _commit_phase_names[phase],
+                             usec[phase]);
+        }
+        _NMLOG(slow ? LOGL_DEBUG : LOGL_TRACE,
+               "commit %s%s took %" G_GINT64_FORMAT " usec (%s); addresses: %" G_GUINT64_FORMAT
+               " configured, %" G_GUINT64_FORMAT " present, %" G_GUINT64_FORMAT
+               " pruned; routes: %" G_GUINT64_FORMAT " configured, %" G_GUINT64_FORMAT
+               " present, %" G_GUINT64_FORMAT " pruned, %" G_GUINT64_FORMAT " failed",
+               _l3_cfg_commit_type_to_string(commit_type, sbuf_ct, sizeof(sbuf_ct)),
+               slow ? " (slow)" : "",
+               usec[NM_L3CFG_COMMIT_PHASE_TOTAL],
+               sbuf,
+               prof->addresses.configured,
+               prof->addresses.present,
+               prof->addresses.pruned,
+               prof->routes.configured,
+               prof->routes.present,
+               prof->routes.pruned,
+               prof->routes.failed);
+    }
+
+    if (stats->n_commits % COMMIT_STATS_LOG_INTERVAL == 0)
+        _l3_commit_stats_log(self);
+}
+
+/* The statistics are logged with debug level every 256 commits and when
+ * @self gets destroyed. This accessor is only for tests. */
+const NML3CfgCommitStats *
+nmtst_l3cfg_get_commit_stats(NML3Cfg *self)
+{
+    g_return_val_if_fail(NM_IS_L3CFG(self), NULL);
+
+    return &self->priv.p->commit_stats;
+}
+
 static void
 _l3_commit_one(NML3Cfg              *self,
                int                   addr_family,
                NML3CfgCommitType     commit_type,
-               const NML3ConfigData *l3cd_old)
+               const NML3ConfigData *l3cd_old,
+               L3CommitProfile      *prof)
 {
     const int                    IS_IPv4         = NM_IS_IPv4(addr_family);
     gs_unref_ptrarray GPtrArray *addresses       = NULL;
@@ -5245,6 +5510,8 @@ _l3_commit_one(NML3Cfg              *self,
                            &routes,
                            &routes_nodev);
 
+    _l3_commit_profile_mark(prof, NM_L3CFG_COMMIT_PHASE_COLLECT);
+
     route_table_sync =
         self->priv.p->combined_l3cd_commited
             ? nm_l3_config_data_get_route_table_sync(self->priv.p->combined_l3cd_commited,
@@ -5255,6 +5522,7 @@ _l3_commit_one(NML3Cfg              *self,
         _l3_commit_ip6_privacy(self, commit_type);
         _l3_commit_ndisc_params(self, commit_type);
         _l3_commit_ip6_token(self, commit_type);
+        _l3_commit_profile_mark(prof, NM_L3CFG_COMMIT_PHASE_IP6_PARAMS);
     }
 
     if (route_table_sync == NM_IP_ROUTE_TABLE_SYNC_MODE_NONE)
@@ -5349,6 +5617,11 @@ _l3_commit_one(NML3Cfg              *self,
 
     _routes_watch_ip_addrs(self, addr_family, addresses, routes);
 
+    _l3_commit_profile_count(self, &prof->addresses, addresses, addresses_prune);
+    _l3_commit_profile_count(self, &prof->routes, routes, routes_prune);
+
+    _l3_commit_profile_mark(prof, NM_L3CFG_COMMIT_PHASE_PRUNE);
+
     /* FIXME(l3cfg): need to honor and set nm_l3_config_data_get_ndisc_*(). */
     /* FIXME(l3cfg): need to honor and set nm_l3_config_data_get_mtu(). */
 
@@ -5365,6 +5638,8 @@ _l3_commit_one(NML3Cfg              *self,
 
     self->priv.p->commit_reentrant_count_ip_address_sync_x[IS_IPv4]--;
 
+    _l3_commit_profile_mark(prof, NM_L3CFG_COMMIT_PHASE_ADDRESS_SYNC);
+
     _nodev_routes_sync(self, addr_family, commit_type, routes_nodev);
 
     nm_platform_ip_route_sync(self->priv.platform,
@@ -5375,6 +5650,9 @@ _l3_commit_one(NML3Cfg              *self,
                               &routes_failed);
 
     _failedobj_handle_routes(self, addr_family, routes_failed);
+
+    prof->routes.failed += nm_g_ptr_array_len(routes_failed);
+    _l3_commit_profile_mark(prof, NM_L3CFG_COMMIT_PHASE_ROUTE_SYNC);
 }
 
 static void
@@ -5387,6 +5665,7 @@ _l3_commit(NML3Cfg *self, NML3CfgCommitType commit_type, gboolean is_idle)
     gboolean                                 is_sticky_update      = FALSE;
     char                                     sbuf_ct[30];
     gboolean                                 changed_combined_l3cd;
+    L3CommitProfile                          prof;
 
     g_return_if_fail(NM_IS_L3CFG(self));
     nm_assert(NM_IN_SET(commit_type,
@@ -5434,6 +5713,8 @@ _l3_commit(NML3Cfg *self, NML3CfgCommitType commit_type, gboolean is_idle)
     if (commit_type <= NM_L3_CFG_COMMIT_TYPE_NONE)
         return;
 
+    _l3_commit_profile_start(&prof);
+
     self->priv.p->commit_reentrant_count++;
 
     _l3cfg_update_combined_config(self,
@@ -5442,23 +5723,33 @@ _l3_commit(NML3Cfg *self, NML3CfgCommitType commit_type, gboolean is_idle)
                                   &l3cd_old,
                                   &changed_combined_l3cd);
 
+    _l3_commit_profile_mark(&prof, NM_L3CFG_COMMIT_PHASE_COMBINE);
+
     _nm_l3cfg_emit_signal_notify_commit(self,
                                         NM_L3_CONFIG_NOTIFY_TYPE_PRE_COMMIT,
                                         l3cd_old,
                                         self->priv.p->combined_l3cd_commited,
                                         changed_combined_l3cd);
 
-    _l3_commit_one(self, AF_INET, commit_type, l3cd_old);
-    _l3_commit_one(self, AF_INET6, commit_type, l3cd_old);
+    _l3_commit_profile_mark(&prof, NM_L3CFG_COMMIT_PHASE_NOTIFY);
+
+    _l3_commit_one(self, AF_INET, commit_type, l3cd_old, &prof);
+    _l3_commit_one(self, AF_INET6, commit_type, l3cd_old, &prof);
 
     _l3cfg_routed_dns_apply(self, self->priv.p->combined_l3cd_commited);
 
     _failedobj_reschedule(self, 0);
 
+    _l3_commit_profile_mark(&prof, NM_L3CFG_COMMIT_PHASE_ROUTE_SYNC);
+
     _l3_commit_mptcp(self, commit_type);
 
+    _l3_commit_profile_mark(&prof, NM_L3CFG_COMMIT_PHASE_MPTCP);
+
     _l3_acd_data_process_changes(self);
 
+    _l3_commit_profile_mark(&prof, NM_L3CFG_COMMIT_PHASE_ACD);
+
     nm_assert(self->priv.p->commit_reentrant_count == 1);
     self->priv.p->commit_reentrant_count--;
 
@@ -5467,6 +5758,10 @@ _l3_commit(NML3Cfg *self, NML3CfgCommitType commit_type, gboolean is_idle)
                                         l3cd_old,
                                         self->priv.p->combined_l3cd_commited,
                                         changed_combined_l3cd);
+
+    _l3_commit_profile_mark(&prof, NM_L3CFG_COMMIT_PHASE_NOTIFY);
+
+    _l3_commit_profile_finish(self, &prof, commit_type);
 }
 
 NML3CfgBlockHandle *
@@ -5960,6 +6255,9 @@ finalize(GObject *object)
 
     nm_clear_pointer(&self->priv.p->acd_ipv4_addresses_on_link, g_hash_table_unref);
 
+    if (self->priv.p->commit_stats.n_commits > 0)
+        _l3_commit_stats_log(self);
+
     _LOGT("finalized");
 
     G_OBJECT_CLASS(nm_l3cfg_parent_class)->finalize(object);
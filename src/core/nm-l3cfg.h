@@ -433,6 +433,48 @@ void nm_l3cfg_commit_type_reset_update(NML3Cfg *self);
 
 /*****************************************************************************/
 
+typedef enum {
+    NM_L3CFG_COMMIT_PHASE_COMBINE,
+    NM_L3CFG_COMMIT_PHASE_NOTIFY,
+    NM_L3CFG_COMMIT_PHASE_COLLECT,
+    NM_L3CFG_COMMIT_PHASE_IP6_PARAMS,
+    NM_L3CFG_COMMIT_PHASE_PRUNE,
+    NM_L3CFG_COMMIT_PHASE_ADDRESS_SYNC,
+    NM_L3CFG_COMMIT_PHASE_ROUTE_SYNC,
+    NM_L3CFG_COMMIT_PHASE_MPTCP,
+    NM_L3CFG_COMMIT_PHASE_ACD,
+    NM_L3CFG_COMMIT_PHASE_TOTAL,
+    _NM_L3CFG_COMMIT_PHASE_NUM,
+} NML3CfgCommitPhase;
+
+/* Bucket i counts durations in [2^i, 2^(i+1)) usec, the first bucket also
+ * counts durations below 1 usec and the last one all longer durations. */
+#define NM_L3CFG_COMMIT_STATS_HIST_LEN 20
+
+typedef struct {
+    /* the objects that we wanted to configure. */
+    guint64 configured;
+    /* how many of them already existed in platform (with the same ID)
+     * before the sync. Only counted while debug logging is enabled. */
+    guint64 present;
+    /* the objects that we removed from platform. */
+    guint64 pruned;
+    /* the objects that we failed to configure. */
+    guint64 failed;
+} NML3CfgCommitObjStats;
+
+typedef struct {
+    guint64               n_commits;
+    guint64               phase_usec[_NM_L3CFG_COMMIT_PHASE_NUM];
+    guint32               phase_hist[_NM_L3CFG_COMMIT_PHASE_NUM][NM_L3CFG_COMMIT_STATS_HIST_LEN];
+    NML3CfgCommitObjStats addresses;
+    NML3CfgCommitObjStats routes;
+} NML3CfgCommitStats;
+
+const NML3CfgCommitStats *nmtst_l3cfg_get_commit_stats(NML3Cfg *self);
+
+/*****************************************************************************/
+
 const NML3ConfigData *nm_l3cfg_get_combined_l3cd(NML3Cfg *self, gboolean get_commited);
 
 const NMPObject *
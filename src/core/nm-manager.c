@@ -52,6 +52,7 @@
 #include "vpn/nm-vpn-manager.h"
 
 #define DEVICE_STATE_PRUNE_RATELIMIT_MAX 100u
+#define DEVICE_STATE_WRITE_DELAY_MSEC    200u
 
 /*****************************************************************************/
 
@@ -238,6 +239,10 @@ typedef struct {
 
     guint8 device_state_prune_ratelimit_count;
 
+    /* Devices whose state file needs to be written. The writes are coalesced,
+     * see nm_manager_schedule_write_device_state(). */
+    NMUtilsBatch *device_state_write_batch;
+
     bool startup : 1;
     bool devices_inited : 1;
 
@@ -1181,8 +1186,9 @@ active_connection_find_by_connection(NMManager              *self,
 }
 
 typedef struct {
-    NMManager *self;
-    gboolean   for_auto_activation;
+    NMManager  *self;
+    const char *connection_type;
+    gboolean    for_auto_activation;
 } GetActivatableConnectionsFilterData;
 
 static gboolean
@@ -1193,6 +1199,10 @@ _get_activatable_connections_filter(NMSettings           *settings,
     const GetActivatableConnectionsFilterData *d = user_data;
     NMConnectionMultiConnect                   multi_connect;
 
+    if (d->connection_type
+        && !nm_streq0(nm_settings_connection_get_connection_type(sett_conn), d->connection_type))
+        return FALSE;
+
     if (NM_FLAGS_ANY(nm_settings_connection_get_flags(sett_conn),
                      NM_SETTINGS_CONNECTION_INT_FLAGS_VOLATILE
                          | NM_SETTINGS_CONNECTION_INT_FLAGS_EXTERNAL))
@@ -1236,6 +1246,38 @@ nm_manager_get_activatable_connections(NMManager *manager,
         NULL);
 }
 
+/**
+ * nm_manager_get_activatable_connections_for_device:
+ * @manager: the #NMManager
+ * @device: the #NMDevice to autoconnect
+ * @out_len: (optional): the number of returned connections
+ *
+ * Like nm_manager_get_activatable_connections() for auto activation with
+ * sorting, but only returns profiles that can possibly be compatible with
+ * @device based on their type and interface-name. The caller still must check
+ * nm_device_can_auto_connect().
+ *
+ * Returns: (transfer container): a %NULL terminated array of profiles.
+ */
+NMSettingsConnection **
+nm_manager_get_activatable_connections_for_device(NMManager *manager,
+                                                  NMDevice  *device,
+                                                  guint     *out_len)
+{
+    NMManagerPrivate                         *priv = NM_MANAGER_GET_PRIVATE(manager);
+    const GetActivatableConnectionsFilterData d    = {
+           .self                = manager,
+           .connection_type     = NM_DEVICE_GET_CLASS(device)->connection_type_check_compatible,
+           .for_auto_activation = TRUE,
+    };
+
+    return nm_settings_get_connections_for_autoconnect(priv->settings,
+                                                       nm_device_get_iface(device),
+                                                       out_len,
+                                                       _get_activatable_connections_filter,
+                                                       (gpointer) &d);
+}
+
 static NMActiveConnection *
 active_connection_get_by_path(NMManager *self, const char *path)
 {
@@ -1721,6 +1763,39 @@ nm_manager_notify_delete_settings_connections(NMManager *self, NMSettingsConnect
 
 /*****************************************************************************/
 
+static void
+_platform_event_history_update(NMManager *self, const NMConfigData *config_data)
+{
+    nm_platform_set_event_history(
+        NM_MANAGER_GET_PRIVATE(self)->platform,
+        nm_config_data_get_value_int64(config_data,
+                                       NM_CONFIG_KEYFILE_GROUP_LOGGING,
+                                       NM_CONFIG_KEYFILE_KEY_LOGGING_PLATFORM_EVENT_HISTORY,
+                                       10,
+                                       0,
+                                       G_MAXUINT32,
+                                       NM_CONFIG_DEFAULT_LOGGING_PLATFORM_EVENT_HISTORY));
+}
+
+static void
+_platform_event_history_dump(NMManager *self)
+{
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+    gint64            window_sec;
+
+    window_sec =
+        nm_config_data_get_value_int64(NM_CONFIG_GET_DATA,
+                                       NM_CONFIG_KEYFILE_GROUP_LOGGING,
+                                       NM_CONFIG_KEYFILE_KEY_LOGGING_PLATFORM_EVENT_DUMP_WINDOW,
+                                       10,
+                                       0,
+                                       G_MAXINT32,
+                                       NM_CONFIG_DEFAULT_LOGGING_PLATFORM_EVENT_DUMP_WINDOW);
+
+    nm_platform_dump_events(priv->platform,
+                            window_sec == 0 ? -1 : window_sec * NM_UTILS_MSEC_PER_SEC);
+}
+
 static void
 _config_changed_cb(NMConfig           *config,
                    NMConfigData       *config_data,
@@ -1728,6 +1803,12 @@ _config_changed_cb(NMConfig           *config,
                    NMConfigData       *old_data,
                    NMManager          *self)
 {
+    if (NM_FLAGS_HAS(changes, NM_CONFIG_CHANGE_VALUES))
+        _platform_event_history_update(self, config_data);
+
+    if (NM_FLAGS_HAS(changes, NM_CONFIG_CHANGE_CAUSE_SIGUSR2))
+        _platform_event_history_dump(self);
+
     g_object_freeze_notify(G_OBJECT(self));
 
     if (NM_FLAGS_HAS(changes, NM_CONFIG_CHANGE_GLOBAL_DNS_CONFIG))
@@ -2132,7 +2213,7 @@ manager_device_state_changed(NMDevice           *device,
                   NM_DEVICE_STATE_UNMANAGED,
                   NM_DEVICE_STATE_DISCONNECTED,
                   NM_DEVICE_STATE_ACTIVATED)) {
-        nm_manager_write_device_state(self, device, NULL);
+        nm_manager_schedule_write_device_state(self, device);
 
         G_STATIC_ASSERT_EXPR(DEVICE_STATE_PRUNE_RATELIMIT_MAX < G_MAXUINT8);
         if (priv->device_state_prune_ratelimit_count++ > DEVICE_STATE_PRUNE_RATELIMIT_MAX) {
@@ -2144,7 +2225,7 @@ manager_device_state_changed(NMDevice           *device,
              * Otherwise, the files might pile up if you create (and destroy) a large
              * number of software devices. */
             priv->device_state_prune_ratelimit_count = 0;
-            nm_config_device_state_prune_stale(NULL, priv->platform);
+            nm_config_device_state_prune_stale(priv->config, NULL, priv->platform);
         }
     }
 
@@ -2329,6 +2410,8 @@ remove_device(NMManager *self, NMDevice *device, gboolean quitting)
 
     _devcon_remove_device_all(self, device);
 
+    nm_utils_batch_remove(priv->device_state_write_batch, device);
+
     c_list_unlink(&device->devices_lst);
 
     _parent_notify_changed(self, device, TRUE);
@@ -7777,6 +7860,7 @@ impl_manager_set_logging(NMDBusObject                      *obj,
     GError     *error = NULL;
     const char *level;
     const char *domains;
+    gboolean    platform_trace;
 
     /* The permission is already enforced by the D-Bus daemon, but we ensure
      * that the caller is still alive so that clients are forced to wait and
@@ -7791,11 +7875,19 @@ impl_manager_set_logging(NMDBusObject                      *obj,
 
     g_variant_get(parameters, "(&s&s)", &level, &domains);
 
+    platform_trace = nm_logging_enabled(LOGL_TRACE, LOGD_PLATFORM);
+
     if (nm_logging_setup(level, domains, NULL, &error)) {
         _LOGI(LOGD_CORE,
               "logging: level '%s' domains '%s'",
               nm_logging_level_to_string(),
               nm_logging_domains_to_string());
+
+        /* When somebody starts tracing the platform, they are usually
+         * investigating a problem that already happened. Log what the
+         * platform remembers about the last events. */
+        if (!platform_trace && nm_logging_enabled(LOGL_TRACE, LOGD_PLATFORM))
+            _platform_event_history_dump(self);
     }
 
     if (error)
@@ -7997,7 +8089,8 @@ nm_manager_write_device_state(NMManager *self, NMDevice *device, int *out_ifinde
                                                               TRUE,
                                                               &route_metric_default_aspired);
 
-    if (!nm_config_device_state_write(ifindex,
+    if (!nm_config_device_state_write(priv->config,
+                                      ifindex,
                                       managed_type,
                                       perm_hw_addr_fake,
                                       uuid,
@@ -8015,13 +8108,44 @@ nm_manager_write_device_state(NMManager *self, NMDevice *device, int *out_ifinde
     return TRUE;
 }
 
+static void
+_device_state_write_cb(GHashTable *devices, gpointer user_data)
+{
+    NMManager     *self = user_data;
+    GHashTableIter iter;
+    NMDevice      *device;
+
+    g_hash_table_iter_init(&iter, devices);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &device, NULL))
+        nm_manager_write_device_state(self, device, NULL);
+}
+
+/**
+ * nm_manager_schedule_write_device_state:
+ * @self: the #NMManager
+ * @device: the #NMDevice whose state changed
+ *
+ * Marks the state file of @device as dirty. All dirty state files are
+ * written together shortly after, so that a burst of state changes on many
+ * devices does not result in a burst of file writes.
+ */
+void
+nm_manager_schedule_write_device_state(NMManager *self, NMDevice *device)
+{
+    nm_utils_batch_add(NM_MANAGER_GET_PRIVATE(self)->device_state_write_batch, device);
+}
+
 void
 nm_manager_write_device_state_all(NMManager *self)
 {
-    NMManagerPrivate              *priv               = NM_MANAGER_GET_PRIVATE(self);
-    gs_unref_hashtable GHashTable *preserve_ifindexes = NULL;
-    NMDevice                      *device;
-    NMActiveConnection            *ac;
+    NMManagerPrivate                    *priv               = NM_MANAGER_GET_PRIVATE(self);
+    gs_unref_hashtable GHashTable       *preserve_ifindexes = NULL;
+    NMDevice                            *device;
+    NMActiveConnection                  *ac;
+    const NMConfigDeviceStateWriteStats *stats;
+
+    /* we write all states now, pending writes are obsolete. */
+    nm_utils_batch_cancel(priv->device_state_write_batch);
 
     preserve_ifindexes = g_hash_table_new(nm_direct_hash, NULL);
 
@@ -8041,7 +8165,15 @@ nm_manager_write_device_state_all(NMManager *self)
         nm_settings_connection_update_timestamp(sett, (guint64) time(NULL));
     }
 
-    nm_config_device_state_prune_stale(preserve_ifindexes, NULL);
+    nm_config_device_state_prune_stale(priv->config, preserve_ifindexes, NULL);
+
+    stats = nm_config_device_state_get_write_stats(priv->config);
+    _LOGD(LOGD_CORE,
+          "device-state: %" G_GUINT64_FORMAT " files written, %" G_GUINT64_FORMAT
+          " unchanged, %" G_GUINT64_FORMAT " failed",
+          stats->written,
+          stats->unchanged,
+          stats->failed);
 }
 
 static gboolean
@@ -8920,6 +9052,7 @@ constructed(GObject *object)
                      NM_CONFIG_SIGNAL_CONFIG_CHANGED,
                      G_CALLBACK(_config_changed_cb),
                      self);
+    _platform_event_history_update(self, nm_config_get_data(priv->config));
 
     state = nm_config_state_get(priv->config);
 
@@ -8962,6 +9095,9 @@ nm_manager_init(NMManager *self)
 
     priv->platform = g_object_ref(NM_PLATFORM_GET);
 
+    priv->device_state_write_batch =
+        nm_utils_batch_new(DEVICE_STATE_WRITE_DELAY_MSEC, _device_state_write_cb, self);
+
     priv->capabilities = g_array_new(FALSE, FALSE, sizeof(guint32));
 
     priv->radio_states[NM_RFKILL_TYPE_WLAN] = (RfkillRadioState) {
@@ -9217,6 +9353,8 @@ dispose(GObject *object)
 
     nm_clear_g_source(&priv->devices_inited_id);
 
+    nm_clear_pointer(&priv->device_state_write_batch, nm_utils_batch_free);
+
     nm_clear_pointer(&priv->checkpoint_mgr, nm_checkpoint_manager_free);
 
     if (priv->concheck_mgr) {
@@ -123,6 +123,9 @@ NMSettingsConnection **nm_manager_get_activatable_connections(NMManager *manager
                                                               gboolean   for_auto_activation,
                                                               gboolean   sort,
                                                               guint     *out_len);
+NMSettingsConnection **nm_manager_get_activatable_connections_for_device(NMManager *manager,
+                                                                         NMDevice  *device,
+                                                                         guint     *out_len);
 
 void nm_manager_deactivate_ac(NMManager *self, NMSettingsConnection *connection);
 
@@ -130,6 +133,7 @@ void nm_manager_device_recheck_auto_activate_schedule(NMManager *self, NMDevice
 
 void     nm_manager_write_device_state_all(NMManager *manager);
 gboolean nm_manager_write_device_state(NMManager *manager, NMDevice *device, int *out_ifindex);
+void     nm_manager_schedule_write_device_state(NMManager *manager, NMDevice *device);
 
 /* Device handling */
 
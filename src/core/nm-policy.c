@@ -1532,7 +1532,7 @@ _auto_activate_device(NMPolicy *self, NMDevice *device)
     if (!nm_device_autoconnect_allowed(device))
         return;
 
-    connections = nm_manager_get_activatable_connections(priv->manager, TRUE, TRUE, &len);
+    connections = nm_manager_get_activatable_connections_for_device(priv->manager, device, &len);
     if (!connections[0])
         return;
 
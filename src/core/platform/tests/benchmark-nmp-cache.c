@@ -0,0 +1,497 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include <linux/if_addr.h>
+#include <net/if_arp.h>
+#include <sys/resource.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "libnm-glib-aux/nm-time-utils.h"
+#include "libnm-platform/nm-netlink.h"
+#include "libnm-platform/nm-platform-private.h"
+#include "libnm-platform/nmp-object.h"
+#include "platform/nm-fake-platform.h"
+
+#include "nm-test-utils-core.h"
+
+/* Feeds synthetic rtnetlink notifications through the parser and the NMPCache
+ * and reports the cost per operation. Run it via "meson test --benchmark".
+ *
+ * No netlink socket is involved. The parser only needs a platform instance,
+ * for which the fake platform is good enough. */
+
+NMTST_DEFINE();
+
+static struct {
+    int n_links;
+    int n_addresses;
+    int n_routes;
+} global_opt = {
+    .n_links     = 10000,
+    .n_addresses = 100000,
+    .n_routes    = 100000,
+};
+
+typedef enum {
+    BENCH_MSG_NEW,
+    BENCH_MSG_UPDATE,
+    BENCH_MSG_DEL,
+} BenchMsgType;
+
+typedef struct {
+    NMPlatform *platform;
+    NMPCache   *cache;
+} BenchData;
+
+typedef struct {
+    gint64 start_nsec;
+    gssize start_heap;
+} BenchTimer;
+
+/*****************************************************************************/
+
+static gssize
+_heap_in_use(void)
+{
+#ifdef __GLIBC__
+#if __GLIBC_PREREQ(2, 33)
+    return mallinfo2().uordblks;
+#endif
+#endif
+    return 0;
+}
+
+static void
+_timer_start(BenchTimer *timer)
+{
+    timer->start_heap = _heap_in_use();
+    timer->start_nsec = nm_utils_clock_gettime_nsec(CLOCK_MONOTONIC);
+}
+
+static void
+_timer_report(const BenchTimer *timer, NMPObjectType obj_type, const char *what, guint n_ops)
+{
+    gint64        elapsed_nsec = nm_utils_clock_gettime_nsec(CLOCK_MONOTONIC) - timer->start_nsec;
+    gssize        heap_diff    = _heap_in_use() - timer->start_heap;
+    struct rusage ru           = {};
+
+    getrusage(RUSAGE_SELF, &ru);
+
+    g_print("%-13s %-10s %8u ops %10.1f ns/op %+12.1f KiB heap %10ld KiB peak-rss\n",
+            nmp_class_from_type(obj_type)->obj_type_name,
+            what,
+            n_ops,
+            n_ops > 0 ? ((double) elapsed_nsec) / n_ops : 0.0,
+            ((double) heap_diff) / 1024,
+            ru.ru_maxrss);
+}
+
+/*****************************************************************************/
+
+static guint
+_head_entry_len(const NMDedupMultiHeadEntry *head_entry)
+{
+    return head_entry ? head_entry->len : 0u;
+}
+
+static int
+_ifindex(guint idx)
+{
+    return 1000 + (idx % global_opt.n_links);
+}
+
+static struct nlmsghdr *
+_nlmsg_dup_hdr(struct nl_msg *nlmsg)
+{
+    const struct nlmsghdr *nlh = nlmsg_hdr(nlmsg);
+
+    return nm_memdup(nlh, nlh->nlmsg_len);
+}
+
+static struct nlmsghdr *
+_build_link(guint idx, BenchMsgType msg_type)
+{
+    nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+    struct nlattr               *info;
+    char                         ifname[IFNAMSIZ];
+    struct ifinfomsg             ifi;
+
+    ifi = (struct ifinfomsg) {
+        .ifi_family = AF_UNSPEC,
+        .ifi_type   = ARPHRD_ETHER,
+        .ifi_index  = 1000 + idx,
+        .ifi_flags  = IFF_UP | IFF_LOWER_UP | IFF_RUNNING,
+    };
+
+    nlmsg = nlmsg_alloc_new(0, msg_type == BENCH_MSG_DEL ? RTM_DELLINK : RTM_NEWLINK, 0);
+    if (nlmsg_append_struct(nlmsg, &ifi) < 0)
+        goto nla_put_failure;
+
+    NLA_PUT_STRING(nlmsg, IFLA_IFNAME, nm_sprintf_buf(ifname, "bench%u", idx));
+    NLA_PUT_U32(nlmsg, IFLA_MTU, msg_type == BENCH_MSG_UPDATE ? 9000 : 1500);
+
+    if (!(info = nla_nest_start(nlmsg, IFLA_LINKINFO)))
+        goto nla_put_failure;
+    NLA_PUT_STRING(nlmsg, IFLA_INFO_KIND, "dummy");
+    NLA_NEST_END(nlmsg, info);
+
+    return _nlmsg_dup_hdr(nlmsg);
+
+nla_put_failure:
+    g_return_val_if_reached(NULL);
+}
+
+static struct nlmsghdr *
+_build_address(guint idx, BenchMsgType msg_type)
+{
+    nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+    const in_addr_t              addr  = htonl(0x0a000000u + idx + 1);
+    struct ifaddrmsg             ifa;
+
+    ifa = (struct ifaddrmsg) {
+        .ifa_family    = AF_INET,
+        .ifa_prefixlen = 16,
+        .ifa_scope     = RT_SCOPE_UNIVERSE,
+        .ifa_index     = _ifindex(idx),
+    };
+
+    nlmsg = nlmsg_alloc_new(0, msg_type == BENCH_MSG_DEL ? RTM_DELADDR : RTM_NEWADDR, 0);
+    if (nlmsg_append_struct(nlmsg, &ifa) < 0)
+        goto nla_put_failure;
+
+    NLA_PUT(nlmsg, IFA_LOCAL, sizeof(addr), &addr);
+    NLA_PUT(nlmsg, IFA_ADDRESS, sizeof(addr), &addr);
+    NLA_PUT_U32(nlmsg, IFA_FLAGS, msg_type == BENCH_MSG_UPDATE ? IFA_F_NOPREFIXROUTE : 0);
+
+    return _nlmsg_dup_hdr(nlmsg);
+
+nla_put_failure:
+    g_return_val_if_reached(NULL);
+}
+
+static struct nlmsghdr *
+_build_route(guint idx, BenchMsgType msg_type)
+{
+    nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+    const in_addr_t              dst   = htonl(0xac100000u + idx);
+    const in_addr_t              src   = htonl(0x0a000001u);
+    struct rtmsg                 rtm;
+
+    rtm = (struct rtmsg) {
+        .rtm_family   = AF_INET,
+        .rtm_dst_len  = 32,
+        .rtm_table    = RT_TABLE_MAIN,
+        .rtm_protocol = RTPROT_STATIC,
+        .rtm_scope    = RT_SCOPE_LINK,
+        .rtm_type     = RTN_UNICAST,
+    };
+
+    switch (msg_type) {
+    case BENCH_MSG_NEW:
+        nlmsg = nlmsg_alloc_new(0, RTM_NEWROUTE, NLM_F_CREATE | NLM_F_EXCL);
+        break;
+    case BENCH_MSG_UPDATE:
+        nlmsg = nlmsg_alloc_new(0, RTM_NEWROUTE, NLM_F_REPLACE);
+        break;
+    case BENCH_MSG_DEL:
+        nlmsg = nlmsg_alloc_new(0, RTM_DELROUTE, 0);
+        break;
+    }
+
+    if (nlmsg_append_struct(nlmsg, &rtm) < 0)
+        goto nla_put_failure;
+
+    NLA_PUT_U32(nlmsg, RTA_TABLE, RT_TABLE_MAIN);
+    NLA_PUT(nlmsg, RTA_DST, sizeof(dst), &dst);
+    NLA_PUT_U32(nlmsg, RTA_OIF, _ifindex(idx));
+    NLA_PUT_U32(nlmsg, RTA_PRIORITY, 100);
+    if (msg_type == BENCH_MSG_UPDATE)
+        NLA_PUT(nlmsg, RTA_PREFSRC, sizeof(src), &src);
+
+    return _nlmsg_dup_hdr(nlmsg);
+
+nla_put_failure:
+    g_return_val_if_reached(NULL);
+}
+
+static int
+_n_objects(NMPObjectType obj_type)
+{
+    switch (obj_type) {
+    case NMP_OBJECT_TYPE_LINK:
+        return global_opt.n_links;
+    case NMP_OBJECT_TYPE_IP4_ADDRESS:
+        return global_opt.n_addresses;
+    case NMP_OBJECT_TYPE_IP4_ROUTE:
+        return global_opt.n_routes;
+    default:
+        g_return_val_if_reached(0);
+    }
+}
+
+static GPtrArray *
+_build_msgs(NMPObjectType obj_type, BenchMsgType msg_type, guint idx_from, guint idx_to)
+{
+    GPtrArray *msgs;
+    guint      idx;
+
+    msgs = g_ptr_array_new_full(idx_to - idx_from, g_free);
+    for (idx = idx_from; idx < idx_to; idx++) {
+        switch (obj_type) {
+        case NMP_OBJECT_TYPE_LINK:
+            g_ptr_array_add(msgs, _build_link(idx, msg_type));
+            break;
+        case NMP_OBJECT_TYPE_IP4_ADDRESS:
+            g_ptr_array_add(msgs, _build_address(idx, msg_type));
+            break;
+        case NMP_OBJECT_TYPE_IP4_ROUTE:
+            g_ptr_array_add(msgs, _build_route(idx, msg_type));
+            break;
+        default:
+            g_assert_not_reached();
+        }
+    }
+    return msgs;
+}
+
+/*****************************************************************************/
+
+static void
+_feed_msgs(BenchData *bench, const GPtrArray *msgs, gboolean is_dump)
+{
+    guint i;
+
+    for (i = 0; i < msgs->len; i++) {
+        const struct nlmsghdr          *nlh     = msgs->pdata[i];
+        nm_auto_nmpobj NMPObject       *obj     = NULL;
+        nm_auto_nmpobj const NMPObject *obj_old = NULL;
+        nm_auto_nmpobj const NMPObject *obj_new = NULL;
+
+        obj = nmtst_linux_platform_new_object_from_nl(bench->platform, bench->cache, nlh);
+        g_assert(obj);
+
+        if (NM_IN_SET(nlh->nlmsg_type, RTM_DELLINK, RTM_DELADDR, RTM_DELROUTE)) {
+            nmp_cache_remove_netlink(bench->cache, obj, &obj_old, &obj_new);
+        } else if (NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_IP4_ROUTE) {
+            nm_auto_nmpobj const NMPObject *obj_replace = NULL;
+            gboolean                        resync_required;
+
+            nmp_cache_update_netlink_route(bench->cache,
+                                           obj,
+                                           is_dump,
+                                           nlh->nlmsg_flags,
+                                           TRUE,
+                                           &obj_old,
+                                           &obj_new,
+                                           &obj_replace,
+                                           &resync_required);
+        } else
+            nmp_cache_update_netlink(bench->cache, obj, is_dump, &obj_old, &obj_new);
+    }
+}
+
+static void
+bench_add_update(BenchData *bench, NMPObjectType obj_type)
+{
+    gs_unref_ptrarray GPtrArray *msgs = NULL;
+    BenchTimer                   timer;
+    int                          n = _n_objects(obj_type);
+
+    msgs = _build_msgs(obj_type, BENCH_MSG_NEW, 0, n);
+    _timer_start(&timer);
+    _feed_msgs(bench, msgs, FALSE);
+    _timer_report(&timer, obj_type, "add", msgs->len);
+    g_clear_pointer(&msgs, g_ptr_array_unref);
+
+    msgs = _build_msgs(obj_type, BENCH_MSG_UPDATE, 0, n);
+    _timer_start(&timer);
+    _feed_msgs(bench, msgs, FALSE);
+    _timer_report(&timer, obj_type, "update", msgs->len);
+}
+
+static void
+bench_lookup(BenchData *bench, NMPObjectType obj_type)
+{
+    BenchTimer timer;
+    guint      n_found = 0;
+    int        idx;
+
+    _timer_start(&timer);
+    for (idx = 0; idx < global_opt.n_links; idx++) {
+        NMPLookup lookup;
+        char      ifname[IFNAMSIZ];
+
+        if (obj_type == NMP_OBJECT_TYPE_LINK)
+            nmp_lookup_init_link_by_ifname(&lookup, nm_sprintf_buf(ifname, "bench%d", idx));
+        else
+            nmp_lookup_init_object_by_ifindex(&lookup, obj_type, _ifindex(idx));
+
+        n_found += _head_entry_len(nmp_cache_lookup(bench->cache, &lookup));
+    }
+    _timer_report(&timer, obj_type, "lookup-all", global_opt.n_links);
+
+    g_assert_cmpint(n_found, ==, _n_objects(obj_type));
+}
+
+static void
+bench_lookup_weak_id(BenchData *bench)
+{
+    BenchTimer timer;
+    guint      n_found = 0;
+    int        idx;
+
+    _timer_start(&timer, NMP_OBJECT_TYPE_IP4_ROUTE);
+    for (idx = 0; idx < global_opt.n_routes; idx++) {
+        NMPLookup lookup;
+
+        nmp_lookup_init_ip4_route_by_weak_id(&lookup,
+                                             RT_TABLE_MAIN,
+                                             htonl(0xac100000u + idx),
+                                             32,
+                                             100,
+                                             0);
+        n_found += _head_entry_len(nmp_cache_lookup(bench->cache, &lookup));
+    }
+    _timer_report(&timer, NMP_OBJECT_TYPE_IP4_ROUTE, "weak-id", global_opt.n_routes);
+
+    g_assert_cmpint(n_found, ==, global_opt.n_routes);
+}
+
+static void
+bench_prune(BenchData *bench, NMPObjectType obj_type)
+{
+    gs_unref_ptrarray GPtrArray *msgs = NULL;
+    BenchTimer                   timer;
+    NMPLookup                    lookup;
+    NMDedupMultiIter             iter;
+    guint                        n_pruned = 0;
+    int                          n        = _n_objects(obj_type);
+
+    /* Like a resync: mark everything dirty, dump the first half again, and
+     * prune the rest (see cache_prune_one_type() in nm-linux-platform.c). */
+    msgs = _build_msgs(obj_type, BENCH_MSG_UPDATE, 0, n / 2);
+
+    _timer_start(&timer);
+    nmp_lookup_init_obj_type(&lookup, obj_type);
+    nmp_cache_dirty_set_all_main(bench->cache, &lookup);
+    _feed_msgs(bench, msgs, TRUE);
+    nm_dedup_multi_iter_init(&iter, nmp_cache_lookup(bench->cache, &lookup));
+    while (nm_dedup_multi_iter_next(&iter)) {
+        nm_auto_nmpobj const NMPObject *obj_old = NULL;
+
+        if (!iter.current->dirty)
+            continue;
+        nmp_cache_remove(bench->cache, iter.current->obj, TRUE, TRUE, &obj_old);
+        n_pruned++;
+    }
+    _timer_report(&timer, obj_type, "prune", n);
+
+    g_assert_cmpint(n_pruned, ==, n - n / 2);
+}
+
+static void
+bench_remove(BenchData *bench, NMPObjectType obj_type)
+{
+    gs_unref_ptrarray GPtrArray *msgs = NULL;
+    BenchTimer                   timer;
+    NMPLookup                    lookup;
+
+    msgs = _build_msgs(obj_type, BENCH_MSG_DEL, 0, _n_objects(obj_type) / 2);
+
+    _timer_start(&timer);
+    _feed_msgs(bench, msgs, FALSE);
+    _timer_report(&timer, obj_type, "remove", msgs->len);
+
+    nmp_lookup_init_obj_type(&lookup, obj_type);
+    g_assert_cmpint(_head_entry_len(nmp_cache_lookup(bench->cache, &lookup)), ==, 0);
+}
+
+/*****************************************************************************/
+
+static gboolean
+read_argv(int *argc, char ***argv)
+{
+    GOptionContext *context;
+    GOptionEntry    options[] = {
+        {"links", 'l', 0, G_OPTION_ARG_INT, &global_opt.n_links, "Number of links", "N"},
+        {"addresses",
+            'a',
+            0,
+            G_OPTION_ARG_INT,
+            &global_opt.n_addresses,
+            "Number of IPv4 addresses",
+            "N"},
+        {"routes", 'r', 0, G_OPTION_ARG_INT, &global_opt.n_routes, "Number of IPv4 routes", "N"},
+        {0},
+    };
+    gs_free_error GError *error = NULL;
+
+    context = g_option_context_new(NULL);
+    g_option_context_set_summary(context, "Benchmark parsing and caching of netlink objects.");
+    g_option_context_add_main_entries(context, options, NULL);
+
+    if (!g_option_context_parse(context, argc, argv, &error)) {
+        g_warning("Error parsing command line arguments: %s", error->message);
+        g_option_context_free(context);
+        return FALSE;
+    }
+
+    g_option_context_free(context);
+
+    if (global_opt.n_links <= 0 || global_opt.n_addresses < 0 || global_opt.n_routes < 0
+        || global_opt.n_links > 100000 || global_opt.n_addresses > 0xFFFFFF
+        || global_opt.n_routes > 0xFFFFF) {
+        g_warning("Invalid number of objects");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+int
+main(int argc, char **argv)
+{
+    static const NMPObjectType obj_types[] = {
+        NMP_OBJECT_TYPE_LINK,
+        NMP_OBJECT_TYPE_IP4_ADDRESS,
+        NMP_OBJECT_TYPE_IP4_ROUTE,
+    };
+    nm_auto_unref_dedup_multi_index NMDedupMultiIndex *multi_idx = NULL;
+    BenchData                                          bench;
+    int                                                i;
+
+    nmtst_init_with_logging(&argc, &argv, "WARN", "DEFAULT");
+
+    if (!read_argv(&argc, &argv))
+        return 2;
+
+    multi_idx = nm_dedup_multi_index_new();
+
+    bench = (BenchData) {
+        .platform = g_object_new(NM_TYPE_FAKE_PLATFORM, NM_PLATFORM_LOG_WITH_PTR, FALSE, NULL),
+        .cache    = nmp_cache_new(multi_idx, FALSE),
+    };
+
+    for (i = 0; i < (int) G_N_ELEMENTS(obj_types); i++)
+        bench_add_update(&bench, obj_types[i]);
+
+    for (i = 0; i < (int) G_N_ELEMENTS(obj_types); i++)
+        bench_lookup(&bench, obj_types[i]);
+
+    bench_lookup_weak_id(&bench);
+
+    for (i = G_N_ELEMENTS(obj_types) - 1; i >= 0; i--)
+        bench_prune(&bench, obj_types[i]);
+
+    for (i = G_N_ELEMENTS(obj_types) - 1; i >= 0; i--)
+        bench_remove(&bench, obj_types[i]);
+
+    nmp_cache_free(bench.cache);
+    g_object_unref(bench.platform);
+
+    return EXIT_SUCCESS;
+}
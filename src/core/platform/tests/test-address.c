@@ -436,6 +436,76 @@ test_ip4_address_peer_zero(void)
     }
 }
 
+static void
+test_ip_address_delete_many(void)
+{
+    const int                    ifindex = DEVICE_IFINDEX;
+    gs_unref_ptrarray GPtrArray *objs    = NULL;
+    gs_free int                 *results = NULL;
+    NMPLookup                    lookup;
+    const NMPlatformIP6Address  *a6;
+    NMPlatformIP4Address         a4;
+    struct in6_addr              addr6;
+    guint                        i;
+
+    g_assert(nm_platform_link_change_flags(NM_PLATFORM_GET, ifindex, IFF_UP, TRUE) >= 0);
+
+    for (i = 0; i < 20; i++) {
+        nmtstp_ip4_address_add(NULL,
+                               EX,
+                               ifindex,
+                               htonl(0xc0000200u + i + 1),
+                               IP4_PLEN,
+                               htonl(0xc0000200u + i + 1),
+                               NM_PLATFORM_LIFETIME_PERMANENT,
+                               NM_PLATFORM_LIFETIME_PERMANENT,
+                               0,
+                               NULL);
+    }
+    inet_pton(AF_INET6, IP6_ADDRESS, &addr6);
+    nmtstp_ip6_address_add(NULL,
+                           EX,
+                           ifindex,
+                           addr6,
+                           IP6_PLEN,
+                           in6addr_any,
+                           NM_PLATFORM_LIFETIME_PERMANENT,
+                           NM_PLATFORM_LIFETIME_PERMANENT,
+                           0);
+
+    objs = nm_platform_lookup_clone(
+        NM_PLATFORM_GET,
+        nmp_lookup_init_object_by_ifindex(&lookup, NMP_OBJECT_TYPE_IP4_ADDRESS, ifindex),
+        NULL,
+        NULL);
+    g_assert(objs);
+    g_assert_cmpint(objs->len, ==, 20);
+
+    a6 = nm_platform_ip6_address_get(NM_PLATFORM_GET, ifindex, &addr6);
+    g_assert(a6);
+    g_ptr_array_add(objs, (gpointer) nmp_object_ref(NMP_OBJECT_UP_CAST(a6)));
+
+    /* An address that does not exist also counts as deleted. */
+    a4 = (NMPlatformIP4Address) {
+        .ifindex      = ifindex,
+        .address      = htonl(0xc0000264u),
+        .peer_address = htonl(0xc0000264u),
+        .plen         = IP4_PLEN,
+    };
+    g_ptr_array_add(objs, nmp_object_new(NMP_OBJECT_TYPE_IP4_ADDRESS, &a4));
+
+    results = g_new(int, objs->len);
+    g_assert(nm_platform_object_delete_many(NM_PLATFORM_GET,
+                                            (const NMPObject *const *) objs->pdata,
+                                            objs->len,
+                                            results));
+    for (i = 0; i < objs->len; i++)
+        g_assert_cmpint(results[i], ==, 0);
+
+    g_assert(!nm_platform_lookup(NM_PLATFORM_GET, &lookup));
+    g_assert(!nm_platform_ip6_address_get(NM_PLATFORM_GET, ifindex, &addr6));
+}
+
 /*****************************************************************************/
 
 NMTstpSetupFunc const _nmtstp_setup_platform_func = SETUP;
@@ -462,4 +532,6 @@ _nmtstp_setup_tests(void)
 
     add_test_func("/address/ipv4/peer", test_ip4_address_peer);
     add_test_func("/address/ipv4/peer/zero", test_ip4_address_peer_zero);
+
+    add_test_func("/address/delete-many", test_ip_address_delete_many);
 }
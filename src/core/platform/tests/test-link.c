@@ -17,6 +17,7 @@
 #include "libnm-platform/nmp-netns.h"
 #include "libnm-platform/nmp-ethtool-ioctl.h"
 #include "libnm-platform/nm-platform-utils.h"
+#include "libnm-platform/nm-platform-private.h"
 
 #include "test-common.h"
 #include "nm-test-utils-core.h"
@@ -3056,6 +3057,111 @@ again:
 
 /*****************************************************************************/
 
+static void
+test_platform_events(void)
+{
+    gs_strfreev char **events_disabled = NULL;
+    gs_strfreev char **events          = NULL;
+    gs_strfreev char **events_recent   = NULL;
+    gs_strfreev char **events_cleared  = NULL;
+    gboolean           has_add         = FALSE;
+    gboolean           has_remove      = FALSE;
+    gboolean           has_recvmsg     = FALSE;
+    int                ifindex;
+    guint              i;
+
+    /* Without history, nothing gets recorded. */
+    nm_platform_set_event_history(NM_PLATFORM_GET, 0);
+    ifindex = nmtstp_link_dummy_add(NM_PLATFORM_GET, -1, DEVICE_NAME)->ifindex;
+    nmtstp_link_delete(NM_PLATFORM_GET, -1, ifindex, DEVICE_NAME, TRUE);
+    events_disabled = nm_platform_get_events(NM_PLATFORM_GET, -1);
+    g_assert_cmpint(NM_PTRARRAY_LEN(events_disabled), ==, 0);
+
+    nm_platform_set_event_history(NM_PLATFORM_GET, 1000);
+    ifindex = nmtstp_link_dummy_add(NM_PLATFORM_GET, -1, DEVICE_NAME)->ifindex;
+    nmtstp_link_delete(NM_PLATFORM_GET, -1, ifindex, DEVICE_NAME, TRUE);
+
+    events = nm_platform_get_events(NM_PLATFORM_GET, -1);
+    for (i = 0; events[i]; i++) {
+        if (strstr(events[i], "update-cache-link: ADD: ") && strstr(events[i], DEVICE_NAME))
+            has_add = TRUE;
+        else if (strstr(events[i], "update-cache-link: REMOVE: "))
+            has_remove = TRUE;
+        else if (strstr(events[i], ": recvmsg: "))
+            has_recvmsg = TRUE;
+    }
+    g_assert(has_add);
+    g_assert(has_remove);
+    g_assert(has_recvmsg);
+
+    /* The window only returns events that are recent enough. */
+    g_usleep(100 * 1000);
+    events_recent = nm_platform_get_events(NM_PLATFORM_GET, 50);
+    g_assert_cmpint(NM_PTRARRAY_LEN(events_recent), <, NM_PTRARRAY_LEN(events));
+
+    nm_platform_set_event_history(NM_PLATFORM_GET, 0);
+    events_cleared = nm_platform_get_events(NM_PLATFORM_GET, -1);
+    g_assert_cmpint(NM_PTRARRAY_LEN(events_cleared), ==, 0);
+}
+
+/*****************************************************************************/
+
+static void
+test_nl_overflow_backoff(void)
+{
+    const int                   N_LINKS = 50;
+    NMLinuxPlatformNetlinkStats stats_before;
+    NMLinuxPlatformNetlinkStats stats;
+    gint64                      start_msec;
+    int                         rcvbuf = 0;
+    int                         fd;
+
+    if (!NM_IS_LINUX_PLATFORM(NM_PLATFORM_GET)) {
+        g_test_skip("Only the linux platform reads from netlink");
+        return;
+    }
+
+    nm_platform_process_events(NM_PLATFORM_GET);
+    nm_linux_platform_get_netlink_stats(NM_PLATFORM_GET, NETLINK_ROUTE, &stats_before);
+    g_assert(!stats_before.resync_pending);
+
+    /* Shrink the receive buffer to the minimum, and create more links than
+     * fit into it while we don't read. The next read fails with ENOBUFS. */
+    fd = nmtst_linux_platform_get_netlink_fd(NM_PLATFORM_GET, NETLINK_ROUTE);
+    g_assert_cmpint(setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf)), ==, 0);
+
+    nmtstp_run_command_check("for i in $(seq %d); do ip link add nm-test-ovf$i type dummy; done",
+                             N_LINKS);
+
+    /* Handling the overflow must not block in the backoff. */
+    start_msec = nm_utils_get_monotonic_timestamp_msec();
+    nm_platform_process_events(NM_PLATFORM_GET);
+    g_assert_cmpint(nm_utils_get_monotonic_timestamp_msec() - start_msec, <, 500);
+
+    nm_linux_platform_get_netlink_stats(NM_PLATFORM_GET, NETLINK_ROUTE, &stats);
+    g_assert_cmpint(stats.overflows, >, stats_before.overflows);
+    g_assert_cmpint(stats.resyncs, ==, stats_before.resyncs);
+    g_assert(stats.resync_pending);
+
+    /* The resync happens later, from the main loop. */
+    NMTST_WAIT_ASSERT(3000, {
+        nmtstp_wait_for_signal(NM_PLATFORM_GET, 100);
+        nm_linux_platform_get_netlink_stats(NM_PLATFORM_GET, NETLINK_ROUTE, &stats);
+        if (!stats.resync_pending)
+            break;
+    });
+    g_assert_cmpint(stats.resyncs, ==, stats_before.resyncs + 1);
+
+    g_assert(nm_platform_link_get_by_ifname(NM_PLATFORM_GET, "nm-test-ovf1"));
+    g_assert(nm_platform_link_get_by_ifname(NM_PLATFORM_GET,
+                                            nm_sprintf_bufa(20, "nm-test-ovf%d", N_LINKS)));
+
+    nmtstp_run_command_check("for i in $(seq %d); do ip link del nm-test-ovf$i; done", N_LINKS);
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 100);
+}
+
+/*****************************************************************************/
+
 static void
 _test_netns_setup(gpointer fixture, gconstpointer test_data)
 {
@@ -4182,6 +4288,8 @@ _nmtstp_setup_tests(void)
         g_test_add_func("/link/nl-bugs/veth", test_nl_bugs_veth);
         g_test_add_func("/link/nl-bugs/spurious-newlink", test_nl_bugs_spuroius_newlink);
         g_test_add_func("/link/nl-bugs/spurious-dellink", test_nl_bugs_spuroius_dellink);
+        g_test_add_func("/link/nl-overflow-backoff", test_nl_overflow_backoff);
+        g_test_add_func("/link/platform-events", test_platform_events);
 
         g_test_add_vtable("/general/netns/general",
                           0,
@@ -11,6 +11,7 @@
 #include "nm-core-utils.h"
 #include "libnm-platform/nm-platform-utils.h"
 #include "libnm-platform/nmp-global-tracker.h"
+#include "libnm-platform/nm-platform-private.h"
 
 #include "test-common.h"
 
@@ -593,6 +594,60 @@ test_ip4_route_get(void)
     nmtstp_wait_for_signal(NM_PLATFORM_GET, 50);
 }
 
+static void
+test_ip4_route_dump_intr(void)
+{
+    const int          ifindex = nm_platform_link_get_ifindex(NM_PLATFORM_GET, DEVICE_NAME);
+    const in_addr_t    network_static = nmtst_inet4_from_string("198.51.100.0");
+    const in_addr_t    network_boot   = nmtst_inet4_from_string("198.51.101.0");
+    const in_addr_t    network_stale  = nmtst_inet4_from_string("198.51.102.0");
+    NMPlatformIP4Route r_stale;
+
+    if (!NM_IS_LINUX_PLATFORM(NM_PLATFORM_GET)) {
+        g_test_skip("Only the linux platform dumps from netlink");
+        return;
+    }
+
+    nmtstp_run_command_check("ip route add 198.51.100.0/24 dev %s proto static", DEVICE_NAME);
+    nmtstp_run_command_check("ip route add 198.51.101.0/24 dev %s proto boot", DEVICE_NAME);
+
+    NMTST_WAIT_ASSERT(100, {
+        nmtstp_wait_for_signal(NM_PLATFORM_GET, 10);
+        if (nmtstp_ip4_route_get(NM_PLATFORM_GET, ifindex, network_static, 24, 0, 0)
+            && nmtstp_ip4_route_get(NM_PLATFORM_GET, ifindex, network_boot, 24, 0, 0))
+            break;
+    });
+
+    /* Put a route into the cache that kernel doesn't have. The next resync
+     * must prune it. */
+    r_stale = (NMPlatformIP4Route) {
+        .ifindex       = ifindex,
+        .network       = network_stale,
+        .plen          = 24,
+        .rt_source     = NM_IP_CONFIG_SOURCE_RTPROT_STATIC,
+        .table_coerced = nm_platform_route_table_coerce(RT_TABLE_MAIN),
+        .scope_inv     = nm_platform_route_scope_inv(RT_SCOPE_LINK),
+    };
+    nmp_cache_update_netlink(nm_platform_get_cache(NM_PLATFORM_GET),
+                             nmp_object_new(NMP_OBJECT_TYPE_IP4_ROUTE, &r_stale),
+                             FALSE,
+                             NULL,
+                             NULL);
+    g_assert(nmtstp_ip4_route_get(NM_PLATFORM_GET, ifindex, network_stale, 24, 0, 0));
+
+    /* The first route dump gets interrupted. Only its protocol is dumped again,
+     * and the pruning still happens once all dumps are done. */
+    nmtst_linux_platform_set_dump_intr(NM_PLATFORM_GET, RTM_NEWROUTE, 1);
+    nmtst_linux_platform_refresh_all(NM_PLATFORM_GET);
+
+    g_assert(!nmtstp_ip4_route_get(NM_PLATFORM_GET, ifindex, network_stale, 24, 0, 0));
+    g_assert(nmtstp_ip4_route_get(NM_PLATFORM_GET, ifindex, network_static, 24, 0, 0));
+    g_assert(nmtstp_ip4_route_get(NM_PLATFORM_GET, ifindex, network_boot, 24, 0, 0));
+
+    nmtstp_run_command_check("ip route flush dev %s", DEVICE_NAME);
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 50);
+}
+
 static void
 test_ip4_zero_gateway(void)
 {
@@ -814,6 +869,103 @@ test_ip4_route_options(gconstpointer test_data)
 #undef RTS_MAX
 }
 
+static void
+test_ip4_route_sync_batch(void)
+{
+    const int                    IFINDEX       = DEVICE_IFINDEX;
+    const guint                  N_ROUTES      = 300;
+    gs_unref_ptrarray GPtrArray *routes        = NULL;
+    gs_unref_ptrarray GPtrArray *routes_failed = NULL;
+    gs_unref_ptrarray GPtrArray *routes_prune  = NULL;
+    gs_unref_ptrarray GPtrArray *routes_cur    = NULL;
+    const NMPObject             *obj_unreachable;
+    guint                        i;
+
+    /* Sync more routes than fit into one batch window. Gateway routes depend on the
+     * device routes being added first, and one route is expected to fail. */
+
+    routes = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+
+    for (i = 0; i < N_ROUTES; i++) {
+        const NMPlatformIP4Route r = {
+            .ifindex    = IFINDEX,
+            .rt_source  = NM_IP_CONFIG_SOURCE_USER,
+            .network    = htonl(0x0A640000u + (i << 8)), /* 10.100.0.0/24 and following */
+            .plen       = 24,
+            .metric     = 22987,
+            .n_nexthops = 1,
+        };
+
+        g_ptr_array_add(routes, nmp_object_new(NMP_OBJECT_TYPE_IP4_ROUTE, &r));
+    }
+    g_ptr_array_add(routes,
+                    nmp_object_new(NMP_OBJECT_TYPE_IP4_ROUTE,
+                                   &((const NMPlatformIP4Route) {
+                                       .ifindex    = IFINDEX,
+                                       .rt_source  = NM_IP_CONFIG_SOURCE_USER,
+                                       .network    = nmtst_inet4_from_string("192.0.2.0"),
+                                       .gateway    = nmtst_inet4_from_string("10.100.0.1"),
+                                       .plen       = 24,
+                                       .metric     = 22987,
+                                       .n_nexthops = 1,
+                                   })));
+    obj_unreachable =
+        nmp_object_new(NMP_OBJECT_TYPE_IP4_ROUTE,
+                       &((const NMPlatformIP4Route) {
+                           .ifindex    = IFINDEX,
+                           .rt_source  = NM_IP_CONFIG_SOURCE_USER,
+                           .network    = nmtst_inet4_from_string("198.51.100.0"),
+                           .gateway    = nmtst_inet4_from_string("203.0.113.1"),
+                           .plen       = 24,
+                           .metric     = 22987,
+                           .n_nexthops = 1,
+                       }));
+    g_ptr_array_add(routes, (gpointer) obj_unreachable);
+
+    g_assert(!nm_platform_ip_route_sync(NM_PLATFORM_GET,
+                                        AF_INET,
+                                        IFINDEX,
+                                        routes,
+                                        NULL,
+                                        &routes_failed));
+    g_assert(routes_failed);
+    g_assert_cmpint(routes_failed->len, ==, 1);
+    g_assert(nmp_object_id_equal(routes_failed->pdata[0], obj_unreachable));
+
+    for (i = 0; i < routes->len; i++) {
+        const NMPObject *o = routes->pdata[i];
+
+        if (o == obj_unreachable)
+            g_assert(!nm_platform_lookup_entry(NM_PLATFORM_GET, NMP_CACHE_ID_TYPE_OBJECT_TYPE, o));
+        else
+            g_assert(nm_platform_lookup_entry(NM_PLATFORM_GET, NMP_CACHE_ID_TYPE_OBJECT_TYPE, o));
+    }
+
+    /* Keep the first half of the device routes and prune everything else. */
+    routes_prune = nmtstp_ip4_route_get_all(NM_PLATFORM_GET, IFINDEX);
+    g_assert_cmpint(routes_prune->len, ==, N_ROUTES + 1);
+    g_ptr_array_set_size(routes, N_ROUTES / 2);
+    g_assert(nm_platform_ip_route_sync(NM_PLATFORM_GET,
+                                       AF_INET,
+                                       IFINDEX,
+                                       routes,
+                                       routes_prune,
+                                       NULL));
+
+    routes_cur = nmtstp_ip4_route_get_all(NM_PLATFORM_GET, IFINDEX);
+    g_assert_cmpint(routes_cur->len, ==, N_ROUTES / 2);
+    for (i = 0; i < routes->len; i++) {
+        g_assert(nm_platform_lookup_entry(NM_PLATFORM_GET,
+                                          NMP_CACHE_ID_TYPE_OBJECT_TYPE,
+                                          routes->pdata[i]));
+    }
+
+    g_assert(nm_platform_ip_route_flush(NM_PLATFORM_GET, AF_INET, IFINDEX));
+    nm_clear_pointer(&routes_cur, g_ptr_array_unref);
+    routes_cur = nmtstp_ip4_route_get_all(NM_PLATFORM_GET, IFINDEX);
+    g_assert_cmpint(routes_cur->len, ==, 0);
+}
+
 static void
 test_ip6_route_get(void)
 {
@@ -860,6 +1012,58 @@ test_ip6_route_get(void)
     nmtstp_wait_for_signal(NM_PLATFORM_GET, 50);
 }
 
+static void
+test_ip6_route_get_untracked(void)
+{
+    int                       ifindex = nm_platform_link_get_ifindex(NM_PLATFORM_GET, DEVICE_NAME);
+    int                       result;
+    nm_auto_nmpobj NMPObject *route = NULL;
+    const NMPlatformIP6Route *r;
+
+    /* Routes with protocol "bgp" are not tracked, and the socket filter drops their
+     * notifications. The response to RTM_GETROUTE must still get through. */
+    nmtstp_run_command_check("ip -6 route add fd01:abce::/64 via fe80::99 dev %s proto bgp",
+                             DEVICE_NAME);
+
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 50);
+    g_assert(!nmtstp_ip6_route_get(NM_PLATFORM_GET,
+                                   ifindex,
+                                   nmtst_inet6_from_string_p("fd01:abce::"),
+                                   64,
+                                   NM_PLATFORM_ROUTE_METRIC_DEFAULT_IP6,
+                                   NULL,
+                                   0));
+
+    result = nm_platform_ip_route_get(NM_PLATFORM_GET,
+                                      AF_INET6,
+                                      nmtst_inet6_from_string_p("fd01:abce::42"),
+                                      0,
+                                      nmtst_get_rand_uint32() % 2 ? 0 : ifindex,
+                                      &route);
+
+    g_assert(NMTST_NM_ERR_SUCCESS(result));
+    g_assert(NMP_OBJECT_GET_TYPE(route) == NMP_OBJECT_TYPE_IP6_ROUTE);
+    r = NMP_OBJECT_CAST_IP6_ROUTE(route);
+    g_assert(r->ifindex == ifindex);
+    nmtst_assert_ip6_address(&r->network, "fd01:abce::42");
+    g_assert_cmpint(r->plen, ==, 128);
+    nmtst_assert_ip6_address(&r->gateway, "fe80::99");
+
+    /* The lookup result is not added to the cache. */
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 50);
+    g_assert(!nmtstp_ip6_route_get(NM_PLATFORM_GET,
+                                   ifindex,
+                                   nmtst_inet6_from_string_p("fd01:abce::42"),
+                                   128,
+                                   NM_PLATFORM_ROUTE_METRIC_DEFAULT_IP6,
+                                   NULL,
+                                   0));
+
+    nmtstp_run_command_check("ip -6 route flush dev %s", DEVICE_NAME);
+
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 50);
+}
+
 static void
 test_ip6_route_options(gconstpointer test_data)
 {
@@ -2493,7 +2697,10 @@ _nmtstp_setup_tests(void)
         add_test_func_data("/route/ip/1", test_ip, GINT_TO_POINTER(1));
         add_test_func("/route/ip4_route_get", test_ip4_route_get);
         add_test_func("/route/ip6_route_get", test_ip6_route_get);
+        add_test_func("/route/ip4_route_dump_intr", test_ip4_route_dump_intr);
+        add_test_func("/route/ip6_route_get_untracked", test_ip6_route_get_untracked);
         add_test_func("/route/ip4_zero_gateway", test_ip4_zero_gateway);
+        add_test_func("/route/ip4_route_sync_batch", test_ip4_route_sync_batch);
         add_test_func("/route/via", test_via);
     }
 
@@ -159,3 +159,61 @@ nm_sett_util_storages_steal(NMSettUtilStorages *storages,
 
     return storage;
 }
+
+/*****************************************************************************/
+
+GHashTable *
+nm_sett_util_ifname_idx_new(void)
+{
+    return g_hash_table_new_full(nm_str_hash,
+                                 g_str_equal,
+                                 g_free,
+                                 (GDestroyNotify) g_ptr_array_unref);
+}
+
+void
+nm_sett_util_ifname_idx_add(GHashTable *idx, const char *ifname, gpointer item)
+{
+    GPtrArray *arr;
+
+    nm_assert(item);
+
+    ifname = ifname ?: "";
+
+    arr = g_hash_table_lookup(idx, ifname);
+    if (!arr) {
+        arr = g_ptr_array_new();
+        g_hash_table_insert(idx, g_strdup(ifname), arr);
+    }
+
+    nm_assert(!g_ptr_array_find(arr, item, NULL));
+    g_ptr_array_add(arr, item);
+}
+
+void
+nm_sett_util_ifname_idx_remove(GHashTable *idx, const char *ifname, gpointer item)
+{
+    GPtrArray *arr;
+
+    ifname = ifname ?: "";
+
+    arr = g_hash_table_lookup(idx, ifname);
+    if (!arr || !g_ptr_array_remove_fast(arr, item))
+        g_return_if_reached();
+
+    if (arr->len == 0)
+        g_hash_table_remove(idx, ifname);
+}
+
+void
+nm_sett_util_ifname_idx_update(GHashTable *idx,
+                               const char *ifname_old,
+                               const char *ifname_new,
+                               gpointer    item)
+{
+    if (nm_streq(ifname_old ?: "", ifname_new ?: ""))
+        return;
+
+    nm_sett_util_ifname_idx_remove(idx, ifname_old, item);
+    nm_sett_util_ifname_idx_add(idx, ifname_new, item);
+}
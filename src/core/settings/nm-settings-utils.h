@@ -88,4 +88,26 @@ typedef struct {
 
 gboolean nm_sett_util_allow_filename_cb(const char *filename, gpointer user_data);
 
+/*****************************************************************************/
+
+/* An index of profiles by "connection.interface-name". Profiles without
+ * interface-name are tracked under %NULL. */
+
+GHashTable *nm_sett_util_ifname_idx_new(void);
+
+void nm_sett_util_ifname_idx_add(GHashTable *idx, const char *ifname, gpointer item);
+
+void nm_sett_util_ifname_idx_remove(GHashTable *idx, const char *ifname, gpointer item);
+
+void nm_sett_util_ifname_idx_update(GHashTable *idx,
+                                    const char *ifname_old,
+                                    const char *ifname_new,
+                                    gpointer    item);
+
+static inline const GPtrArray *
+nm_sett_util_ifname_idx_lookup(GHashTable *idx, const char *ifname)
+{
+    return g_hash_table_lookup(idx, ifname ?: "");
+}
+
 #endif /* __NM_SETTINGS_UTILS_H__ */
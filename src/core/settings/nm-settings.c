@@ -53,6 +53,7 @@
 #include "devices/nm-device-ethernet.h"
 #include "nm-settings-connection.h"
 #include "nm-settings-plugin.h"
+#include "nm-settings-utils.h"
 #include "nm-dbus-manager.h"
 #include "nm-auth-utils.h"
 #include "libnm-core-aux-intern/nm-auth-subject.h"
@@ -385,6 +386,11 @@ typedef struct {
     NMSettingsConnection **connections_cached_list;
     NMSettingsConnection **connections_cached_list_sorted_by_autoconnect_priority;
 
+    /* Index of the connections by "connection.interface-name" (or "" if unset)
+     * for nm_settings_get_connections_for_autoconnect(). The values are
+     * GPtrArray of (unowned) NMSettingsConnection. */
+    GHashTable *autoconnect_idx;
+
     GSList *unmanaged_specs;
     GSList *unrecognized_specs;
 
@@ -1111,6 +1117,9 @@ _connection_changed_update(NMSettings                      *self,
         c_list_link_tail(&priv->connections_lst_head, &sett_conn->_connections_lst);
         priv->connections_len++;
         priv->connections_generation++;
+        nm_sett_util_ifname_idx_add(priv->autoconnect_idx,
+                                    nm_connection_get_interface_name(connection),
+                                    sett_conn);
 
         g_signal_connect(sett_conn,
                          NM_SETTINGS_CONNECTION_FLAGS_CHANGED,
@@ -1118,6 +1127,13 @@ _connection_changed_update(NMSettings                      *self,
                          self);
     }
 
+    if (connection_old) {
+        nm_sett_util_ifname_idx_update(priv->autoconnect_idx,
+                                       nm_connection_get_interface_name(connection_old),
+                                       nm_connection_get_interface_name(connection),
+                                       sett_conn);
+    }
+
     if (NM_FLAGS_HAS(update_reason, NM_SETTINGS_CONNECTION_UPDATE_REASON_BLOCK_AUTOCONNECT)) {
         nm_settings_connection_autoconnect_blocked_reason_set(
             sett_conn,
@@ -1226,6 +1242,10 @@ _connection_changed_delete(NMSettings           *self,
     c_list_unlink(&sett_conn->_connections_lst);
     priv->connections_len--;
     priv->connections_generation++;
+    nm_sett_util_ifname_idx_remove(
+        priv->autoconnect_idx,
+        nm_connection_get_interface_name(nm_settings_connection_get_connection(sett_conn)),
+        sett_conn);
 
     /* Tell agents to remove secrets for this connection */
     connection_for_agents =
@@ -3086,6 +3106,69 @@ _clear_connections_cached_list(NMSettingsPrivate *priv)
     }
 }
 
+/**
+ * nm_settings_get_connections_for_autoconnect:
+ * @self: the #NMSettings
+ * @ifname: the interface name of the device
+ * @out_len: (optional): optional output argument
+ * @func: (nullable): caller-supplied function for filtering connections
+ * @func_data: caller-supplied data passed to @func
+ *
+ * Profiles with a "connection.interface-name" can only activate on a device
+ * with that name. This returns the profiles that have no interface-name set or
+ * whose interface-name is @ifname, without iterating over all profiles.
+ *
+ * Returns: (transfer container): a %NULL terminated array of #NMSettingsConnection,
+ *   filtered by @func and sorted by autoconnect priority. Free with g_free().
+ */
+NMSettingsConnection **
+nm_settings_get_connections_for_autoconnect(NMSettings                    *self,
+                                            const char                    *ifname,
+                                            guint                         *out_len,
+                                            NMSettingsConnectionFilterFunc func,
+                                            gpointer                       func_data)
+{
+    NMSettingsPrivate     *priv;
+    const GPtrArray       *buckets[2];
+    NMSettingsConnection **list;
+    guint                  len = 0;
+    guint                  i;
+    guint                  j;
+
+    g_return_val_if_fail(NM_IS_SETTINGS(self), NULL);
+
+    priv = NM_SETTINGS_GET_PRIVATE(self);
+
+    buckets[0] = nm_sett_util_ifname_idx_lookup(priv->autoconnect_idx, NULL);
+    buckets[1] =
+        (ifname && ifname[0]) ? nm_sett_util_ifname_idx_lookup(priv->autoconnect_idx, ifname) : NULL;
+
+    list = g_new(NMSettingsConnection *,
+                 (gsize) nm_g_ptr_array_len(buckets[0]) + nm_g_ptr_array_len(buckets[1]) + 1u);
+    for (i = 0; i < G_N_ELEMENTS(buckets); i++) {
+        for (j = 0; j < nm_g_ptr_array_len(buckets[i]); j++) {
+            NMSettingsConnection *sett_conn = buckets[i]->pdata[j];
+
+            nm_assert(c_list_contains(&priv->connections_lst_head, &sett_conn->_connections_lst));
+
+            if (!func || func(self, sett_conn, func_data))
+                list[len++] = sett_conn;
+        }
+    }
+    list[len] = NULL;
+
+    if (len > 1) {
+        g_qsort_with_data(list,
+                          len,
+                          sizeof(NMSettingsConnection *),
+                          nm_settings_connection_cmp_autoconnect_priority_p_with_data,
+                          NULL);
+    }
+
+    NM_SET_OUT(out_len, len);
+    return list;
+}
+
 static void
 impl_settings_list_connections(NMDBusObject                      *obj,
                                const NMDBusInterfaceInfoExtended *interface_info,
@@ -4206,6 +4289,8 @@ nm_settings_init(NMSettings *self)
                                           NULL,
                                           (GDestroyNotify) _sett_conn_entry_free);
 
+    priv->autoconnect_idx = nm_sett_util_ifname_idx_new();
+
     priv->config = g_object_ref(nm_config_get());
 
     priv->agent_mgr = g_object_ref(nm_agent_manager_get());
@@ -4283,6 +4368,9 @@ finalize(GObject *object)
 
     nm_clear_pointer(&priv->sce_idx, g_hash_table_destroy);
 
+    nm_assert(g_hash_table_size(priv->autoconnect_idx) == 0);
+    nm_clear_pointer(&priv->autoconnect_idx, g_hash_table_destroy);
+
     g_slist_free_full(priv->unmanaged_specs, g_free);
     g_slist_free_full(priv->unrecognized_specs, g_free);
 
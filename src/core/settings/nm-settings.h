@@ -92,6 +92,13 @@ NMSettingsConnection **nm_settings_get_connections_clone(NMSettings
                                                          GCompareDataFunc sort_compare_func,
                                                          gpointer         sort_data);
 
+NMSettingsConnection **
+nm_settings_get_connections_for_autoconnect(NMSettings                    *self,
+                                            const char                    *ifname,
+                                            guint                         *out_len,
+                                            NMSettingsConnectionFilterFunc func,
+                                            gpointer                       func_data);
+
 gboolean nm_settings_add_connection(NMSettings                     *settings,
                                     const char                     *plugin,
                                     NMConnection                   *connection,
@@ -0,0 +1,471 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "nms-keyfile-cache.h"
+
+#include "libnm-glib-aux/nm-io-utils.h"
+#include "libnm-core-intern/nm-core-internal.h"
+
+#include "nms-keyfile-reader.h"
+#include "nms-keyfile-utils.h"
+
+/*****************************************************************************/
+
+/* The cache holds the already normalized profiles from the last full load of the
+ * keyfile directories. It is a single serialized GVariant that gets mmap'ed at the
+ * next start. An entry is only used if the file still has the same device, inode,
+ * size, mtime and ctime, otherwise we parse the keyfile as usual.
+ *
+ * The format is versioned together with NetworkManager. Any mismatch in the header,
+ * including the byte order, discards the entire cache. The file must be owned by
+ * root and only accessible by the owner, like keyfiles.
+ *
+ * Secrets are not cached. An entry only records whether the profile has any, and
+ * for such profiles a hit reads the secrets from the keyfile itself. That still
+ * skips the normalization of the profile. */
+
+#define CACHE_FORMAT_VERSION ((guint32) 0x4e4d4b02u)
+
+#define CACHE_ENTRY_TYPE_STRING "(s(ttttttt)iiiisba{sa{sv}})"
+#define CACHE_TYPE_STRING       "(ussa" CACHE_ENTRY_TYPE_STRING ")"
+
+struct _NMSKeyfileCache {
+    char *filename;
+    char *profile_dir;
+
+    /* the entries of the cache file that we loaded. */
+    GVariant   *old_entries;
+    GHashTable *old_idx;
+
+    /* the entries for the next version of the cache file. */
+    GVariantBuilder new_entries;
+    guint           n_new_entries;
+    guint           n_new_from_cache;
+};
+
+/*****************************************************************************/
+
+#define _NMLOG_PREFIX_NAME "keyfile"
+#define _NMLOG_DOMAIN      LOGD_SETTINGS
+#define _NMLOG(level, ...)                          \
+    nm_log((level),                                 \
+           _NMLOG_DOMAIN,                           \
+           NULL,                                    \
+           NULL,                                    \
+           "%s" _NM_UTILS_MACRO_FIRST(__VA_ARGS__), \
+           _NMLOG_PREFIX_NAME ": " _NM_UTILS_MACRO_REST(__VA_ARGS__))
+
+/*****************************************************************************/
+
+static GVariant *
+_stat_to_variant(const struct stat *st)
+{
+    return g_variant_new("(ttttttt)",
+                         (guint64) st->st_dev,
+                         (guint64) st->st_ino,
+                         (guint64) st->st_size,
+                         (guint64) st->st_mtim.tv_sec,
+                         (guint64) st->st_mtim.tv_nsec,
+                         (guint64) st->st_ctim.tv_sec,
+                         (guint64) st->st_ctim.tv_nsec);
+}
+
+static gboolean
+_stat_equal_variant(const struct stat *st, GVariant *v_stat)
+{
+    guint64 v_dev;
+    guint64 v_ino;
+    guint64 v_size;
+    guint64 v_mtime_sec;
+    guint64 v_mtime_nsec;
+    guint64 v_ctime_sec;
+    guint64 v_ctime_nsec;
+
+    g_variant_get(v_stat,
+                  "(ttttttt)",
+                  &v_dev,
+                  &v_ino,
+                  &v_size,
+                  &v_mtime_sec,
+                  &v_mtime_nsec,
+                  &v_ctime_sec,
+                  &v_ctime_nsec);
+
+    return v_dev == (guint64) st->st_dev && v_ino == (guint64) st->st_ino
+           && v_size == (guint64) st->st_size && v_mtime_sec == (guint64) st->st_mtim.tv_sec
+           && v_mtime_nsec == (guint64) st->st_mtim.tv_nsec
+           && v_ctime_sec == (guint64) st->st_ctim.tv_sec
+           && v_ctime_nsec == (guint64) st->st_ctim.tv_nsec;
+}
+
+/*****************************************************************************/
+
+static GVariant *
+_cache_file_load(const char *filename, const char *profile_dir)
+{
+    gs_free_error GError      *error = NULL;
+    gs_unref_variant GVariant *v     = NULL;
+    GMappedFile               *mapped;
+    GBytes                    *bytes;
+    guint32                    format_version;
+    const char                *version;
+    const char                *v_profile_dir;
+    GVariant                  *entries;
+
+    if (!nms_keyfile_utils_check_file_permissions(NMS_KEYFILE_FILETYPE_KEYFILE,
+                                                  filename,
+                                                  NULL,
+                                                  &error)) {
+        _LOGT("cache: ignore \"%s\": %s", filename, error->message);
+        return NULL;
+    }
+
+    mapped = g_mapped_file_new(filename, FALSE, &error);
+    if (!mapped) {
+        _LOGD("cache: cannot map \"%s\": %s", filename, error->message);
+        return NULL;
+    }
+
+    bytes = g_mapped_file_get_bytes(mapped);
+    g_mapped_file_unref(mapped);
+
+    v = g_variant_ref_sink(
+        g_variant_new_from_bytes(G_VARIANT_TYPE(CACHE_TYPE_STRING), bytes, FALSE));
+    g_bytes_unref(bytes);
+
+    g_variant_get(v,
+                  "(u&s&s@a" CACHE_ENTRY_TYPE_STRING ")",
+                  &format_version,
+                  &version,
+                  &v_profile_dir,
+                  &entries);
+
+    if (format_version != CACHE_FORMAT_VERSION || !nm_streq(version, VERSION)
+        || !nm_streq(v_profile_dir, profile_dir ?: "")) {
+        _LOGD("cache: discard \"%s\" from a different version or configuration", filename);
+        g_variant_unref(entries);
+        return NULL;
+    }
+
+    return entries;
+}
+
+/**
+ * nms_keyfile_cache_new:
+ * @filename: the path of the cache file.
+ * @profile_dir: the profile directory, as for nms_keyfile_reader_from_file().
+ *   Profiles in the cache depend on it, so a cache written for a different
+ *   directory is discarded.
+ *
+ * Loads the cache file, if it exists and is valid. The returned
+ * cache can be used to look up profiles, and it collects the profiles for
+ * the next version of the cache file. See nms_keyfile_cache_commit().
+ *
+ * Returns: (transfer full): the new cache.
+ */
+NMSKeyfileCache *
+nms_keyfile_cache_new(const char *filename, const char *profile_dir)
+{
+    NMSKeyfileCache *cache;
+    gsize            n;
+    gsize            i;
+
+    nm_assert(filename && filename[0] == '/');
+    nm_assert(!profile_dir || profile_dir[0] == '/');
+
+    cache  = g_slice_new(NMSKeyfileCache);
+    *cache = (NMSKeyfileCache) {
+        .filename    = g_strdup(filename),
+        .profile_dir = g_strdup(profile_dir),
+    };
+    g_variant_builder_init(&cache->new_entries, G_VARIANT_TYPE("a" CACHE_ENTRY_TYPE_STRING));
+
+    cache->old_entries = _cache_file_load(filename, profile_dir);
+    if (!cache->old_entries)
+        return cache;
+
+    /* the index maps the filename to the position of the entry, offset by one.
+     * The strings point into the mapped file. */
+    n              = g_variant_n_children(cache->old_entries);
+    cache->old_idx = g_hash_table_new(nm_str_hash, g_str_equal);
+    for (i = 0; i < n; i++) {
+        gs_unref_variant GVariant *entry = g_variant_get_child_value(cache->old_entries, i);
+        const char                *full_filename;
+
+        g_variant_get_child(entry, 0, "&s", &full_filename);
+        g_hash_table_insert(cache->old_idx, (char *) full_filename, GSIZE_TO_POINTER(i + 1));
+    }
+
+    _LOGD("cache: loaded %zu profiles from \"%s\"", n, filename);
+    return cache;
+}
+
+void
+nms_keyfile_cache_free(NMSKeyfileCache *cache)
+{
+    if (!cache)
+        return;
+
+    g_variant_builder_clear(&cache->new_entries);
+    nm_clear_pointer(&cache->old_idx, g_hash_table_unref);
+    nm_clear_pointer(&cache->old_entries, g_variant_unref);
+    g_free(cache->filename);
+    g_free(cache->profile_dir);
+    nm_g_slice_free(cache);
+}
+
+/*****************************************************************************/
+
+static GVariant *
+_lookup_entry(const NMSKeyfileCache *cache, const char *full_filename, const struct stat *st)
+{
+    gs_unref_variant GVariant *entry  = NULL;
+    gs_unref_variant GVariant *v_stat = NULL;
+    gpointer                   idx;
+
+    if (!cache->old_idx)
+        return NULL;
+
+    idx = g_hash_table_lookup(cache->old_idx, full_filename);
+    if (!idx)
+        return NULL;
+
+    entry  = g_variant_get_child_value(cache->old_entries, GPOINTER_TO_SIZE(idx) - 1);
+    v_stat = g_variant_get_child_value(entry, 1);
+    if (!_stat_equal_variant(st, v_stat))
+        return NULL;
+
+    return g_steal_pointer(&entry);
+}
+
+static gboolean
+_read_secrets(const NMSKeyfileCache *cache, const char *full_filename, NMConnection *connection)
+{
+    nm_auto_unref_keyfile GKeyFile *key_file     = NULL;
+    gs_unref_object NMConnection   *connection_f = NULL;
+    gs_unref_variant GVariant      *secrets      = NULL;
+    gs_free_error GError           *error        = NULL;
+
+    /* The cache has no secrets. Take them from the keyfile, without normalizing
+     * the profile read from it. */
+    key_file = g_key_file_new();
+    if (!g_key_file_load_from_file(key_file, full_filename, G_KEY_FILE_NONE, &error)
+        || !(connection_f = nms_keyfile_reader_from_keyfile(key_file,
+                                                            full_filename,
+                                                            NULL,
+                                                            cache->profile_dir,
+                                                            FALSE,
+                                                            &error))) {
+        _LOGT("cache: cannot read secrets of \"%s\": %s", full_filename, error->message);
+        return FALSE;
+    }
+
+    secrets = nm_connection_to_dbus(connection_f, NM_CONNECTION_SERIALIZE_WITH_SECRETS);
+    if (!secrets)
+        return TRUE;
+
+    g_variant_ref_sink(secrets);
+    if (!nm_connection_update_secrets(connection, NULL, secrets, &error)) {
+        _LOGT("cache: cannot set secrets of \"%s\": %s", full_filename, error->message);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * nms_keyfile_cache_lookup:
+ * @cache: the cache.
+ * @full_filename: the keyfile to look up.
+ * @st: the current stat of @full_filename. The entry is only
+ *   used, if the file did not change since we wrote the cache.
+ * @out_is_nm_generated: (out) (optional): meta data of the profile.
+ * @out_is_volatile: (out) (optional): meta data of the profile.
+ * @out_is_external: (out) (optional): meta data of the profile.
+ * @out_shadowed_storage: (out) (optional) (transfer full): meta data of the profile.
+ * @out_shadowed_owned: (out) (optional): meta data of the profile.
+ *
+ * Looks up a profile, with the same outputs as nms_keyfile_reader_from_file().
+ * If the profile has secrets, they are read from @full_filename. This function
+ * does not modify @cache and can be called from multiple threads at the same time.
+ *
+ * Returns: (transfer full): the cached profile or %NULL.
+ */
+NMConnection *
+nms_keyfile_cache_lookup(const NMSKeyfileCache *cache,
+                         const char            *full_filename,
+                         const struct stat     *st,
+                         NMTernary             *out_is_nm_generated,
+                         NMTernary             *out_is_volatile,
+                         NMTernary             *out_is_external,
+                         char                 **out_shadowed_storage,
+                         NMTernary             *out_shadowed_owned)
+{
+    gs_unref_variant GVariant    *entry        = NULL;
+    gs_unref_variant GVariant    *v_connection = NULL;
+    gs_unref_object NMConnection *connection   = NULL;
+    gint32                        is_nm_generated;
+    gint32                        is_volatile;
+    gint32                        is_external;
+    gint32                        shadowed_owned;
+    const char                   *shadowed_storage;
+    gboolean                      has_secrets;
+
+    nm_assert(cache);
+    nm_assert(full_filename && full_filename[0] == '/');
+    nm_assert(st);
+
+    entry = _lookup_entry(cache, full_filename, st);
+    if (!entry)
+        return NULL;
+
+    g_variant_get(entry,
+                  "(&s@(ttttttt)iiii&sb@a{sa{sv}})",
+                  NULL,
+                  NULL,
+                  &is_nm_generated,
+                  &is_volatile,
+                  &is_external,
+                  &shadowed_owned,
+                  &shadowed_storage,
+                  &has_secrets,
+                  &v_connection);
+
+    connection =
+        _nm_simple_connection_new_from_dbus(v_connection, NM_SETTING_PARSE_FLAGS_STRICT, NULL);
+    if (!connection)
+        return NULL;
+
+    if (has_secrets && !_read_secrets(cache, full_filename, connection))
+        return NULL;
+
+    /* The profile was normalized when we wrote it. We skip normalization, but
+     * verifying the profile is cheap compared to parsing the keyfile. Don't use
+     * an entry that somehow didn't survive the round trip. */
+    if (_nm_connection_verify(connection, NULL) != NM_SETTING_VERIFY_SUCCESS)
+        return NULL;
+
+    NM_SET_OUT(out_is_nm_generated, is_nm_generated);
+    NM_SET_OUT(out_is_volatile, is_volatile);
+    NM_SET_OUT(out_is_external, is_external);
+    NM_SET_OUT(out_shadowed_storage, shadowed_storage[0] ? g_strdup(shadowed_storage) : NULL);
+    NM_SET_OUT(out_shadowed_owned, shadowed_owned);
+
+    return g_steal_pointer(&connection);
+}
+
+/**
+ * nms_keyfile_cache_add:
+ * @cache: the cache.
+ * @full_filename: the keyfile.
+ * @st: the stat of @full_filename when it was read.
+ * @connection: the normalized profile.
+ * @is_nm_generated: meta data of the profile.
+ * @is_volatile: meta data of the profile.
+ * @is_external: meta data of the profile.
+ * @shadowed_storage: meta data of the profile.
+ * @shadowed_owned: meta data of the profile.
+ * @from_cache: whether the profile was returned by nms_keyfile_cache_lookup().
+ *   In that case, the existing entry is reused.
+ *
+ * Adds the profile for the next version of the cache file. Must be
+ * called on the main thread.
+ */
+void
+nms_keyfile_cache_add(NMSKeyfileCache   *cache,
+                      const char        *full_filename,
+                      const struct stat *st,
+                      NMConnection      *connection,
+                      NMTernary          is_nm_generated,
+                      NMTernary          is_volatile,
+                      NMTernary          is_external,
+                      const char        *shadowed_storage,
+                      NMTernary          shadowed_owned,
+                      gboolean           from_cache)
+{
+    nm_assert(cache);
+    nm_assert(full_filename && full_filename[0] == '/');
+    nm_assert(st);
+    nm_assert(NM_IS_CONNECTION(connection));
+
+    cache->n_new_entries++;
+
+    if (from_cache) {
+        gs_unref_variant GVariant *entry = NULL;
+
+        entry = _lookup_entry(cache, full_filename, st);
+        if (entry) {
+            cache->n_new_from_cache++;
+            g_variant_builder_add_value(&cache->new_entries, entry);
+            return;
+        }
+    }
+
+    g_variant_builder_add(&cache->new_entries,
+                          "(s@(ttttttt)iiiisb@a{sa{sv}})",
+                          full_filename,
+                          _stat_to_variant(st),
+                          (gint32) is_nm_generated,
+                          (gint32) is_volatile,
+                          (gint32) is_external,
+                          (gint32) shadowed_owned,
+                          shadowed_storage ?: "",
+                          _nm_connection_aggregate(connection,
+                                                   NM_CONNECTION_AGGREGATE_ANY_SECRETS,
+                                                   NULL),
+                          nm_connection_to_dbus(connection,
+                                                NM_CONNECTION_SERIALIZE_WITH_NON_SECRET));
+}
+
+/**
+ * nms_keyfile_cache_commit:
+ * @cache: the cache.
+ * @error: the failure reason.
+ *
+ * Writes the profiles added with nms_keyfile_cache_add()
+ * to the cache file. If all of them came from the cache and no profile was removed,
+ * the file is left unchanged. Afterwards, the cache can no longer be used.
+ *
+ * Returns: %FALSE if writing the file failed.
+ */
+gboolean
+nms_keyfile_cache_commit(NMSKeyfileCache *cache, GError **error)
+{
+    gs_unref_variant GVariant *v = NULL;
+    gsize                      n_old_entries;
+
+    nm_assert(cache);
+
+    n_old_entries = cache->old_entries ? g_variant_n_children(cache->old_entries) : 0u;
+
+    if (cache->n_new_from_cache == cache->n_new_entries && cache->n_new_entries == n_old_entries
+        && cache->old_entries) {
+        g_variant_builder_clear(&cache->new_entries);
+        return TRUE;
+    }
+
+    v = g_variant_ref_sink(g_variant_new("(uss@a" CACHE_ENTRY_TYPE_STRING ")",
+                                         CACHE_FORMAT_VERSION,
+                                         VERSION,
+                                         cache->profile_dir ?: "",
+                                         g_variant_builder_end(&cache->new_entries)));
+
+    /* the old entries may still point into the file that we are about to replace.
+     * nm_utils_file_set_contents() writes a new file and renames it, so the mapping
+     * stays valid. */
+    if (!nm_utils_file_set_contents(cache->filename,
+                                    g_variant_get_data(v),
+                                    g_variant_get_size(v),
+                                    0600,
+                                    NULL,
+                                    NULL,
+                                    error))
+        return FALSE;
+
+    _LOGD("cache: wrote %u profiles to \"%s\" (%u reused)",
+          cache->n_new_entries,
+          cache->filename,
+          cache->n_new_from_cache);
+    return TRUE;
+}
@@ -33,6 +33,7 @@
 #include "nms-keyfile-storage.h"
 #include "nms-keyfile-writer.h"
 #include "nms-keyfile-reader.h"
+#include "nms-keyfile-cache.h"
 #include "nms-keyfile-utils.h"
 
 /*****************************************************************************/
@@ -418,38 +419,122 @@ _load_file_from_path(NMSKeyfilePlugin     *self,
     return _load_file(self, f_dirname, f_filename, storage_type, error);
 }
 
+static NMSKeyfileStorage *
+_load_file_from_data(NMSKeyfilePlugin         *self,
+                     NMSKeyfileReaderFileData *file_data,
+                     NMSKeyfileStorageType     storage_type,
+                     NMSKeyfileCache          *cache)
+{
+    if (!file_data->connection) {
+        _LOGW("load: \"%s\": failed to load connection: %s",
+              file_data->full_filename,
+              file_data->error->message);
+        return NULL;
+    }
+
+    nm_assert(_nm_connection_verify(file_data->connection, NULL) == NM_SETTING_VERIFY_SUCCESS);
+    nm_assert(nm_uuid_is_normalized(nm_connection_get_uuid(file_data->connection)));
+
+    if (cache) {
+        nms_keyfile_cache_add(cache,
+                              file_data->full_filename,
+                              &file_data->st,
+                              file_data->connection,
+                              file_data->is_nm_generated,
+                              file_data->is_volatile,
+                              file_data->is_external,
+                              file_data->shadowed_storage,
+                              file_data->shadowed_owned,
+                              file_data->from_cache);
+    }
+
+    return nms_keyfile_storage_new_connection(self,
+                                              g_steal_pointer(&file_data->connection),
+                                              file_data->full_filename,
+                                              storage_type,
+                                              file_data->is_nm_generated,
+                                              file_data->is_volatile,
+                                              file_data->is_external,
+                                              file_data->shadowed_storage,
+                                              file_data->shadowed_owned,
+                                              &file_data->st.st_mtim);
+}
+
 static void
 _load_dir(NMSKeyfilePlugin     *self,
           NMSKeyfileStorageType storage_type,
           const char           *dirname,
-          NMSettUtilStorages   *storages)
+          NMSettUtilStorages   *storages,
+          NMSKeyfileCache      *cache)
 {
-    const char                    *filename;
-    GDir                          *dir;
-    gs_unref_hashtable GHashTable *dupl_filenames = NULL;
+    NMSKeyfilePluginPrivate          *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+    const char                       *filename;
+    GDir                             *dir;
+    gs_unref_hashtable GHashTable    *dupl_filenames = NULL;
+    gs_unref_ptrarray GPtrArray      *filenames      = NULL;
+    gs_unref_ptrarray GPtrArray      *full_filenames = NULL;
+    gs_free NMSKeyfileReaderFileData *files          = NULL;
+    guint                             n_files        = 0;
+    guint                             i_file;
+    guint                             i;
 
     dir = g_dir_open(dirname, 0, NULL);
     if (!dir)
         return;
 
     dupl_filenames = g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, g_free);
+    filenames      = g_ptr_array_new();
 
     while ((filename = g_dir_read_name(dir))) {
-        gs_unref_object NMSKeyfileStorage *storage = NULL;
-
         filename = g_strdup(filename);
         if (!g_hash_table_add(dupl_filenames, (char *) filename))
             continue;
 
-        storage = _load_file(self, dirname, filename, storage_type, NULL);
+        g_ptr_array_add(filenames, (char *) filename);
+        if (!_ignore_filename(storage_type, filename))
+            n_files++;
+    }
+
+    g_dir_close(dir);
+
+    /* Parsing the keyfiles is the expensive part, and with many profiles it
+     * dominates the startup time. Read them all at once, which spreads the work
+     * over worker threads. Afterwards, create the storages here on the main thread
+     * in the order of the directory listing, as we did when loading them one by one. */
+    files          = g_new0(NMSKeyfileReaderFileData, n_files);
+    full_filenames = g_ptr_array_new_full(n_files, g_free);
+    for (i = 0, i_file = 0; i < filenames->len; i++) {
+        char *full_filename;
+
+        filename = filenames->pdata[i];
+        if (_ignore_filename(storage_type, filename))
+            continue;
+
+        full_filename = g_build_filename(dirname, filename, NULL);
+        g_ptr_array_add(full_filenames, full_filename);
+        files[i_file++].full_filename = full_filename;
+    }
+    nm_assert(i_file == n_files);
+
+    nms_keyfile_reader_from_files(files, n_files, _get_plugin_dir(priv), cache, 0);
+
+    for (i = 0, i_file = 0; i < filenames->len; i++) {
+        gs_unref_object NMSKeyfileStorage *storage = NULL;
+
+        filename = filenames->pdata[i];
+        if (_ignore_filename(storage_type, filename))
+            storage = _load_file(self, dirname, filename, storage_type, NULL);
+        else {
+            storage = _load_file_from_data(self, &files[i_file], storage_type, cache);
+            nms_keyfile_reader_file_data_clear(&files[i_file]);
+            i_file++;
+        }
         if (!storage)
             continue;
 
         nm_sett_util_storages_add_take(storages, g_steal_pointer(&storage));
     }
 
-    g_dir_close(dir);
-
 #if NM_MORE_ASSERTS
     {
         NMSKeyfileStorage *storage;
@@ -582,13 +667,30 @@ reload_connections(NMSettingsPlugin                      *plugin,
     NMSKeyfilePluginPrivate                            *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
     nm_auto_clear_sett_util_storages NMSettUtilStorages storages_new =
         NM_SETT_UTIL_STORAGES_INIT(storages_new, nms_keyfile_storage_destroy);
-    int i;
-
-    _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_RUN, priv->dirname_run, &storages_new);
+    nm_auto_free_keyfile_cache NMSKeyfileCache *cache = NULL;
+    gs_free_error GError                       *error = NULL;
+    int                                         i;
+
+    /* Most profiles don't change between two starts of the daemon. Use the
+     * cache from the last full load to skip parsing them. */
+    if (!nm_utils_get_testing())
+        cache = nms_keyfile_cache_new(NMS_KEYFILE_CACHE_FILENAME, _get_plugin_dir(priv));
+
+    /* Profiles in /run are gone after a reboot and are usually written by
+     * NetworkManager itself, shortly before they get loaded. Don't cache them. */
+    _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_RUN, priv->dirname_run, &storages_new, NULL);
     if (priv->dirname_etc)
-        _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_ETC, priv->dirname_etc, &storages_new);
-    for (i = 0; priv->dirname_libs[i]; i++)
-        _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_LIB(i), priv->dirname_libs[i], &storages_new);
+        _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_ETC, priv->dirname_etc, &storages_new, cache);
+    for (i = 0; priv->dirname_libs[i]; i++) {
+        _load_dir(self,
+                  NMS_KEYFILE_STORAGE_TYPE_LIB(i),
+                  priv->dirname_libs[i],
+                  &storages_new,
+                  cache);
+    }
+
+    if (cache && !nms_keyfile_cache_commit(cache, &error))
+        _LOGD("cache: failure to write \"%s\": %s", NMS_KEYFILE_CACHE_FILENAME, error->message);
 
     _storages_consolidate(self, &storages_new, TRUE, NULL, callback, user_data);
 }
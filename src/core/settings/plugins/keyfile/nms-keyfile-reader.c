@@ -12,10 +12,38 @@
 #include "libnm-core-intern/nm-keyfile-internal.h"
 
 #include "NetworkManagerUtils.h"
+#include "nms-keyfile-cache.h"
 #include "nms-keyfile-utils.h"
 
 /*****************************************************************************/
 
+/* nms_keyfile_reader_from_files() reads keyfiles on worker threads. What runs
+ * on a worker is _file_data_read():
+ *
+ *  - checking the permissions, stat() and loading the GKeyFile. This is only
+ *    file I/O and GLib, on objects owned by the worker.
+ *
+ *  - nm_keyfile_read(), which creates a new NMConnection and its settings from
+ *    the GKeyFile. Each connection is only accessed by the worker that creates
+ *    it, until g_thread_pool_free() waited for all workers. The setting types
+ *    get registered and their classes initialized by GObject, which is
+ *    thread-safe. The meta data of the settings and of the keyfile format are
+ *    static const tables.
+ *
+ *  - nms_keyfile_cache_lookup(), which only reads the cache, see there.
+ *
+ *  - logging the warnings of the reader. nm-logging takes a lock when not on
+ *    the main thread, which we request by setting NM_THREAD_SAFE_ON_MAIN_THREAD
+ *    to zero.
+ *
+ * Normalizing the profiles is not part of that. It touches much more code,
+ * including parts that look at global state. It happens after all workers
+ * finished, on the calling thread. */
+#undef NM_THREAD_SAFE_ON_MAIN_THREAD
+#define NM_THREAD_SAFE_ON_MAIN_THREAD 0
+
+/*****************************************************************************/
+
 static const char *
 _fmt_warn(const NMKeyfileHandlerData *handler_data, char **out_message)
 {
@@ -153,20 +181,36 @@ nms_keyfile_reader_from_keyfile(GKeyFile   *key_file,
     return connection;
 }
 
-NMConnection *
-nms_keyfile_reader_from_file(const char  *full_filename,
-                             const char  *profile_dir,
-                             struct stat *out_stat,
-                             NMTernary   *out_is_nm_generated,
-                             NMTernary   *out_is_volatile,
-                             NMTernary   *out_is_external,
-                             char       **out_shadowed_storage,
-                             NMTernary   *out_shadowed_owned,
-                             GError     **error)
+static gboolean
+_normalize(NMConnection *connection, GError **error)
+{
+    gs_free_error GError *verify_error = NULL;
+
+    if (!nm_connection_normalize(connection, NULL, NULL, &verify_error)) {
+        g_set_error(error,
+                    NM_SETTINGS_ERROR,
+                    NM_SETTINGS_ERROR_INVALID_CONNECTION,
+                    "invalid connection: %s",
+                    verify_error->message);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* Like nms_keyfile_reader_from_file(), but does not normalize the profile. */
+static NMConnection *
+_read_file(const char  *full_filename,
+           const char  *profile_dir,
+           struct stat *out_stat,
+           NMTernary   *out_is_nm_generated,
+           NMTernary   *out_is_volatile,
+           NMTernary   *out_is_external,
+           char       **out_shadowed_storage,
+           NMTernary   *out_shadowed_owned,
+           GError     **error)
 {
-    nm_auto_unref_keyfile GKeyFile *key_file     = NULL;
-    NMConnection                   *connection   = NULL;
-    GError                         *verify_error = NULL;
+    nm_auto_unref_keyfile GKeyFile *key_file   = NULL;
+    NMConnection                   *connection = NULL;
 
     nm_assert(full_filename && full_filename[0] == '/');
     nm_assert(!profile_dir || profile_dir[0] == '/');
@@ -191,18 +235,6 @@ nms_keyfile_reader_from_file(const char  *full_filename,
     if (!connection)
         return NULL;
 
-    /* Normalize and verify the connection */
-    if (!nm_connection_normalize(connection, NULL, NULL, &verify_error)) {
-        g_set_error(error,
-                    NM_SETTINGS_ERROR,
-                    NM_SETTINGS_ERROR_INVALID_CONNECTION,
-                    "invalid connection: %s",
-                    verify_error->message);
-        g_clear_error(&verify_error);
-        g_object_unref(connection);
-        connection = NULL;
-    }
-
     NM_SET_OUT(out_is_nm_generated,
                nm_key_file_get_boolean(key_file,
                                        NM_KEYFILE_GROUP_NMMETA,
@@ -235,3 +267,185 @@ nms_keyfile_reader_from_file(const char  *full_filename,
 
     return connection;
 }
+
+NMConnection *
+nms_keyfile_reader_from_file(const char  *full_filename,
+                             const char  *profile_dir,
+                             struct stat *out_stat,
+                             NMTernary   *out_is_nm_generated,
+                             NMTernary   *out_is_volatile,
+                             NMTernary   *out_is_external,
+                             char       **out_shadowed_storage,
+                             NMTernary   *out_shadowed_owned,
+                             GError     **error)
+{
+    gs_unref_object NMConnection *connection = NULL;
+
+    connection = _read_file(full_filename,
+                            profile_dir,
+                            out_stat,
+                            out_is_nm_generated,
+                            out_is_volatile,
+                            out_is_external,
+                            out_shadowed_storage,
+                            out_shadowed_owned,
+                            error);
+    if (!connection)
+        return NULL;
+
+    /* Normalize and verify the connection */
+    if (!_normalize(connection, error))
+        return NULL;
+
+    return g_steal_pointer(&connection);
+}
+
+/*****************************************************************************/
+
+/* Below this number of files, the overhead of spawning threads is not worth it. */
+#define READ_FILES_PARALLEL_MIN 64u
+
+#define READ_FILES_THREADS_MAX 8u
+
+typedef struct {
+    const char            *profile_dir;
+    const NMSKeyfileCache *cache;
+} ReadFilesData;
+
+static void
+_file_data_read(NMSKeyfileReaderFileData *file_data, const ReadFilesData *read_data)
+{
+    nm_assert(file_data);
+    nm_assert(file_data->full_filename && file_data->full_filename[0] == '/');
+    nm_assert(!file_data->connection);
+    nm_assert(!file_data->error);
+
+    if (read_data->cache) {
+        if (!nms_keyfile_utils_check_file_permissions(NMS_KEYFILE_FILETYPE_KEYFILE,
+                                                      file_data->full_filename,
+                                                      &file_data->st,
+                                                      &file_data->error))
+            return;
+
+        file_data->connection = nms_keyfile_cache_lookup(read_data->cache,
+                                                         file_data->full_filename,
+                                                         &file_data->st,
+                                                         &file_data->is_nm_generated,
+                                                         &file_data->is_volatile,
+                                                         &file_data->is_external,
+                                                         &file_data->shadowed_storage,
+                                                         &file_data->shadowed_owned);
+        if (file_data->connection) {
+            file_data->from_cache = TRUE;
+            return;
+        }
+    }
+
+    file_data->connection = _read_file(file_data->full_filename,
+                                       read_data->profile_dir,
+                                       &file_data->st,
+                                       &file_data->is_nm_generated,
+                                       &file_data->is_volatile,
+                                       &file_data->is_external,
+                                       &file_data->shadowed_storage,
+                                       &file_data->shadowed_owned,
+                                       &file_data->error);
+    nm_assert(!!file_data->connection != !!file_data->error);
+}
+
+static void
+_file_data_normalize(NMSKeyfileReaderFileData *file_data)
+{
+    /* Profiles from the cache were normalized when they were added. */
+    if (!file_data->connection || file_data->from_cache)
+        return;
+
+    if (!_normalize(file_data->connection, &file_data->error))
+        g_clear_object(&file_data->connection);
+}
+
+static void
+_file_data_read_thread_func(gpointer data, gpointer user_data)
+{
+    _file_data_read(data, user_data);
+}
+
+/**
+ * nms_keyfile_reader_from_files:
+ * @files: the array of files to read. For each entry, the
+ *   "full_filename" must be set and all other fields are
+ *   output arguments. The caller must release them with
+ *   nms_keyfile_reader_file_data_clear().
+ * @n_files: the number of entries in @files.
+ * @profile_dir: the profile directory, as for nms_keyfile_reader_from_file().
+ * @cache: (nullable): if given, unchanged files are taken from the cache
+ *   instead of parsing them.
+ * @n_threads: the maximum number of threads to use. Set to
+ *   zero to pick a number based on the available CPUs and
+ *   the number of files. Set to one to read all files on
+ *   the calling thread.
+ *
+ * Reads and parses a set of keyfiles. Parsing a large number of
+ * profiles is CPU bound, so this spreads the work over a pool of
+ * worker threads. The profiles are then normalized on the calling
+ * thread. The function returns after all files are read, and the
+ * results are at the same position in @files as their file names.
+ * The caller can therefore process them in a deterministic order,
+ * and the results are the same regardless of the number of threads.
+ */
+void
+nms_keyfile_reader_from_files(NMSKeyfileReaderFileData *files,
+                              guint                     n_files,
+                              const char               *profile_dir,
+                              const NMSKeyfileCache    *cache,
+                              guint                     n_threads)
+{
+    const ReadFilesData read_data = {
+        .profile_dir = profile_dir,
+        .cache       = cache,
+    };
+    GThreadPool        *pool;
+    guint               i;
+
+    nm_assert(files || n_files == 0);
+    nm_assert(!profile_dir || profile_dir[0] == '/');
+
+    if (n_threads == 0) {
+        if (n_files >= READ_FILES_PARALLEL_MIN)
+            n_threads = NM_MIN(g_get_num_processors(), READ_FILES_THREADS_MAX);
+        else
+            n_threads = 1;
+    }
+    n_threads = NM_MIN(n_threads, n_files);
+
+    if (n_threads <= 1) {
+        for (i = 0; i < n_files; i++)
+            _file_data_read(&files[i], &read_data);
+    } else {
+        pool = g_thread_pool_new(_file_data_read_thread_func,
+                                 (gpointer) &read_data,
+                                 n_threads,
+                                 FALSE,
+                                 NULL);
+
+        for (i = 0; i < n_files; i++)
+            g_thread_pool_push(pool, &files[i], NULL);
+
+        /* wait for all pushed tasks to complete. */
+        g_thread_pool_free(pool, FALSE, TRUE);
+    }
+
+    for (i = 0; i < n_files; i++)
+        _file_data_normalize(&files[i]);
+}
+
+void
+nms_keyfile_reader_file_data_clear(NMSKeyfileReaderFileData *file_data)
+{
+    nm_assert(file_data);
+
+    g_clear_object(&file_data->connection);
+    g_clear_error(&file_data->error);
+    nm_clear_g_free(&file_data->shadowed_storage);
+    file_data->from_cache = FALSE;
+}
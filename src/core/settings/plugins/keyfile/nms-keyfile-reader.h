@@ -7,7 +7,10 @@
 #ifndef __NMS_KEYFILE_READER_H__
 #define __NMS_KEYFILE_READER_H__
 
+#include <sys/stat.h>
+
 #include "nm-connection.h"
+#include "nms-keyfile-cache.h"
 
 NMConnection *nms_keyfile_reader_from_keyfile(GKeyFile   *key_file,
                                               const char *filename,
@@ -16,8 +19,6 @@ NMConnection *nms_keyfile_reader_from_keyfile(GKeyFile   *key_file,
                                               gboolean    verbose,
                                               GError    **error);
 
-struct stat;
-
 NMConnection *nms_keyfile_reader_from_file(const char  *full_filename,
                                            const char  *profile_dir,
                                            struct stat *out_stat,
@@ -28,4 +29,25 @@ NMConnection *nms_keyfile_reader_from_file(const char  *full_filename,
                                            NMTernary   *out_shadowed_owned,
                                            GError     **error);
 
+typedef struct {
+    const char   *full_filename;
+    NMConnection *connection;
+    GError       *error;
+    char         *shadowed_storage;
+    struct stat   st;
+    NMTernary     is_nm_generated;
+    NMTernary     is_volatile;
+    NMTernary     is_external;
+    NMTernary     shadowed_owned;
+    bool          from_cache : 1;
+} NMSKeyfileReaderFileData;
+
+void nms_keyfile_reader_from_files(NMSKeyfileReaderFileData *files,
+                                   guint                     n_files,
+                                   const char               *profile_dir,
+                                   const NMSKeyfileCache    *cache,
+                                   guint                     n_threads);
+
+void nms_keyfile_reader_file_data_clear(NMSKeyfileReaderFileData *file_data);
+
 #endif /* __NMS_KEYFILE_READER_H__ */
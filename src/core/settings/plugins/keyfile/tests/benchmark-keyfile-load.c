@@ -0,0 +1,248 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+#include "libnm-glib-aux/nm-time-utils.h"
+#include "libnm-glib-aux/nm-uuid.h"
+
+#include "settings/plugins/keyfile/nms-keyfile-cache.h"
+#include "settings/plugins/keyfile/nms-keyfile-reader.h"
+
+#include "nm-test-utils-core.h"
+
+/* Writes a directory of generated keyfiles and reports how long it takes to
+ * read them back: on the calling thread, spread over worker threads as during
+ * startup, and from the profile cache. Run it via "meson test --benchmark". */
+
+NMTST_DEFINE();
+
+static struct {
+    int n_profiles;
+    int n_threads;
+} global_opt = {
+    .n_profiles = 0,
+    .n_threads  = 0,
+};
+
+/*****************************************************************************/
+
+static char *
+_profile_contents(guint idx)
+{
+    char uuid[NM_UUID_STR_LEN];
+
+    return g_strdup_printf("[connection]\n"
+                           "id=bench-%u\n"
+                           "uuid=%s\n"
+                           "type=ethernet\n"
+                           "interface-name=eth%u\n"
+                           "autoconnect=false\n"
+                           "\n"
+                           "[ethernet]\n"
+                           "mtu=1400\n"
+                           "\n"
+                           "[ipv4]\n"
+                           "method=manual\n"
+                           "address1=10.%u.%u.%u/16,10.%u.0.1\n"
+                           "dns=192.168.1.1;192.168.1.2;\n"
+                           "route1=172.16.%u.0/24,10.%u.0.254,100\n"
+                           "\n"
+                           "[ipv6]\n"
+                           "method=auto\n"
+                           "addr-gen-mode=stable-privacy\n",
+                           idx,
+                           nm_uuid_generate_random_str_arr(uuid),
+                           idx % 1000u,
+                           (idx >> 16) & 0xFFu,
+                           (idx >> 8) & 0xFFu,
+                           (idx & 0xFFu) ?: 1u,
+                           (idx >> 16) & 0xFFu,
+                           idx & 0xFFu,
+                           (idx >> 16) & 0xFFu);
+}
+
+static GPtrArray *
+_profiles_write(const char *dirname, guint n_profiles)
+{
+    GPtrArray *full_filenames;
+    guint      i;
+
+    full_filenames = g_ptr_array_new_full(n_profiles, g_free);
+
+    for (i = 0; i < n_profiles; i++) {
+        gs_free_error GError *error    = NULL;
+        gs_free char         *contents = NULL;
+        char                 *full_filename;
+
+        full_filename = g_strdup_printf("%s/bench-%u.nmconnection", dirname, i);
+        contents      = _profile_contents(i);
+        if (!g_file_set_contents(full_filename, contents, -1, &error))
+            g_error("failed to write %s: %s", full_filename, error->message);
+        if (chmod(full_filename, 0600) != 0)
+            g_error("failed to chmod %s: %s", full_filename, nm_strerror_native(errno));
+        g_ptr_array_add(full_filenames, full_filename);
+    }
+
+    return full_filenames;
+}
+
+static void
+_profiles_read(GPtrArray       *full_filenames,
+               const char      *what,
+               guint            n_threads,
+               NMSKeyfileCache *cache)
+{
+    gs_free NMSKeyfileReaderFileData *files = NULL;
+    struct rusage                     ru    = {};
+    gint64                            start_nsec;
+    gint64                            now_nsec;
+    guint                             i;
+
+    files = g_new0(NMSKeyfileReaderFileData, full_filenames->len);
+    for (i = 0; i < full_filenames->len; i++)
+        files[i].full_filename = full_filenames->pdata[i];
+
+    start_nsec = nm_utils_clock_gettime_nsec(CLOCK_MONOTONIC);
+    nms_keyfile_reader_from_files(files, full_filenames->len, NULL, cache, n_threads);
+    now_nsec = nm_utils_clock_gettime_nsec(CLOCK_MONOTONIC);
+
+    getrusage(RUSAGE_SELF, &ru);
+
+    g_print("%8u profiles %-8s %10.1f ms total %10.1f us/profile %10ld KiB peak-rss\n",
+            full_filenames->len,
+            what,
+            ((double) (now_nsec - start_nsec)) / NM_UTILS_NSEC_PER_MSEC,
+            full_filenames->len > 0
+                ? ((double) (now_nsec - start_nsec)) / 1000 / full_filenames->len
+                : 0.0,
+            ru.ru_maxrss);
+
+    for (i = 0; i < full_filenames->len; i++) {
+        if (!files[i].connection)
+            g_error("failed to read %s: %s", files[i].full_filename, files[i].error->message);
+        if (cache) {
+            nms_keyfile_cache_add(cache,
+                                  files[i].full_filename,
+                                  &files[i].st,
+                                  files[i].connection,
+                                  files[i].is_nm_generated,
+                                  files[i].is_volatile,
+                                  files[i].is_external,
+                                  files[i].shadowed_storage,
+                                  files[i].shadowed_owned,
+                                  files[i].from_cache);
+        }
+        nms_keyfile_reader_file_data_clear(&files[i]);
+    }
+}
+
+static void
+bench_load(guint n_profiles)
+{
+    gs_free_error GError        *error          = NULL;
+    gs_unref_ptrarray GPtrArray *full_filenames = NULL;
+    gs_free char                *dirname        = NULL;
+    gs_free char                *cache_filename = NULL;
+    NMSKeyfileCache             *cache;
+    guint                        i;
+
+    dirname = g_dir_make_tmp("nm-benchmark-keyfile-XXXXXX", &error);
+    if (!dirname)
+        g_error("failed to create temporary directory: %s", error->message);
+
+    full_filenames = _profiles_write(dirname, n_profiles);
+
+    _profiles_read(full_filenames, "serial", 1, NULL);
+    _profiles_read(full_filenames, "parallel", global_opt.n_threads, NULL);
+
+    /* the first run with the cache populates it, the second one uses it. */
+    cache_filename = g_strdup_printf("%s/cache", dirname);
+    cache          = nms_keyfile_cache_new(cache_filename, NULL);
+    _profiles_read(full_filenames, "uncached", global_opt.n_threads, cache);
+    if (!nms_keyfile_cache_commit(cache, &error))
+        g_error("failed to write cache %s: %s", cache_filename, error->message);
+    nms_keyfile_cache_free(cache);
+
+    cache = nms_keyfile_cache_new(cache_filename, NULL);
+    _profiles_read(full_filenames, "cached", global_opt.n_threads, cache);
+    nms_keyfile_cache_free(cache);
+
+    for (i = 0; i < full_filenames->len; i++)
+        unlink(full_filenames->pdata[i]);
+    unlink(cache_filename);
+    rmdir(dirname);
+}
+
+/*****************************************************************************/
+
+static gboolean
+read_argv(int *argc, char ***argv)
+{
+    GOptionContext *context;
+    GOptionEntry    options[] = {
+        {"profiles",
+            'p',
+            0,
+            G_OPTION_ARG_INT,
+            &global_opt.n_profiles,
+            "Number of profiles (default: 1000, 10000 and 50000)",
+            "N"},
+        {"threads",
+            't',
+            0,
+            G_OPTION_ARG_INT,
+            &global_opt.n_threads,
+            "Number of threads for the parallel run (default: automatic)",
+            "N"},
+        {0},
+    };
+    gs_free_error GError *error = NULL;
+
+    context = g_option_context_new(NULL);
+    g_option_context_set_summary(context, "Benchmark reading keyfile profiles at startup.");
+    g_option_context_add_main_entries(context, options, NULL);
+
+    if (!g_option_context_parse(context, argc, argv, &error)) {
+        g_warning("Error parsing command line arguments: %s", error->message);
+        g_option_context_free(context);
+        return FALSE;
+    }
+
+    g_option_context_free(context);
+
+    if (global_opt.n_profiles < 0 || global_opt.n_profiles > 1000000 || global_opt.n_threads < 0
+        || global_opt.n_threads > 256) {
+        g_warning("Invalid number of profiles or threads");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+int
+main(int argc, char **argv)
+{
+    static const guint n_profiles_default[] = {
+        1000,
+        10000,
+        50000,
+    };
+    guint i;
+
+    nmtst_init_with_logging(&argc, &argv, "WARN", "DEFAULT");
+
+    if (!read_argv(&argc, &argv))
+        return 2;
+
+    if (global_opt.n_profiles > 0)
+        bench_load(global_opt.n_profiles);
+    else {
+        for (i = 0; i < G_N_ELEMENTS(n_profiles_default); i++)
+            bench_load(n_profiles_default[i]);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -16,8 +16,10 @@
 #include <linux/if_infiniband.h>
 
 #include "libnm-glib-aux/nm-uuid.h"
+#include "libnm-glib-aux/nm-io-utils.h"
 #include "libnm-core-intern/nm-core-internal.h"
 
+#include "settings/plugins/keyfile/nms-keyfile-cache.h"
 #include "settings/plugins/keyfile/nms-keyfile-reader.h"
 #include "settings/plugins/keyfile/nms-keyfile-writer.h"
 #include "settings/plugins/keyfile/nms-keyfile-utils.h"
@@ -2905,6 +2907,298 @@ test_nmmeta(void)
 
 /*****************************************************************************/
 
+#define KEYFILE_CACHE_PSK "s3cu4e passphrase"
+
+static NMConnection *
+_keyfile_cache_lookup(const char *cache_filename, const char *full_filename, const struct stat *st)
+{
+    nm_auto_free_keyfile_cache NMSKeyfileCache *cache = NULL;
+
+    cache = nms_keyfile_cache_new(cache_filename, NULL);
+    return nms_keyfile_cache_lookup(cache, full_filename, st, NULL, NULL, NULL, NULL, NULL);
+}
+
+static void
+test_keyfile_cache(void)
+{
+    const char *const full_filename  = TEST_SCRATCH_DIR "/Test_Keyfile_Cache.nmconnection";
+    const char *const cache_filename = TEST_SCRATCH_DIR "/keyfile-cache";
+    const char *const keyfile        = "[connection]\n"
+                                       "id=Test Keyfile Cache\n"
+                                       "uuid=0e3d6a7b-2b6a-4d2f-9a1c-6f0c6d2a9e51\n"
+                                       "type=wifi\n"
+                                       "\n"
+                                       "[wifi]\n"
+                                       "ssid=foobar\n"
+                                       "\n"
+                                       "[wifi-security]\n"
+                                       "key-mgmt=wpa-psk\n"
+                                       "psk=" KEYFILE_CACHE_PSK "\n";
+    nm_auto_free_keyfile_cache NMSKeyfileCache *cache      = NULL;
+    gs_unref_object NMConnection               *connection = NULL;
+    gs_unref_object NMConnection               *cached     = NULL;
+    gs_free_error GError                       *error      = NULL;
+    gs_free char                               *contents   = NULL;
+    gsize                                       len;
+    struct stat                                 st;
+    struct stat                                 st2;
+    gboolean                                    success;
+
+    (void) unlink(cache_filename);
+
+    success = nm_utils_file_set_contents(full_filename, keyfile, -1, 0600, NULL, NULL, &error);
+    nmtst_assert_success(success, error);
+
+    connection = nms_keyfile_reader_from_file(full_filename,
+                                              NULL,
+                                              &st,
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              &error);
+    nmtst_assert_success(connection, error);
+
+    /* Without a cache file, nothing is found. */
+    cache = nms_keyfile_cache_new(cache_filename, NULL);
+    g_assert(!nms_keyfile_cache_lookup(cache, full_filename, &st, NULL, NULL, NULL, NULL, NULL));
+    nms_keyfile_cache_add(cache,
+                          full_filename,
+                          &st,
+                          connection,
+                          NM_TERNARY_DEFAULT,
+                          NM_TERNARY_DEFAULT,
+                          NM_TERNARY_DEFAULT,
+                          NULL,
+                          NM_TERNARY_DEFAULT,
+                          FALSE);
+    success = nms_keyfile_cache_commit(cache, &error);
+    nmtst_assert_success(success, error);
+    nm_clear_pointer(&cache, nms_keyfile_cache_free);
+
+    /* The cache file has no secrets... */
+    success = g_file_get_contents(cache_filename, &contents, &len, &error);
+    nmtst_assert_success(success, error);
+    g_assert(!memmem(contents, len, KEYFILE_CACHE_PSK, NM_STRLEN(KEYFILE_CACHE_PSK)));
+
+    /* ...but a hit has them, read from the keyfile. */
+    cached = _keyfile_cache_lookup(cache_filename, full_filename, &st);
+    g_assert(cached);
+    nmtst_assert_connection_verifies_without_normalization(cached);
+    nmtst_assert_connection_equals(connection, FALSE, cached, FALSE);
+    g_assert_cmpstr(nm_setting_wireless_security_get_psk(
+                        nm_connection_get_setting_wireless_security(cached)),
+                    ==,
+                    KEYFILE_CACHE_PSK);
+    g_clear_object(&cached);
+
+    /* Any change of the stat invalidates the entry. */
+    st2 = st;
+    st2.st_mtim.tv_nsec = (st2.st_mtim.tv_nsec + 1) % 1000000000;
+    g_assert(!_keyfile_cache_lookup(cache_filename, full_filename, &st2));
+
+    st2 = st;
+    st2.st_mtim.tv_sec++;
+    g_assert(!_keyfile_cache_lookup(cache_filename, full_filename, &st2));
+
+    st2 = st;
+    st2.st_size++;
+    g_assert(!_keyfile_cache_lookup(cache_filename, full_filename, &st2));
+
+    st2 = st;
+    st2.st_ino++;
+    g_assert(!_keyfile_cache_lookup(cache_filename, full_filename, &st2));
+
+    /* Rewriting the file replaces it with a new inode. */
+    success = nm_utils_file_set_contents(full_filename, keyfile, -1, 0600, NULL, NULL, &error);
+    nmtst_assert_success(success, error);
+    g_assert(stat(full_filename, &st2) == 0);
+    g_assert(!_keyfile_cache_lookup(cache_filename, full_filename, &st2));
+
+    /* A hit for a profile with secrets reads the keyfile. Without it, the entry
+     * cannot be used. */
+    (void) unlink(full_filename);
+    g_assert(!_keyfile_cache_lookup(cache_filename, full_filename, &st));
+
+    (void) unlink(cache_filename);
+}
+
+static void
+test_keyfile_cache_no_secrets(void)
+{
+    const char *const full_filename  = TEST_SCRATCH_DIR "/Test_Cache_No_Secrets.nmconnection";
+    const char *const cache_filename = TEST_SCRATCH_DIR "/keyfile-cache-no-secrets";
+    const char *const keyfile        = "[connection]\n"
+                                       "id=Test Keyfile Cache No Secrets\n"
+                                       "uuid=5b0f4b2e-8a3d-4c1e-9f6a-2d7e4c3b1a90\n"
+                                       "type=ethernet\n"
+                                       "interface-name=eth0\n";
+    nm_auto_free_keyfile_cache NMSKeyfileCache *cache      = NULL;
+    gs_unref_object NMConnection               *connection = NULL;
+    gs_unref_object NMConnection               *cached     = NULL;
+    gs_free_error GError                       *error      = NULL;
+    struct stat                                 st;
+    gboolean                                    success;
+
+    (void) unlink(cache_filename);
+
+    success = nm_utils_file_set_contents(full_filename, keyfile, -1, 0600, NULL, NULL, &error);
+    nmtst_assert_success(success, error);
+
+    connection = nms_keyfile_reader_from_file(full_filename,
+                                              NULL,
+                                              &st,
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              &error);
+    nmtst_assert_success(connection, error);
+
+    cache = nms_keyfile_cache_new(cache_filename, NULL);
+    nms_keyfile_cache_add(cache,
+                          full_filename,
+                          &st,
+                          connection,
+                          NM_TERNARY_DEFAULT,
+                          NM_TERNARY_DEFAULT,
+                          NM_TERNARY_DEFAULT,
+                          NULL,
+                          NM_TERNARY_DEFAULT,
+                          FALSE);
+    success = nms_keyfile_cache_commit(cache, &error);
+    nmtst_assert_success(success, error);
+
+    /* Without secrets, a hit does not read the keyfile. It works even after the
+     * file is gone, as long as the caller passes the old stat. */
+    (void) unlink(full_filename);
+
+    cached = _keyfile_cache_lookup(cache_filename, full_filename, &st);
+    g_assert(cached);
+    nmtst_assert_connection_verifies_without_normalization(cached);
+    nmtst_assert_connection_equals(connection, FALSE, cached, FALSE);
+
+    (void) unlink(cache_filename);
+}
+
+/*****************************************************************************/
+
+#define READ_FILES_DIR TEST_SCRATCH_DIR "/read-files"
+#define READ_FILES_NUM 100u
+
+static void
+_read_files(NMSKeyfileReaderFileData *files, char **full_filenames, guint n_threads)
+{
+    guint i;
+
+    for (i = 0; i < READ_FILES_NUM; i++) {
+        files[i] = (NMSKeyfileReaderFileData) {
+            .full_filename = full_filenames[i],
+        };
+    }
+    nms_keyfile_reader_from_files(files, READ_FILES_NUM, NULL, NULL, n_threads);
+}
+
+static void
+test_read_files_parallel(void)
+{
+    NMSKeyfileReaderFileData files1[READ_FILES_NUM];
+    NMSKeyfileReaderFileData files2[READ_FILES_NUM];
+    char                    *full_filenames[READ_FILES_NUM];
+    guint                    i;
+
+    g_assert_cmpint(g_mkdir_with_parents(READ_FILES_DIR, 0755), ==, 0);
+
+    for (i = 0; i < READ_FILES_NUM; i++) {
+        gs_free_error GError *error    = NULL;
+        gs_free char         *contents = NULL;
+        gboolean              success;
+
+        full_filenames[i] = g_strdup_printf(READ_FILES_DIR "/read-files-%03u.nmconnection", i);
+
+        if (i % 10 == 3) {
+            /* Parses, but does not normalize. */
+            contents = g_strdup_printf("[connection]\n"
+                                       "id=read-files-%03u\n"
+                                       "type=ethernet\n"
+                                       "\n"
+                                       "[ipv4]\n"
+                                       "method=bogus\n",
+                                       i);
+        } else if (i % 10 == 7) {
+            /* Does not parse. */
+            contents = g_strdup("[connection\n");
+        } else {
+            /* The uuid is generated from the filename. */
+            contents = g_strdup_printf("[connection]\n"
+                                       "id=profile-%03u\n"
+                                       "type=ethernet\n"
+                                       "interface-name=eth%u\n"
+                                       "\n"
+                                       "[ipv4]\n"
+                                       "method=manual\n"
+                                       "address1=192.168.0.%u/24\n",
+                                       i,
+                                       i,
+                                       i + 1);
+        }
+        success =
+            nm_utils_file_set_contents(full_filenames[i], contents, -1, 0600, NULL, NULL, &error);
+        nmtst_assert_success(success, error);
+    }
+
+    _read_files(files1, full_filenames, 1);
+    _read_files(files2, full_filenames, 4);
+
+    for (i = 0; i < READ_FILES_NUM; i++) {
+        NMSKeyfileReaderFileData *f1 = &files1[i];
+        NMSKeyfileReaderFileData *f2 = &files2[i];
+
+        g_assert(f1->full_filename == full_filenames[i]);
+        g_assert(f2->full_filename == full_filenames[i]);
+        g_assert(!f1->from_cache);
+        g_assert(!f2->from_cache);
+
+        if (NM_IN_SET(i % 10, 3, 7)) {
+            g_assert(!f1->connection);
+            g_assert(!f2->connection);
+            g_assert(f1->error);
+            g_assert(f2->error);
+            g_assert_cmpstr(f1->error->message, ==, f2->error->message);
+            if (i % 10 == 3)
+                g_assert(g_error_matches(f1->error,
+                                         NM_SETTINGS_ERROR,
+                                         NM_SETTINGS_ERROR_INVALID_CONNECTION));
+        } else {
+            g_assert(!f1->error);
+            g_assert(!f2->error);
+            nmtst_assert_connection_verifies_without_normalization(f1->connection);
+            nmtst_assert_connection_equals(f1->connection, FALSE, f2->connection, FALSE);
+            g_assert_cmpstr(nm_connection_get_id(f1->connection),
+                            ==,
+                            nm_sprintf_bufa(20, "profile-%03u", i));
+        }
+
+        g_assert_cmpint(f1->st.st_ino, ==, f2->st.st_ino);
+        g_assert_cmpint(f1->is_nm_generated, ==, f2->is_nm_generated);
+        g_assert_cmpint(f1->is_volatile, ==, f2->is_volatile);
+        g_assert_cmpint(f1->is_external, ==, f2->is_external);
+        g_assert_cmpint(f1->shadowed_owned, ==, f2->shadowed_owned);
+        g_assert_cmpstr(f1->shadowed_storage, ==, f2->shadowed_storage);
+
+        nms_keyfile_reader_file_data_clear(f1);
+        nms_keyfile_reader_file_data_clear(f2);
+        (void) unlink(full_filenames[i]);
+        g_free(full_filenames[i]);
+    }
+
+    (void) rmdir(READ_FILES_DIR);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -3008,6 +3302,9 @@ main(int argc, char **argv)
                     test_nm_keyfile_plugin_utils_escape_filename);
 
     g_test_add_func("/keyfile/test_nmmeta", test_nmmeta);
+    g_test_add_func("/keyfile/test_keyfile_cache", test_keyfile_cache);
+    g_test_add_func("/keyfile/test_keyfile_cache_no_secrets", test_keyfile_cache_no_secrets);
+    g_test_add_func("/keyfile/test_read_files_parallel", test_read_files_parallel);
 
     return g_test_run();
 }
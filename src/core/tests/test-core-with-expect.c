@@ -629,6 +629,68 @@ test_nmp_utils_new_vlan_name(void)
 
 /*****************************************************************************/
 
+static void
+_test_logging_async_log(guint from, guint to)
+{
+    guint i;
+
+    for (i = from; i < to; i++)
+        nm_log_warn(LOGD_CORE, "async message %u", i);
+}
+
+static void
+_test_logging_async_expect(guint from, guint to)
+{
+    guint i;
+
+    for (i = from; i < to; i++) {
+        char buf[100];
+
+        NMTST_EXPECT_NM_WARN(nm_sprintf_buf(buf, "async message %u", i));
+    }
+}
+
+static void
+test_logging_async(void)
+{
+    GLogLevelFlags fatal_mask;
+
+    fatal_mask = g_log_set_always_fatal(G_LOG_FATAL_MASK);
+
+    /* Set all expectations upfront. They are checked by the writer thread. */
+    _test_logging_async_expect(0, 16);
+    NMTST_EXPECT_NM_WARN("logging: 4 messages dropped (asynchronous logging queue full)");
+    _test_logging_async_expect(20, 37);
+    NMTST_EXPECT_NM_WARN("logging: 3 messages dropped (asynchronous logging queue full)");
+
+    /* the limit is raised to the minimum of 16 messages. */
+    nm_logging_async_start(5);
+
+    /* Messages 16 to 19 don't fit into the queue. The drop marker is
+     * written in front of the next message that fits. */
+    nmtst_logging_async_set_paused(TRUE);
+    _test_logging_async_log(0, 20);
+    nmtst_logging_async_set_paused(FALSE);
+    _test_logging_async_log(20, 21);
+
+    /* nm_logging_async_stop() writes what is still queued, followed by
+     * the number of messages that were dropped last. */
+    nmtst_logging_async_set_paused(TRUE);
+    _test_logging_async_log(21, 40);
+    nm_logging_async_stop();
+
+    g_test_assert_expected_messages();
+
+    /* afterwards, messages are written synchronously again. */
+    _test_logging_async_expect(40, 41);
+    _test_logging_async_log(40, 41);
+    g_test_assert_expected_messages();
+
+    g_log_set_always_fatal(fatal_mask);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -643,6 +705,7 @@ main(int argc, char **argv)
                     test_nm_utils_array_remove_at_indexes);
     g_test_add_func("/general/nm_ethernet_address_is_valid", test_nm_ethernet_address_is_valid);
     g_test_add_func("/general/nmp_utils_new_vlan_name", test_nmp_utils_new_vlan_name);
+    g_test_add_func("/general/logging_async", test_logging_async);
 
     return g_test_run();
 }
@@ -7,6 +7,7 @@
 
 #include <net/if.h>
 #include <byteswap.h>
+#include <linux/rtnetlink.h>
 
 /* need math.h for isinf() and INFINITY. No need to link with -lm */
 #include <math.h>
@@ -15,10 +16,14 @@
 #include "NetworkManagerUtils.h"
 #include "libnm-core-intern/nm-core-internal.h"
 #include "nm-core-utils.h"
+#include "libnm-platform/nmp-object.h"
 
 #include "dns/nm-dns-manager.h"
+#include "dns/nm-dns-plugin.h"
+#include "nm-l3-config-data.h"
 #include "nm-connectivity.h"
 #include "nm-firewall-utils.h"
+#include "settings/nm-settings-utils.h"
 
 #include "nm-test-utils-core.h"
 
@@ -1240,14 +1245,31 @@ test_connection_sort_autoconnect_priority(void)
 #define MATCH_S390   "S390:"
 #define MATCH_DRIVER "DRIVER:"
 
+static NMMatchSpecMatchType
+_test_match_spec_device_data(const GSList *specs, const NMMatchSpecDeviceData *data)
+{
+    nm_auto_free_match_spec_device NMMatchSpecDevice *compiled = NULL;
+    NMMatchSpecMatchType                              m;
+
+    m = nm_match_spec_device(specs, data);
+
+    /* the compiled specs must give the same result. */
+    compiled =
+        nm_match_spec_device_new(g_slist_copy_deep((GSList *) specs, nm_copy_func_g_strdup, NULL));
+    g_assert_cmpint(nm_match_spec_device_match(compiled, data), ==, m);
+
+    return m;
+}
+
 static NMMatchSpecMatchType
 _test_match_spec_device(const GSList *specs, const char *match_str)
 {
     if (match_str && g_str_has_prefix(match_str, MATCH_S390))
-        return nm_match_spec_device(specs,
-                                    &((const NMMatchSpecDeviceData) {
-                                        .s390_subchannels = &match_str[NM_STRLEN(MATCH_S390)],
-                                    }));
+        return _test_match_spec_device_data(
+            specs,
+            &((const NMMatchSpecDeviceData) {
+                .s390_subchannels = &match_str[NM_STRLEN(MATCH_S390)],
+            }));
     if (match_str && g_str_has_prefix(match_str, MATCH_DRIVER)) {
         gs_free char *s = g_strdup(&match_str[NM_STRLEN(MATCH_DRIVER)]);
         char         *t;
@@ -1257,16 +1279,16 @@ _test_match_spec_device(const GSList *specs, const char *match_str)
             t[0] = '\0';
             t++;
         }
-        return nm_match_spec_device(specs,
-                                    &((const NMMatchSpecDeviceData) {
-                                        .driver         = s,
-                                        .driver_version = t,
-                                    }));
+        return _test_match_spec_device_data(specs,
+                                            &((const NMMatchSpecDeviceData) {
+                                                .driver         = s,
+                                                .driver_version = t,
+                                            }));
     }
-    return nm_match_spec_device(specs,
-                                &((const NMMatchSpecDeviceData) {
-                                    .interface_name = match_str,
-                                }));
+    return _test_match_spec_device_data(specs,
+                                        &((const NMMatchSpecDeviceData) {
+                                            .interface_name = match_str,
+                                        }));
 }
 
 static void
@@ -2772,6 +2794,364 @@ test_nm_firewall_nft_stdio_mlag(void)
 
 /*****************************************************************************/
 
+static void
+_assert_objs_page(const GPtrArray *objs,
+                  guint32          offset,
+                  guint32          limit,
+                  guint            expected_start,
+                  guint            expected_len)
+{
+    gs_unref_variant GVariant *v = NULL;
+    guint                      i;
+
+    v = g_variant_ref_sink(nm_utils_ip_objs_to_dbus_page(AF_INET, objs, NULL, offset, limit));
+    g_assert(g_variant_is_of_type(v, G_VARIANT_TYPE("aa{sv}")));
+    g_assert_cmpint(g_variant_n_children(v), ==, expected_len);
+
+    for (i = 0; i < expected_len; i++) {
+        gs_unref_variant GVariant *e = g_variant_get_child_value(v, i);
+        const NMPObject           *o = objs->pdata[expected_start + i];
+        char                       sbuf[NM_INET_ADDRSTRLEN];
+        const char                *dest;
+        guint32                    prefix;
+
+        g_assert(g_variant_lookup(e, "dest", "&s", &dest));
+        g_assert(g_variant_lookup(e, "prefix", "u", &prefix));
+        g_assert_cmpstr(dest, ==, nm_inet4_ntop(NMP_OBJECT_CAST_IP4_ROUTE(o)->network, sbuf));
+        g_assert_cmpint(prefix, ==, NMP_OBJECT_CAST_IP4_ROUTE(o)->plen);
+    }
+}
+
+static void
+test_ip_objs_to_dbus_page(void)
+{
+    gs_unref_ptrarray GPtrArray *objs = NULL;
+    const guint                  N    = 250;
+    guint                        i;
+
+    _assert_objs_page(NULL, 0, 10, 0, 0);
+
+    objs = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+    for (i = 0; i < N; i++) {
+        const NMPlatformIP4Route r = {
+            .ifindex       = 1,
+            .network       = nm_ip4_addr_clear_host_address(htonl(0x0a000000u | (i << 8)), 24),
+            .plen          = 24,
+            .metric        = 100,
+            .table_coerced = nm_platform_route_table_coerce(RT_TABLE_MAIN),
+            .rt_source     = NM_IP_CONFIG_SOURCE_USER,
+        };
+
+        g_ptr_array_add(objs, nmp_object_new(NMP_OBJECT_TYPE_IP4_ROUTE, &r));
+    }
+
+    /* More than NM_UTILS_IP_ROUTES_TO_DBUS_MAX routes are reachable. */
+    _assert_objs_page(objs, 0, 100, 0, 100);
+    _assert_objs_page(objs, 100, 100, 100, 100);
+    _assert_objs_page(objs, 200, 100, 200, N - 200);
+    _assert_objs_page(objs, 0, G_MAXUINT32, 0, N);
+    _assert_objs_page(objs, N - 1, G_MAXUINT32, N - 1, 1);
+
+    /* A limit of zero and an offset at or past the end give an empty page. */
+    _assert_objs_page(objs, 0, 0, 0, 0);
+    _assert_objs_page(objs, 10, 0, 0, 0);
+    _assert_objs_page(objs, N, 10, 0, 0);
+    _assert_objs_page(objs, N + 1, 10, 0, 0);
+    _assert_objs_page(objs, G_MAXUINT32, G_MAXUINT32, 0, 0);
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    GMainLoop *loop;
+    guint      n_calls;
+    guint      n_items;
+} BatchData;
+
+static void
+_batch_cb(GHashTable *items, gpointer user_data)
+{
+    BatchData *data = user_data;
+
+    data->n_calls++;
+    data->n_items = g_hash_table_size(items);
+    g_main_loop_quit(data->loop);
+}
+
+static void
+test_utils_batch(void)
+{
+    nm_auto_unref_gmainloop GMainLoop *loop  = g_main_loop_new(NULL, FALSE);
+    BatchData                          data  = {.loop = loop};
+    NMUtilsBatch                      *batch = NULL;
+    guint                              i;
+
+    batch = nm_utils_batch_new(10, _batch_cb, &data);
+
+    /* Many changes of three devices in one main loop iteration result
+     * in a single call, which sees each device once. */
+    for (i = 0; i < 100; i++)
+        nm_utils_batch_add(batch, GUINT_TO_POINTER((i % 3) + 1));
+    nm_utils_batch_remove(batch, GUINT_TO_POINTER(3));
+    g_assert_cmpint(data.n_calls, ==, 0);
+
+    nmtst_main_loop_run_assert(loop, 1000);
+    g_assert_cmpint(data.n_calls, ==, 1);
+    g_assert_cmpint(data.n_items, ==, 2);
+
+    g_assert(!nmtst_main_loop_run(loop, 50));
+    g_assert_cmpint(data.n_calls, ==, 1);
+
+    /* A new change after the call starts a new batch. */
+    nm_utils_batch_add(batch, GUINT_TO_POINTER(1));
+    nmtst_main_loop_run_assert(loop, 1000);
+    g_assert_cmpint(data.n_calls, ==, 2);
+    g_assert_cmpint(data.n_items, ==, 1);
+
+    /* Cancelled items are dropped. */
+    nm_utils_batch_add(batch, GUINT_TO_POINTER(1));
+    nm_utils_batch_cancel(batch);
+    g_assert(!nmtst_main_loop_run(loop, 50));
+    g_assert_cmpint(data.n_calls, ==, 2);
+
+    nm_utils_batch_add(batch, GUINT_TO_POINTER(1));
+    nm_utils_batch_free(batch);
+    g_assert(!nmtst_main_loop_run(loop, 50));
+    g_assert_cmpint(data.n_calls, ==, 2);
+}
+
+/*****************************************************************************/
+
+static void
+_dns_plugin_hash(const NML3ConfigData *l3cd,
+                 NMDnsIPConfigType     ip_config_type,
+                 guint8                buffer[static NM_UTILS_CHECKSUM_LENGTH_SHA1])
+{
+    nm_auto_free_checksum GChecksum *sum     = g_checksum_new(G_CHECKSUM_SHA1);
+    NMDnsConfigData                  data    = {.ifindex = 1};
+    const NMDnsConfigIPData          ip_data = {
+                 .data           = &data,
+                 .l3cd           = l3cd,
+                 .addr_family    = AF_INET,
+                 .ip_config_type = ip_config_type,
+    };
+
+    nm_dns_config_ip_data_hash_plugin(&ip_data, sum);
+    nm_utils_checksum_get_digest_len(sum, buffer, NM_UTILS_CHECKSUM_LENGTH_SHA1);
+}
+
+static const NML3ConfigData *
+_dns_plugin_l3cd_new(NMDedupMultiIndex *multi_idx,
+                     gboolean           with_default_route,
+                     NMTernary          never_default)
+{
+    nm_auto_unref_l3cd_init NML3ConfigData *l3cd = NULL;
+
+    l3cd = nm_l3_config_data_new(multi_idx, 1, NM_IP_CONFIG_SOURCE_UNKNOWN);
+    nm_l3_config_data_add_nameserver(l3cd, AF_INET, "8.8.8.8");
+    if (with_default_route) {
+        nm_l3_config_data_add_route_4(
+            l3cd,
+            NM_PLATFORM_IP4_ROUTE_INIT(.ifindex = 1,
+                                       .gateway = nmtst_inet4_from_string("192.168.1.1"),
+                                       .metric  = 100));
+    }
+    if (never_default != NM_TERNARY_DEFAULT)
+        nm_l3_config_data_set_never_default(l3cd, AF_INET, never_default);
+    return nm_l3_config_data_seal(g_steal_pointer(&l3cd));
+}
+
+static void
+test_dns_plugin_hash(void)
+{
+    nm_auto_unref_dedup_multi_index NMDedupMultiIndex *multi_idx = nm_dedup_multi_index_new();
+    nm_auto_unref_l3cd const NML3ConfigData           *l3cd_a    = NULL;
+    nm_auto_unref_l3cd const NML3ConfigData           *l3cd_b    = NULL;
+    nm_auto_unref_l3cd const NML3ConfigData           *l3cd_c    = NULL;
+    guint8                                             hash_a[NM_UTILS_CHECKSUM_LENGTH_SHA1];
+    guint8                                             hash_b[NM_UTILS_CHECKSUM_LENGTH_SHA1];
+
+    /* The DNS parameters are the same, only the default route differs. The
+     * plugins must still be updated, because it decides about the "~." domain. */
+    l3cd_a = _dns_plugin_l3cd_new(multi_idx, FALSE, NM_TERNARY_DEFAULT);
+    l3cd_b = _dns_plugin_l3cd_new(multi_idx, TRUE, NM_TERNARY_DEFAULT);
+
+    _dns_plugin_hash(l3cd_a, NM_DNS_IP_CONFIG_TYPE_DEFAULT, hash_a);
+    _dns_plugin_hash(l3cd_b, NM_DNS_IP_CONFIG_TYPE_DEFAULT, hash_b);
+    g_assert(memcmp(hash_a, hash_b, sizeof(hash_a)) != 0);
+
+    _dns_plugin_hash(l3cd_b, NM_DNS_IP_CONFIG_TYPE_DEFAULT, hash_a);
+    g_assert(memcmp(hash_a, hash_b, sizeof(hash_a)) == 0);
+
+    /* For a VPN without default route, only never-default differs. */
+    l3cd_c = _dns_plugin_l3cd_new(multi_idx, FALSE, NM_TERNARY_FALSE);
+
+    _dns_plugin_hash(l3cd_a, NM_DNS_IP_CONFIG_TYPE_VPN, hash_a);
+    _dns_plugin_hash(l3cd_c, NM_DNS_IP_CONFIG_TYPE_VPN, hash_b);
+    g_assert(memcmp(hash_a, hash_b, sizeof(hash_a)) != 0);
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    NMDnsPlugin parent;
+    GMainLoop  *loop;
+    GSource    *push_source;
+    guint       n_pushes;
+} TestDnsPlugin;
+
+typedef NMDnsPluginClass TestDnsPluginClass;
+
+GType test_dns_plugin_get_type(void);
+
+G_DEFINE_TYPE(TestDnsPlugin, test_dns_plugin, NM_TYPE_DNS_PLUGIN)
+
+static void
+test_dns_plugin_init(TestDnsPlugin *self)
+{}
+
+static void
+test_dns_plugin_class_init(TestDnsPluginClass *klass)
+{
+    klass->plugin_name = "test";
+}
+
+static gboolean
+_dns_plugin_push_cb(gpointer user_data)
+{
+    TestDnsPlugin *plugin = user_data;
+
+    nm_clear_g_source_inst(&plugin->push_source);
+    plugin->n_pushes++;
+    g_main_loop_quit(plugin->loop);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+test_dns_plugin_push(void)
+{
+    nm_auto_unref_gmainloop GMainLoop *loop   = g_main_loop_new(NULL, FALSE);
+    gs_unref_object TestDnsPlugin     *plugin = g_object_new(test_dns_plugin_get_type(), NULL);
+    NMDnsPlugin                       *p      = NM_DNS_PLUGIN(plugin);
+    gs_unref_variant GVariant         *arg1   = g_variant_ref_sink(g_variant_new("(is)", 1, "a"));
+    gs_unref_variant GVariant         *arg2   = g_variant_ref_sink(g_variant_new("(is)", 1, "a"));
+    gs_unref_variant GVariant         *arg3   = g_variant_ref_sink(g_variant_new("(is)", 1, "b"));
+    gs_unref_hashtable GHashTable     *keep   = g_hash_table_new(nm_direct_hash, NULL);
+    GSource                           *source;
+
+    plugin->loop = loop;
+
+    /* Without delay, the caller sends right away. */
+    g_assert(!_nm_dns_plugin_schedule_push_delay(p, &plugin->push_source, _dns_plugin_push_cb, 0));
+    g_assert(!plugin->push_source);
+
+    /* Changes within the delay result in one push, and later changes
+     * don't extend the delay. */
+    g_assert(_nm_dns_plugin_schedule_push_delay(p, &plugin->push_source, _dns_plugin_push_cb, 20));
+    source = plugin->push_source;
+    g_assert(source);
+    g_assert(_nm_dns_plugin_schedule_push_delay(p, &plugin->push_source, _dns_plugin_push_cb, 20));
+    g_assert(plugin->push_source == source);
+
+    nmtst_main_loop_run_assert(loop, 1000);
+    g_assert_cmpint(plugin->n_pushes, ==, 1);
+    g_assert(!plugin->push_source);
+
+    g_assert(!nmtst_main_loop_run(loop, 50));
+    g_assert_cmpint(plugin->n_pushes, ==, 1);
+
+    /* An equal request for the same operation and link is skipped. */
+    g_assert(!_nm_dns_plugin_push_check_and_add(p, "SetLinkDNS", 1, arg1));
+    g_assert(_nm_dns_plugin_push_check_and_add(p, "SetLinkDNS", 1, arg2));
+    g_assert(!_nm_dns_plugin_push_check_and_add(p, "SetLinkDNS", 2, arg1));
+    g_assert(!_nm_dns_plugin_push_check_and_add(p, "SetLinkDomains", 1, arg1));
+    g_assert_cmpint(nm_dns_plugin_get_stats(p)->n_pushes_skipped, ==, 1);
+
+    g_assert(!_nm_dns_plugin_push_check_and_add(p, "SetLinkDNS", 1, arg3));
+    g_assert(_nm_dns_plugin_push_check_and_add(p, "SetLinkDNS", 1, arg3));
+
+    /* A failed request is only forgotten if it was the last one sent. */
+    _nm_dns_plugin_push_forget(p, "SetLinkDNS", 1, arg1);
+    g_assert(_nm_dns_plugin_push_check_and_add(p, "SetLinkDNS", 1, arg3));
+    _nm_dns_plugin_push_forget(p, "SetLinkDNS", 1, arg3);
+    g_assert(!_nm_dns_plugin_push_check_and_add(p, "SetLinkDNS", 1, arg3));
+
+    /* Links that are no longer tracked are forgotten. */
+    g_hash_table_add(keep, GINT_TO_POINTER(1));
+    _nm_dns_plugin_push_forget_all(p, keep);
+    g_assert(_nm_dns_plugin_push_check_and_add(p, "SetLinkDNS", 1, arg3));
+    g_assert(!_nm_dns_plugin_push_check_and_add(p, "SetLinkDNS", 2, arg1));
+
+    /* After a resync, everything is sent again. */
+    _nm_dns_plugin_push_forget_all(p, NULL);
+    g_assert(!_nm_dns_plugin_push_check_and_add(p, "SetLinkDNS", 1, arg3));
+    g_assert(!_nm_dns_plugin_push_check_and_add(p, "SetLinkDomains", 1, arg1));
+    g_assert_cmpint(nm_dns_plugin_get_stats(p)->n_pushes_skipped, ==, 4);
+}
+
+/*****************************************************************************/
+
+static void
+_assert_ifname_idx(GHashTable *idx, const char *ifname, guint n, ...)
+{
+    const GPtrArray *arr = nm_sett_util_ifname_idx_lookup(idx, ifname);
+    va_list          ap;
+    guint            i;
+
+    g_assert_cmpint(nm_g_ptr_array_len(arr), ==, n);
+
+    va_start(ap, n);
+    for (i = 0; i < n; i++)
+        g_assert(g_ptr_array_find(arr, va_arg(ap, gpointer), NULL));
+    va_end(ap);
+}
+
+static void
+test_settings_ifname_idx(void)
+{
+    gs_unref_hashtable GHashTable *idx = nm_sett_util_ifname_idx_new();
+    gpointer                       p1  = GINT_TO_POINTER(1);
+    gpointer                       p2  = GINT_TO_POINTER(2);
+    gpointer                       p3  = GINT_TO_POINTER(3);
+
+    /* Adding profiles. */
+    nm_sett_util_ifname_idx_add(idx, "eth0", p1);
+    nm_sett_util_ifname_idx_add(idx, NULL, p2);
+    nm_sett_util_ifname_idx_add(idx, "eth0", p3);
+    _assert_ifname_idx(idx, "eth0", 2, p1, p3);
+    _assert_ifname_idx(idx, NULL, 1, p2);
+    _assert_ifname_idx(idx, "eth1", 0);
+    g_assert_cmpint(g_hash_table_size(idx), ==, 2);
+
+    /* An update that keeps the interface-name changes nothing. */
+    nm_sett_util_ifname_idx_update(idx, "eth0", "eth0", p1);
+    nm_sett_util_ifname_idx_update(idx, NULL, NULL, p2);
+    _assert_ifname_idx(idx, "eth0", 2, p1, p3);
+    _assert_ifname_idx(idx, NULL, 1, p2);
+
+    /* Changing the interface-name moves the profile. */
+    nm_sett_util_ifname_idx_update(idx, "eth0", "eth1", p1);
+    _assert_ifname_idx(idx, "eth0", 1, p3);
+    _assert_ifname_idx(idx, "eth1", 1, p1);
+
+    /* Setting and clearing the interface-name. */
+    nm_sett_util_ifname_idx_update(idx, NULL, "eth1", p2);
+    nm_sett_util_ifname_idx_update(idx, "eth0", NULL, p3);
+    _assert_ifname_idx(idx, "eth1", 2, p1, p2);
+    _assert_ifname_idx(idx, NULL, 1, p3);
+    _assert_ifname_idx(idx, "eth0", 0);
+    g_assert_cmpint(g_hash_table_size(idx), ==, 2);
+
+    /* Removing profiles drops the empty buckets. */
+    nm_sett_util_ifname_idx_remove(idx, "eth1", p1);
+    _assert_ifname_idx(idx, "eth1", 1, p2);
+    nm_sett_util_ifname_idx_remove(idx, "eth1", p2);
+    nm_sett_util_ifname_idx_remove(idx, NULL, p3);
+    g_assert_cmpint(g_hash_table_size(idx), ==, 0);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -2847,6 +3227,11 @@ main(int argc, char **argv)
                     test_kernel_cmdline_match_check);
 
     g_test_add_func("/core/test_nm_firewall_nft_stdio_mlag", test_nm_firewall_nft_stdio_mlag);
+    g_test_add_func("/core/ip_objs_to_dbus_page", test_ip_objs_to_dbus_page);
+    g_test_add_func("/core/utils_batch", test_utils_batch);
+    g_test_add_func("/core/dns_plugin_hash", test_dns_plugin_hash);
+    g_test_add_func("/core/dns_plugin_push", test_dns_plugin_push);
+    g_test_add_func("/core/settings_ifname_idx", test_settings_ifname_idx);
 
     return g_test_run();
 }
@@ -520,6 +520,106 @@ test_l3cfg(gconstpointer test_data)
 
 /*****************************************************************************/
 
+static void
+_test_l3cfg_commit_stats_assert_hist(const NML3CfgCommitStats *stats)
+{
+    guint phase;
+    guint i;
+
+    for (phase = 0; phase < _NM_L3CFG_COMMIT_PHASE_NUM; phase++) {
+        guint64 n = 0;
+
+        for (i = 0; i < NM_L3CFG_COMMIT_STATS_HIST_LEN; i++)
+            n += stats->phase_hist[phase][i];
+        g_assert_cmpint(n, ==, stats->n_commits);
+    }
+}
+
+static void
+test_l3cfg_commit_stats(void)
+{
+    nm_auto(_test_fixture_1_teardown) TestFixture1 test_fixture  = {};
+    gs_free char                                  *log_level     = NULL;
+    gs_free char                                  *log_domains   = NULL;
+    nm_auto_unref_l3cd_init NML3ConfigData        *l3cd          = NULL;
+    gs_unref_object NML3Cfg                       *l3cfg0        = NULL;
+    const TestFixture1                            *f;
+    NML3CfgCommitTypeHandle                       *commit_type_1;
+    const NML3CfgCommitStats                      *stats;
+    guint64                                        n_commits;
+    guint64                                        n_configured;
+    guint64                                        n_present;
+
+    f = _test_fixture_1_setup(&test_fixture, 5);
+
+    l3cfg0 = _netns_access_l3cfg(f->netns, f->ifindex0);
+
+    commit_type_1 =
+        nm_l3cfg_commit_type_register(l3cfg0, NM_L3_CFG_COMMIT_TYPE_UPDATE, NULL, "test1");
+
+    l3cd = nm_l3_config_data_new(f->multiidx, f->ifindex0, NM_IP_CONFIG_SOURCE_UNKNOWN);
+    nm_l3_config_data_add_address_4(
+        l3cd,
+        NM_PLATFORM_IP4_ADDRESS_INIT(.address      = nmtst_inet4_from_string("192.168.133.45"),
+                                     .peer_address = nmtst_inet4_from_string("192.168.133.45"),
+                                     .plen         = 24, ));
+    nm_l3_config_data_seal(l3cd);
+
+    nm_l3cfg_add_config(l3cfg0,
+                        GINT_TO_POINTER('a'),
+                        TRUE,
+                        l3cd,
+                        'a',
+                        0,
+                        0,
+                        NM_PLATFORM_ROUTE_METRIC_DEFAULT_IP4,
+                        NM_PLATFORM_ROUTE_METRIC_DEFAULT_IP6,
+                        0,
+                        0,
+                        NM_DNS_PRIORITY_DEFAULT_NORMAL,
+                        NM_DNS_PRIORITY_DEFAULT_NORMAL,
+                        NM_L3_ACD_DEFEND_TYPE_NEVER,
+                        0,
+                        NM_L3CFG_CONFIG_FLAGS_NONE,
+                        NM_L3_CONFIG_MERGE_FLAGS_NONE);
+
+    stats     = nmtst_l3cfg_get_commit_stats(l3cfg0);
+    n_commits = stats->n_commits;
+
+    /* Every commit is accounted in each phase, and counts the configured
+     * address. */
+    nm_l3cfg_commit(l3cfg0, NM_L3_CFG_COMMIT_TYPE_REAPPLY);
+    g_assert_cmpint(stats->n_commits, ==, n_commits + 1);
+    g_assert_cmpint(stats->addresses.configured, >=, 1);
+    _test_l3cfg_commit_stats_assert_hist(stats);
+
+    /* Without debug logging, the existing objects are not looked up. */
+    log_level   = g_strdup(nm_logging_level_to_string());
+    log_domains = g_strdup(nm_logging_domains_to_string());
+
+    g_assert(nm_logging_setup("INFO", "ALL", NULL, NULL));
+    n_configured = stats->addresses.configured;
+    n_present    = stats->addresses.present;
+    nm_l3cfg_commit(l3cfg0, NM_L3_CFG_COMMIT_TYPE_REAPPLY);
+    g_assert_cmpint(stats->n_commits, ==, n_commits + 2);
+    g_assert_cmpint(stats->addresses.configured, >, n_configured);
+    g_assert_cmpint(stats->addresses.present, ==, n_present);
+
+    /* With debug logging, the address from the previous commit is present. */
+    g_assert(nm_logging_setup("DEBUG", "CORE", NULL, NULL));
+    n_present = stats->addresses.present;
+    nm_l3cfg_commit(l3cfg0, NM_L3_CFG_COMMIT_TYPE_REAPPLY);
+    g_assert_cmpint(stats->n_commits, ==, n_commits + 3);
+    g_assert_cmpint(stats->addresses.present, >, n_present);
+    _test_l3cfg_commit_stats_assert_hist(stats);
+
+    g_assert(nm_logging_setup(log_level, log_domains, NULL, NULL));
+
+    nm_l3cfg_commit_type_unregister(l3cfg0, commit_type_1);
+}
+
+/*****************************************************************************/
+
 #define L3IPV4LL_ACD_TIMEOUT_MSEC 1500u
 
 typedef struct {
@@ -1089,6 +1189,7 @@ _nmtstp_setup_tests(void)
     g_test_add_data_func("/l3cfg/2", GINT_TO_POINTER(2), test_l3cfg);
     g_test_add_data_func("/l3cfg/3", GINT_TO_POINTER(3), test_l3cfg);
     g_test_add_data_func("/l3cfg/4", GINT_TO_POINTER(4), test_l3cfg);
+    g_test_add_func("/l3cfg/commit-stats", test_l3cfg_commit_stats);
     g_test_add_data_func("/l3-ipv4ll/1", GINT_TO_POINTER(1), test_l3_ipv4ll);
     g_test_add_data_func("/l3-ipv4ll/2", GINT_TO_POINTER(2), test_l3_ipv4ll);
     g_test_add_data_func("/l3-ipv6ll/1", GINT_TO_POINTER(1), test_l3_ipv6ll);
@@ -25,7 +25,10 @@
 #define NM_CONFIG_KEYFILE_KEY_MAIN_CONFIGURE_AND_QUIT          "configure-and-quit"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_DEBUG                       "debug"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_DHCP                        "dhcp"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_DHCP_MAX_INFLIGHT           "dhcp-max-inflight"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_DHCP_START_JITTER           "dhcp-start-jitter"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_DNS                         "dns"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_DNS_UPDATE_DELAY            "dns-update-delay"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_FIREWALL_BACKEND            "firewall-backend"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_HOSTNAME_MODE               "hostname-mode"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER              "ignore-carrier"
@@ -37,10 +40,13 @@
 #define NM_CONFIG_KEYFILE_KEY_MAIN_RC_MANAGER                  "rc-manager"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_SYSTEMD_RESOLVED            "systemd-resolved"
 
-#define NM_CONFIG_KEYFILE_KEY_LOGGING_AUDIT   "audit"
-#define NM_CONFIG_KEYFILE_KEY_LOGGING_BACKEND "backend"
-#define NM_CONFIG_KEYFILE_KEY_LOGGING_DOMAINS "domains"
-#define NM_CONFIG_KEYFILE_KEY_LOGGING_LEVEL   "level"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_ASYNC_QUEUE_LIMIT          "async-queue-limit"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_AUDIT                      "audit"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_BACKEND                    "backend"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_DOMAINS                    "domains"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_LEVEL                      "level"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_PLATFORM_EVENT_DUMP_WINDOW "platform-event-dump-window"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_PLATFORM_EVENT_HISTORY     "platform-event-history"
 
 #define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_ENABLED  "enabled"
 #define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_INTERVAL "interval"
@@ -50,6 +50,12 @@
  * set @mt_require_locking. That means, by default %NM_THREAD_SAFE_ON_MAIN_THREAD is "1",
  * and code that only runs on the main-thread (which is the majority), can get away
  * without locking.
+ *
+ * With nm_logging_async_start(), the messages are only formatted by the caller and
+ * written to the backend by a separate thread. That thread only reads the global
+ * state under lock. Messages that are still queued when the process crashes or
+ * aborts are lost. Only fatal messages from the GLib log handler (g_error())
+ * first write out the queue.
  */
 
 /*****************************************************************************/
@@ -89,11 +95,59 @@ typedef struct {
     char *logging_domains_to_string;
 } GlobalMain;
 
+typedef struct {
+    /* @file and @func are string literals from the call site, the other
+     * strings are owned by the entry. */
+    const char    *file;
+    const char    *func;
+    char          *ifname;
+    char          *conn_uuid;
+    char          *msg;
+    gint64         tv;
+    gint64         now_nsec;
+    NMLogDomain    domain;
+    NMLogLevel     level;
+    guint          line;
+    int            error;
+
+    /* for messages from the GLib log handler, @glib_level is non-zero
+     * and only @glib_domain, @msg and @now_nsec are set. */
+    char          *glib_domain;
+    GLogLevelFlags glib_level;
+
+    /* the number of messages that were dropped right before this one. */
+    guint n_dropped;
+} LogAsyncEntry;
+
+typedef struct {
+    GMutex   lock;
+    GCond    cond;
+    GCond    idle_cond;
+    GThread *thread;
+
+    /* The pending messages (LogAsyncEntry). This is not a preallocated ring
+     * buffer. It is allocated on demand and grows as needed, but it never
+     * holds more than @queue_limit entries. The writer thread swaps it with
+     * its own (drained) array. */
+    GArray  *queue;
+    guint    queue_limit;
+    guint    n_dropped;
+    guint64  n_dropped_total;
+    bool     stop : 1;
+
+    /* whether the writer thread currently writes a batch. */
+    bool     busy : 1;
+
+    /* see nmtst_logging_async_set_paused(). */
+    bool     nmtst_paused : 1;
+} LogAsync;
+
 typedef struct {
     NMLogLevel  log_level;
     bool        uses_syslog : 1;
     bool        init_done : 1;
     bool        debug_stderr : 1;
+    bool        use_async : 1;
     const char *prefix;
     const char *syslog_identifier;
 
@@ -114,6 +168,11 @@ G_LOCK_DEFINE_STATIC(log);
  * such does not need any lock). */
 static GlobalMain gl_main = {};
 
+/* The state of the asynchronous writer, see nm_logging_async_start().
+ * It is protected by its own mutex, which is independent from the
+ * "log" lock and only held while moving messages in or out of the queue. */
+static LogAsync gl_async = {};
+
 static union {
     /* a union with an immutable and a mutable alias for the Global.
      * Since nm-logging must be thread-safe, we must take care at which
@@ -648,64 +707,20 @@ _nm_printf(3, 4) static void _iovec_set_format(struct iovec *iov,
 
 #endif
 
-void
-_nm_log_impl(const char *file,
-             guint       line,
-             const char *func,
-             gboolean    mt_require_locking,
-             NMLogLevel  level,
-             NMLogDomain domain,
-             int         error,
-             const char *ifname,
-             const char *conn_uuid,
-             const char *fmt,
-             ...)
+static void
+_log_write(const Global *g,
+           NMLogLevel    level,
+           NMLogDomain   domain,
+           int           error,
+           const char   *ifname,
+           const char   *conn_uuid,
+           const char   *file,
+           guint         line,
+           const char   *func,
+           gint64        tv,
+           gint64        now_nsec,
+           const char   *msg)
 {
-    char               msg_stack[400];
-    gs_free char      *msg_heap = NULL;
-    const char        *msg;
-    gint64             tv;
-    int                errsv;
-    const NMLogDomain *cur_log_state;
-    NMLogDomain        cur_log_state_copy[_LOGL_N_REAL];
-    Global             g_copy;
-    const Global      *g;
-
-    if (G_UNLIKELY(mt_require_locking)) {
-        G_LOCK(log);
-        /* we evaluate logging-enabled under lock. There is still a race that
-         * we might log the message below *after* logging was disabled. That means,
-         * when disabling logging, we might still log messages. */
-        if (!_nm_logging_enabled_lockfree(level, domain)) {
-            G_UNLOCK(log);
-            return;
-        }
-        g_copy = gl.imm;
-        memcpy(cur_log_state_copy, _nm_logging_enabled_state, sizeof(cur_log_state_copy));
-        G_UNLOCK(log);
-        g             = &g_copy;
-        cur_log_state = cur_log_state_copy;
-    } else {
-        NM_ASSERT_ON_MAIN_THREAD();
-        if (!_nm_logging_enabled_lockfree(level, domain))
-            return;
-        g             = &gl.imm;
-        cur_log_state = _nm_logging_enabled_state;
-    }
-
-    (void) cur_log_state;
-
-    errsv = errno;
-
-    /* Make sure that %m maps to the specified error */
-    if (error != 0) {
-        if (error < 0)
-            error = -error;
-        errno = error;
-    }
-
-    msg = nm_vsprintf_buf_or_alloc(fmt, fmt, msg_stack, &msg_heap, NULL);
-
     /* We always print the level and the timestamp.
      *
      * Timestamps are very useful for understanding logfiles. While journalctl
@@ -725,8 +740,6 @@ _nm_log_impl(const char *file,
     prefix, nm_log_level_desc[level].level_str, ((tv) / NM_UTILS_USEC_PER_SEC), \
         ((int) ((((tv) % NM_UTILS_USEC_PER_SEC)) / ((gint64) 100))), (msg)
 
-    tv = g_get_real_time();
-
     if (g->debug_stderr)
         g_printerr(MESSAGE_FMT "\n", MESSAGE_ARG(g->prefix, tv, msg));
 
@@ -734,7 +747,7 @@ _nm_log_impl(const char *file,
 #if SYSTEMD_JOURNAL
     case LOG_BACKEND_JOURNAL:
     {
-        gint64         now, boottime;
+        gint64         boottime;
         struct iovec   iov_data[15];
         struct iovec  *iov = iov_data;
         char          *iov_free_data[5];
@@ -745,8 +758,7 @@ _nm_log_impl(const char *file,
         char *s_log_domains;
         gsize l_log_domains;
 
-        now      = nm_utils_get_monotonic_timestamp_nsec();
-        boottime = nm_utils_monotonic_timestamp_as_boottime(now, 1);
+        boottime = nm_utils_monotonic_timestamp_as_boottime(now_nsec, 1);
 
         _iovec_set_format_a(iov++, 30, "PRIORITY=%d", nm_log_level_desc[level].syslog_level);
         _iovec_set_format(iov++,
@@ -782,8 +794,8 @@ _nm_log_impl(const char *file,
         _iovec_set_format_a(iov++,
                             60,
                             "TIMESTAMP_MONOTONIC=%lld.%06lld",
-                            (long long) (now / NM_UTILS_NSEC_PER_SEC),
-                            (long long) ((now % NM_UTILS_NSEC_PER_SEC) / 1000));
+                            (long long) (now_nsec / NM_UTILS_NSEC_PER_SEC),
+                            (long long) ((now_nsec % NM_UTILS_NSEC_PER_SEC) / 1000));
         _iovec_set_format_a(iov++,
                             60,
                             "TIMESTAMP_BOOTTIME=%lld.%06lld",
@@ -815,39 +827,14 @@ _nm_log_impl(const char *file,
               MESSAGE_ARG(g->prefix, tv, msg));
         break;
     }
-
-    errno = errsv;
-}
-
-/*****************************************************************************/
-
-void
-_nm_utils_monotonic_timestamp_initialized(const struct timespec *tp,
-                                          gint64                 offset_sec,
-                                          gboolean               is_boottime)
-{
-    NM_ASSERT_ON_MAIN_THREAD();
-
-    if (_nm_logging_enabled_lockfree(LOGL_DEBUG, LOGD_CORE)) {
-        time_t    now = time(NULL);
-        struct tm tm;
-        char      s[255];
-
-        strftime(s, sizeof(s), "%Y-%m-%d %H:%M:%S", localtime_r(&now, &tm));
-        nm_log_dbg(LOGD_CORE,
-                   "monotonic timestamp started counting 1.%09ld seconds ago with "
-                   "an offset of %lld.0 seconds to %s (local time is %s)",
-                   tp->tv_nsec,
-                   (long long) -offset_sec,
-                   is_boottime ? "CLOCK_BOOTTIME" : "CLOCK_MONOTONIC",
-                   s);
-    }
 }
 
-/*****************************************************************************/
-
 static void
-nm_log_handler(const char *log_domain, GLogLevelFlags level, const char *message, gpointer ignored)
+_log_write_glib(const Global  *g,
+                const char    *log_domain,
+                GLogLevelFlags level,
+                const char    *message,
+                gint64         now_nsec)
 {
     int syslog_priority;
 
@@ -873,28 +860,23 @@ nm_log_handler(const char *log_domain, GLogLevelFlags level, const char *message
         break;
     }
 
-    /* we don't need any locking here. The glib log handler gets only registered
-     * once during nm_logging_init() and the global data is not modified afterwards. */
-    nm_assert(gl.imm.init_done);
-
-    if (gl.imm.debug_stderr)
-        g_printerr("%s%s\n", gl.imm.prefix, message ?: "");
+    if (g->debug_stderr)
+        g_printerr("%s%s\n", g->prefix, message ?: "");
 
-    switch (gl.imm.log_backend) {
+    switch (g->log_backend) {
 #if SYSTEMD_JOURNAL
     case LOG_BACKEND_JOURNAL:
     {
-        gint64 now, boottime;
+        gint64 boottime;
 
-        now      = nm_utils_get_monotonic_timestamp_nsec();
-        boottime = nm_utils_monotonic_timestamp_as_boottime(now, 1);
+        boottime = nm_utils_monotonic_timestamp_as_boottime(now_nsec, 1);
 
         sd_journal_send("PRIORITY=%d",
                         syslog_priority,
                         "MESSAGE=%s%s",
-                        gl.imm.prefix,
+                        g->prefix,
                         message ?: "",
-                        syslog_identifier_full(gl.imm.syslog_identifier),
+                        syslog_identifier_full(g->syslog_identifier),
                         "SYSLOG_PID=%ld",
                         (long) getpid(),
                         "SYSLOG_FACILITY=3",
@@ -903,8 +885,8 @@ nm_log_handler(const char *log_domain, GLogLevelFlags level, const char *message
                         "GLIB_LEVEL=%d",
                         (int) (level & G_LOG_LEVEL_MASK),
                         "TIMESTAMP_MONOTONIC=%lld.%06lld",
-                        (long long) (now / NM_UTILS_NSEC_PER_SEC),
-                        (long long) ((now % NM_UTILS_NSEC_PER_SEC) / 1000),
+                        (long long) (now_nsec / NM_UTILS_NSEC_PER_SEC),
+                        (long long) ((now_nsec % NM_UTILS_NSEC_PER_SEC) / 1000),
                         "TIMESTAMP_BOOTTIME=%lld.%06lld",
                         (long long) (boottime / NM_UTILS_NSEC_PER_SEC),
                         (long long) ((boottime % NM_UTILS_NSEC_PER_SEC) / 1000),
@@ -912,11 +894,375 @@ nm_log_handler(const char *log_domain, GLogLevelFlags level, const char *message
     } break;
 #endif
     default:
-        syslog(syslog_priority, "%s%s", gl.imm.prefix, message ?: "");
+        syslog(syslog_priority, "%s%s", g->prefix, message ?: "");
         break;
     }
 }
 
+/*****************************************************************************/
+
+static void
+_log_async_write_dropped(const Global *g, guint n_dropped)
+{
+    char msg[100];
+
+    g_snprintf(msg,
+               sizeof(msg),
+               "logging: %u messages dropped (asynchronous logging queue full)",
+               n_dropped);
+    _log_write(g,
+               LOGL_WARN,
+               LOGD_CORE,
+               0,
+               NULL,
+               NULL,
+               __FILE__,
+               __LINE__,
+               G_STRFUNC,
+               g_get_real_time(),
+               nm_utils_get_monotonic_timestamp_nsec(),
+               msg);
+}
+
+static void
+_log_async_entry_clear(LogAsyncEntry *entry)
+{
+    g_free(entry->ifname);
+    g_free(entry->conn_uuid);
+    g_free(entry->glib_domain);
+    g_free(entry->msg);
+}
+
+static void
+_log_async_write_entries(const Global *g, GArray *entries)
+{
+    guint i;
+
+    for (i = 0; i < entries->len; i++) {
+        LogAsyncEntry *e = &nm_g_array_index(entries, LogAsyncEntry, i);
+
+        if (e->n_dropped > 0)
+            _log_async_write_dropped(g, e->n_dropped);
+        if (e->glib_level != 0)
+            _log_write_glib(g, e->glib_domain, e->glib_level, e->msg, e->now_nsec);
+        else {
+            _log_write(g,
+                       e->level,
+                       e->domain,
+                       e->error,
+                       e->ifname,
+                       e->conn_uuid,
+                       e->file,
+                       e->line,
+                       e->func,
+                       e->tv,
+                       e->now_nsec,
+                       e->msg);
+        }
+        _log_async_entry_clear(e);
+    }
+    g_array_set_size(entries, 0);
+}
+
+static gpointer
+_log_async_thread(gpointer user_data)
+{
+    gs_unref_array GArray *batch = NULL;
+    Global                 g_copy;
+    guint                  n_dropped;
+
+    for (;;) {
+        g_mutex_lock(&gl_async.lock);
+        if (gl_async.busy) {
+            gl_async.busy = FALSE;
+            g_cond_broadcast(&gl_async.idle_cond);
+        }
+        while ((!gl_async.queue || gl_async.queue->len == 0 || gl_async.nmtst_paused)
+               && !gl_async.stop)
+            g_cond_wait(&gl_async.cond, &gl_async.lock);
+
+        /* Take all pending messages at once by swapping the queue with our
+         * drained batch. Producers only contend on the lock for the short
+         * time needed to append an entry. */
+        NM_SWAP(&batch, &gl_async.queue);
+
+        n_dropped = 0;
+        if (!batch || batch->len == 0) {
+            nm_assert(gl_async.stop);
+            n_dropped          = gl_async.n_dropped;
+            gl_async.n_dropped = 0;
+        } else
+            gl_async.busy = TRUE;
+        g_mutex_unlock(&gl_async.lock);
+
+        G_LOCK(log);
+        g_copy = gl.imm;
+        G_UNLOCK(log);
+
+        if (!batch || batch->len == 0) {
+            if (n_dropped > 0)
+                _log_async_write_dropped(&g_copy, n_dropped);
+            return NULL;
+        }
+
+        _log_async_write_entries(&g_copy, batch);
+    }
+}
+
+/* Called before a fatal message, to write out what is still queued. This
+ * may run on any thread, and the process is about to abort. */
+static void
+_log_async_flush(const Global *g)
+{
+    gs_unref_array GArray *entries = NULL;
+
+    if (!g->use_async)
+        return;
+
+    /* Don't block, if the fatal error happened while holding the lock. */
+    if (!g_mutex_trylock(&gl_async.lock))
+        return;
+    entries = g_steal_pointer(&gl_async.queue);
+    g_mutex_unlock(&gl_async.lock);
+
+    if (entries)
+        _log_async_write_entries(g, entries);
+}
+
+/* Append @entry to the queue and take ownership of its strings. Returns
+ * %FALSE, if the writer thread is already stopped. In that case, @entry
+ * is left untouched and the caller must write it synchronously. If the
+ * queue is full, the entry is dropped (and freed). */
+static gboolean
+_log_async_enqueue(LogAsyncEntry *entry)
+{
+    gboolean queued = FALSE;
+
+    g_mutex_lock(&gl_async.lock);
+    if (gl_async.stop) {
+        g_mutex_unlock(&gl_async.lock);
+        return FALSE;
+    }
+    if (gl_async.queue && gl_async.queue->len >= gl_async.queue_limit) {
+        gl_async.n_dropped++;
+        gl_async.n_dropped_total++;
+    } else {
+        if (!gl_async.queue)
+            gl_async.queue = g_array_new(FALSE, FALSE, sizeof(LogAsyncEntry));
+        entry->n_dropped   = gl_async.n_dropped;
+        gl_async.n_dropped = 0;
+        g_array_append_val(gl_async.queue, *entry);
+        if (gl_async.queue->len == 1)
+            g_cond_signal(&gl_async.cond);
+        queued = TRUE;
+    }
+    g_mutex_unlock(&gl_async.lock);
+
+    if (!queued)
+        _log_async_entry_clear(entry);
+    return TRUE;
+}
+
+static gboolean
+_log_async_push(NMLogLevel  level,
+                NMLogDomain domain,
+                int         error,
+                const char *ifname,
+                const char *conn_uuid,
+                const char *file,
+                guint       line,
+                const char *func,
+                gint64      tv,
+                gint64      now_nsec,
+                const char *msg,
+                char      **msg_heap)
+{
+    LogAsyncEntry entry = {
+        .file      = file,
+        .func      = func,
+        .ifname    = g_strdup(ifname),
+        .conn_uuid = g_strdup(conn_uuid),
+        .msg       = *msg_heap ? g_steal_pointer(msg_heap) : g_strdup(msg),
+        .tv        = tv,
+        .now_nsec  = now_nsec,
+        .domain    = domain,
+        .level     = level,
+        .line      = line,
+        .error     = error,
+    };
+
+    if (!_log_async_enqueue(&entry)) {
+        /* the writer is gone. Let the caller write the message synchronously. */
+        g_free(entry.ifname);
+        g_free(entry.conn_uuid);
+        *msg_heap = entry.msg;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean
+_log_async_push_glib(const char *log_domain, GLogLevelFlags level, const char *msg, gint64 now_nsec)
+{
+    LogAsyncEntry entry = {
+        .glib_domain = g_strdup(log_domain),
+        .glib_level  = level,
+        .msg         = g_strdup(msg ?: ""),
+        .now_nsec    = now_nsec,
+    };
+
+    nm_assert(entry.glib_level != 0);
+
+    if (!_log_async_enqueue(&entry)) {
+        _log_async_entry_clear(&entry);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+void
+_nm_log_impl(const char *file,
+             guint       line,
+             const char *func,
+             gboolean    mt_require_locking,
+             NMLogLevel  level,
+             NMLogDomain domain,
+             int         error,
+             const char *ifname,
+             const char *conn_uuid,
+             const char *fmt,
+             ...)
+{
+    char               msg_stack[400];
+    gs_free char      *msg_heap = NULL;
+    const char        *msg;
+    gint64             tv;
+    gint64             now_nsec;
+    int                errsv;
+    const NMLogDomain *cur_log_state;
+    NMLogDomain        cur_log_state_copy[_LOGL_N_REAL];
+    Global             g_copy;
+    const Global      *g;
+
+    if (G_UNLIKELY(mt_require_locking)) {
+        G_LOCK(log);
+        /* we evaluate logging-enabled under lock. There is still a race that
+         * we might log the message below *after* logging was disabled. That means,
+         * when disabling logging, we might still log messages. */
+        if (!_nm_logging_enabled_lockfree(level, domain)) {
+            G_UNLOCK(log);
+            return;
+        }
+        g_copy = gl.imm;
+        memcpy(cur_log_state_copy, _nm_logging_enabled_state, sizeof(cur_log_state_copy));
+        G_UNLOCK(log);
+        g             = &g_copy;
+        cur_log_state = cur_log_state_copy;
+    } else {
+        NM_ASSERT_ON_MAIN_THREAD();
+        if (!_nm_logging_enabled_lockfree(level, domain))
+            return;
+        g             = &gl.imm;
+        cur_log_state = _nm_logging_enabled_state;
+    }
+
+    (void) cur_log_state;
+
+    errsv = errno;
+
+    /* Make sure that %m maps to the specified error */
+    if (error != 0) {
+        if (error < 0)
+            error = -error;
+        errno = error;
+    }
+
+    msg = nm_vsprintf_buf_or_alloc(fmt, fmt, msg_stack, &msg_heap, NULL);
+
+    tv = g_get_real_time();
+
+    /* The monotonic timestamp is only used for structured logging. */
+    now_nsec = 0;
+    if (g->log_backend == LOG_BACKEND_JOURNAL)
+        now_nsec = nm_utils_get_monotonic_timestamp_nsec();
+
+    if (!g->use_async
+        || !_log_async_push(level,
+                            domain,
+                            error,
+                            ifname,
+                            conn_uuid,
+                            file,
+                            line,
+                            func,
+                            tv,
+                            now_nsec,
+                            msg,
+                            &msg_heap)) {
+        if (msg_heap)
+            msg = msg_heap;
+        _log_write(g, level, domain, error, ifname, conn_uuid, file, line, func, tv, now_nsec, msg);
+    }
+
+    errno = errsv;
+}
+
+/*****************************************************************************/
+
+void
+_nm_utils_monotonic_timestamp_initialized(const struct timespec *tp,
+                                          gint64                 offset_sec,
+                                          gboolean               is_boottime)
+{
+    NM_ASSERT_ON_MAIN_THREAD();
+
+    if (_nm_logging_enabled_lockfree(LOGL_DEBUG, LOGD_CORE)) {
+        time_t    now = time(NULL);
+        struct tm tm;
+        char      s[255];
+
+        strftime(s, sizeof(s), "%Y-%m-%d %H:%M:%S", localtime_r(&now, &tm));
+        nm_log_dbg(LOGD_CORE,
+                   "monotonic timestamp started counting 1.%09ld seconds ago with "
+                   "an offset of %lld.0 seconds to %s (local time is %s)",
+                   tp->tv_nsec,
+                   (long long) -offset_sec,
+                   is_boottime ? "CLOCK_BOOTTIME" : "CLOCK_MONOTONIC",
+                   s);
+    }
+}
+
+/*****************************************************************************/
+
+static void
+nm_log_handler(const char *log_domain, GLogLevelFlags level, const char *message, gpointer ignored)
+{
+    gint64 now_nsec;
+
+    /* we don't need any locking here. The glib log handler gets only registered
+     * once during nm_logging_init() and the global data is not modified afterwards.
+     * Only @use_async may change, but _log_async_enqueue() checks under lock
+     * whether the writer thread is still running. */
+    nm_assert(gl.imm.init_done);
+
+    now_nsec = 0;
+    if (gl.imm.log_backend == LOG_BACKEND_JOURNAL)
+        now_nsec = nm_utils_get_monotonic_timestamp_nsec();
+
+    if (level & (G_LOG_FLAG_FATAL | G_LOG_LEVEL_ERROR)) {
+        /* We are about to abort. Don't lose the messages that are still queued. */
+        _log_async_flush(&gl.imm);
+    } else if (gl.imm.use_async && _log_async_push_glib(log_domain, level, message, now_nsec)) {
+        /* Queue the message, so that it does not overtake messages that
+         * are still waiting to be written. */
+        return;
+    }
+
+    _log_write_glib(&gl.imm, log_domain, level, message, now_nsec);
+}
+
 gboolean
 nm_logging_syslog_enabled(void)
 {
@@ -1016,3 +1362,109 @@ nm_logging_init(const char *logging_backend, gboolean debug)
         );
     }
 }
+
+/**
+ * nm_logging_async_start:
+ * @queue_limit: the maximum number of messages that can be pending. Zero
+ *   keeps logging synchronous.
+ *
+ * Hand over writing the messages to a dedicated thread. _nm_log_impl()
+ * then only formats the message and queues it, while the thread drains the
+ * queue in batches to the configured backend. The queue grows on demand up
+ * to @queue_limit messages. When it is full, messages are dropped and their
+ * number gets logged with the next message that fits.
+ *
+ * Call it after nm_logging_init(), which selects the backend. Messages from
+ * the GLib log handler are queued too, so that they keep their order.
+ *
+ * Queued messages are lost if the process crashes or aborts before the
+ * thread wrote them. Only fatal messages from the GLib log handler write
+ * out the queue first. Call nm_logging_async_stop() before exiting.
+ */
+void
+nm_logging_async_start(guint queue_limit)
+{
+    NM_ASSERT_ON_MAIN_THREAD();
+
+    if (queue_limit == 0)
+        return;
+
+    if (gl_async.thread)
+        g_return_if_reached();
+
+    gl_async.queue_limit     = NM_CLAMP(queue_limit, 16u, 1024u * 1024u);
+    gl_async.stop            = FALSE;
+    gl_async.n_dropped_total = 0;
+    gl_async.thread          = g_thread_new("nm-logging", _log_async_thread, NULL);
+
+    nm_log_dbg(LOGD_CORE,
+               "logging: write messages asynchronously (queue limit %u)",
+               gl_async.queue_limit);
+
+    G_LOCK(log);
+    gl.mut.use_async = TRUE;
+    G_UNLOCK(log);
+}
+
+/**
+ * nm_logging_async_stop:
+ *
+ * Write out all pending messages and stop the thread started by
+ * nm_logging_async_start(). Afterwards, logging is synchronous again.
+ */
+void
+nm_logging_async_stop(void)
+{
+    guint64 n_dropped_total;
+
+    NM_ASSERT_ON_MAIN_THREAD();
+
+    if (!gl_async.thread)
+        return;
+
+    G_LOCK(log);
+    gl.mut.use_async = FALSE;
+    G_UNLOCK(log);
+
+    g_mutex_lock(&gl_async.lock);
+    gl_async.stop = TRUE;
+    g_cond_signal(&gl_async.cond);
+    g_mutex_unlock(&gl_async.lock);
+
+    g_thread_join(g_steal_pointer(&gl_async.thread));
+
+    g_mutex_lock(&gl_async.lock);
+    nm_clear_pointer(&gl_async.queue, g_array_unref);
+    n_dropped_total       = gl_async.n_dropped_total;
+    gl_async.busy         = FALSE;
+    gl_async.nmtst_paused = FALSE;
+    g_mutex_unlock(&gl_async.lock);
+
+    if (n_dropped_total > 0)
+        nm_log_dbg(LOGD_CORE,
+                   "logging: %" G_GUINT64_FORMAT " messages were dropped in total",
+                   n_dropped_total);
+}
+
+/**
+ * nmtst_logging_async_set_paused:
+ * @paused: whether the writer thread should hold back the queued messages.
+ *
+ * For testing. While paused, messages pile up in the queue. When unpausing,
+ * this waits until the writer thread wrote all queued messages.
+ * nm_logging_async_stop() writes them regardless.
+ */
+void
+nmtst_logging_async_set_paused(gboolean paused)
+{
+    g_return_if_fail(gl_async.thread);
+
+    g_mutex_lock(&gl_async.lock);
+    gl_async.nmtst_paused = paused;
+    if (!paused) {
+        g_cond_signal(&gl_async.cond);
+        while ((gl_async.queue && gl_async.queue->len > 0) || gl_async.busy)
+            g_cond_wait(&gl_async.idle_cond, &gl_async.lock);
+    }
+    g_mutex_unlock(&gl_async.lock);
+}
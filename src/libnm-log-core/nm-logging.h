@@ -147,6 +147,11 @@ nm_logging_setup(const char *level, const char *domains, char **bad_domains, GEr
 
 void nm_logging_init(const char *logging_backend, gboolean debug);
 
+void nm_logging_async_start(guint queue_limit);
+void nm_logging_async_stop(void);
+
+void nmtst_logging_async_set_paused(gboolean paused);
+
 gboolean nm_logging_syslog_enabled(void);
 
 /*****************************************************************************/
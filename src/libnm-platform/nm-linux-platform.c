@@ -15,6 +15,7 @@
 #include <fcntl.h>
 #include <libudev.h>
 #include <linux/fib_rules.h>
+#include <linux/filter.h>
 #include <linux/ip.h>
 #include <linux/if.h>
 #include <linux/if_bridge.h>
@@ -370,6 +371,31 @@ struct _ifla_vf_vlan_info {
 #define RESYNC_RETRIES         50
 #define RESYNC_BACKOFF_SECONDS 1
 
+/* How often we restart a dump in a row, when kernel reports that the dump
+ * got interrupted (NLM_F_DUMP_INTR). */
+#define DUMP_INTR_RESTARTS_MAX 10
+
+/* The receive buffer of the event sockets grows on demand up to this size. */
+#define NETLINK_RCVBUF_MAX (128 * 1024 * 1024)
+
+/* The maximum number of requests that object_batch() sends with one sendmsg()
+ * before waiting for the responses. Kernel also sends notifications for each
+ * change, and all of them must fit into the receive buffer of the socket. */
+#define OBJECT_BATCH_WINDOW_SIZE 64
+
+/*****************************************************************************/
+
+#define IP_ROUTE_TRACKED_PROTOCOLS                                                        \
+    RTPROT_UNSPEC, RTPROT_REDIRECT, RTPROT_KERNEL, RTPROT_BOOT, RTPROT_STATIC, RTPROT_RA, \
+        RTPROT_DHCP
+
+#define IP_ROUTE_TRACKED_PROTOCOLS_NUM NM_NARG(IP_ROUTE_TRACKED_PROTOCOLS)
+
+#define IP_ROUTE_TRACKED_TYPES \
+    RTN_UNICAST, RTN_LOCAL, RTN_BLACKHOLE, RTN_UNREACHABLE, RTN_PROHIBIT, RTN_THROW
+
+#define IP_ROUTE_TRACKED_TYPES_NUM NM_NARG(IP_ROUTE_TRACKED_TYPES)
+
 /*****************************************************************************/
 
 typedef struct {
@@ -507,6 +533,10 @@ typedef enum _nm_packed {
      * request. */
     WAIT_FOR_NL_RESPONSE_RESULT_FAILED_RESYNC,
 
+    /* The objects changed while kernel was dumping them (NLM_F_DUMP_INTR).
+     * The dump may miss objects and must be restarted. */
+    WAIT_FOR_NL_RESPONSE_RESULT_FAILED_DUMP_INTR,
+
     WAIT_FOR_NL_RESPONSE_RESULT_FAILED_POLL,
     WAIT_FOR_NL_RESPONSE_RESULT_FAILED_TIMEOUT,
     WAIT_FOR_NL_RESPONSE_RESULT_FAILED_DISPOSING,
@@ -535,9 +565,69 @@ typedef struct {
 
 /*****************************************************************************/
 
+/* The maximum number of recent platform events that we remember, see
+ * nm_platform_set_event_history(). */
+#define EVENT_HISTORY_SIZE_MAX 65536
+
+typedef enum _nm_packed {
+    EVENT_TYPE_NONE,
+    EVENT_TYPE_CACHE,
+    EVENT_TYPE_NETLINK,
+} EventType;
+
+/* A recorded platform event. We don't format anything when recording the
+ * event, but keep a reference to the (immutable) objects and a copy of the
+ * netlink header. They only get rendered as text by get_events().
+ *
+ * A removed object is not kept alive by the history. Instead, we keep a
+ * copy of its ID fields, which is all that dump shows about it. */
+typedef struct {
+    gint64    timestamp_msec;
+    EventType type;
+    union {
+        struct {
+            const NMPObject *obj_old;
+            const NMPObject *obj_new;
+            NMPCacheOpsType  cache_op;
+        } cache;
+        struct {
+            /* nl_nlmsghdr_to_str() also looks at the genl header, which
+             * directly follows the netlink header. */
+            struct {
+                struct nlmsghdr   hdr;
+                struct genlmsghdr ghdr;
+            } msg;
+            guint32            pktinfo_group;
+            NMPNetlinkProtocol netlink_protocol;
+        } netlink;
+    };
+} PlatformEvent;
+
+/*****************************************************************************/
+
 typedef struct {
     guint32 nlh_seq_next;
     guint32 nlh_seq_last_seen;
+
+    /* When the socket overflows (ENOBUFS), we don't resync right away. Instead,
+     * we let the burst settle and resync when this timer fires. Further overflows
+     * while the timer is pending are coalesced into the same resync. */
+    GSource *resync_backoff_source;
+
+    guint64 overflow_count;
+    guint64 overflow_coalesced_count;
+    guint64 resync_count;
+
+    guint64 rx_bytes;
+    guint64 rx_messages;
+
+    /* The bytes received since the socket was last drained (EAGAIN). We use it
+     * to grow the socket's receive buffer before it overflows. */
+    gsize burst_bytes;
+
+    /* The receive buffer size of the socket (as passed to SO_RCVBUF). */
+    int  rcvbuf_size;
+    bool rcvbuf_at_limit : 1;
 } NetlinkProtocolPrivData;
 
 typedef struct {
@@ -564,6 +654,13 @@ typedef struct {
 
     guint32 pruning[_REFRESH_ALL_TYPE_NUM];
 
+    struct {
+        /* For tests, treat the next @n dump responses of @nlmsg_type as
+         * interrupted (NLM_F_DUMP_INTR). */
+        guint16 nlmsg_type;
+        guint   n;
+    } nmtst_dump_intr;
+
     GHashTable *sysctl_get_prev_values;
     CList       sysctl_list;
     CList       sysctl_clear_cache_lst;
@@ -579,6 +676,17 @@ typedef struct {
          * by type. */
         int refresh_all_in_progress[_REFRESH_ALL_TYPE_NUM];
 
+        /* how often in a row the dump of a type got restarted, because it
+         * was interrupted. */
+        guint8 dump_intr_restarts[_REFRESH_ALL_TYPE_NUM];
+
+        /* Routes are dumped separately for each protocol in
+         * ip_route_tracked_protocols. For IPv6 and IPv4, these are the sequence
+         * numbers of the last dump of each protocol, and the protocols (as bits of
+         * their index) whose dump got interrupted and must be dumped again. */
+        guint32 route_dump_seq[2][IP_ROUTE_TRACKED_PROTOCOLS_NUM];
+        guint32 route_dump_restart[2];
+
         GPtrArray *list_controller_connected;
         GPtrArray *list_refresh_link;
         union {
@@ -605,6 +713,15 @@ typedef struct {
 
     GenlFamilyData genl_family_data[_NMP_GENL_FAMILY_TYPE_NUM];
 
+    /* A ring buffer with the last @size events. It is disabled while @size
+     * is zero, and otherwise allocated on first use. */
+    struct {
+        PlatformEvent *buf;
+        guint          size;
+        guint          head;
+        guint          len;
+    } event_history;
+
 } NMLinuxPlatformPrivate;
 
 struct _NMLinuxPlatform {
@@ -712,6 +829,7 @@ delayed_action_schedule(NMPlatform *platform, DelayedActionType action_type, gpo
 static gboolean delayed_action_handle_all(NMPlatform *platform);
 static void do_request_link_no_delayed_actions(NMPlatform *platform, int ifindex, const char *name);
 static void do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action_type);
+static void do_request_routes_restart(NMPlatform *platform, int IS_IPv4);
 static void cache_on_change(NMPlatform      *platform,
                             NMPCacheOpsType  cache_op,
                             const NMPObject *obj_old,
@@ -781,6 +899,9 @@ wait_for_nl_response_to_string(WaitForNlResponseResult seq_result,
     case WAIT_FOR_NL_RESPONSE_RESULT_FAILED_RESYNC:
         nm_strbuf_append_str(&buf, &buf_size, "failed-resync");
         break;
+    case WAIT_FOR_NL_RESPONSE_RESULT_FAILED_DUMP_INTR:
+        nm_strbuf_append_str(&buf, &buf_size, "failed-dump-interrupted");
+        break;
     default:
         if (seq_result < 0) {
             nm_strbuf_append(&buf,
@@ -1420,6 +1541,10 @@ typedef struct {
      * the parsing as long as this flag stays TRUE and an object gets returned. */
     bool iter_more;
 
+    /* The message is the response to our RTM_GETROUTE request. We parse it
+     * even if it is a route that we don't track. */
+    bool route_get_reply;
+
     union {
         struct {
             guint next_multihop;
@@ -3967,12 +4092,14 @@ _new_from_nl_addr(const struct nlmsghdr *nlh, gboolean id_only)
     return g_steal_pointer(&obj);
 }
 
-#define IP_ROUTE_TRACKED_PROTOCOLS                                                        \
-    RTPROT_UNSPEC, RTPROT_REDIRECT, RTPROT_KERNEL, RTPROT_BOOT, RTPROT_STATIC, RTPROT_RA, \
-        RTPROT_DHCP
-
 static const guint8 ip_route_tracked_protocols[] = {IP_ROUTE_TRACKED_PROTOCOLS};
 
+G_STATIC_ASSERT(G_N_ELEMENTS(ip_route_tracked_protocols) == IP_ROUTE_TRACKED_PROTOCOLS_NUM);
+
+static const guint8 ip_route_tracked_types[] = {IP_ROUTE_TRACKED_TYPES};
+
+G_STATIC_ASSERT(G_N_ELEMENTS(ip_route_tracked_types) == IP_ROUTE_TRACKED_TYPES_NUM);
+
 static gboolean
 ip_route_is_tracked(guint8 proto, guint8 type)
 {
@@ -3987,13 +4114,7 @@ ip_route_is_tracked(guint8 proto, guint8 type)
         return FALSE;
     }
 
-    if (!NM_IN_SET(type,
-                   RTN_UNICAST,
-                   RTN_LOCAL,
-                   RTN_BLACKHOLE,
-                   RTN_UNREACHABLE,
-                   RTN_PROHIBIT,
-                   RTN_THROW)) {
+    if (!NM_IN_SET(type, IP_ROUTE_TRACKED_TYPES)) {
         /* Certain route types are ignored and not placed into the cache. */
         return FALSE;
     }
@@ -4001,6 +4122,91 @@ ip_route_is_tracked(guint8 proto, guint8 type)
     return TRUE;
 }
 
+static int
+ip_route_attach_socket_filter(struct nl_sock *sk)
+{
+    /* ip_route_is_tracked() drops route notifications that we don't track. On
+     * routers that carry full BGP feeds, that are a lot of messages that we
+     * would receive and parse only to throw them away (or that overflow our socket).
+     *
+     * Let the kernel drop them already. This only looks at notifications, which
+     * come one per datagram. Messages that are addressed to our own port are
+     * responses to our requests (dumps and RTM_GETROUTE). We always accept them,
+     * the route lookup of ip_route_get() also returns routes that we don't
+     * track. Also, we must process all messages with NLM_F_REPLACE, see
+     * _new_from_nl_route().
+     *
+     * The checks for rtm_protocol and rtm_type are generated from
+     * IP_ROUTE_TRACKED_PROTOCOLS and IP_ROUTE_TRACKED_TYPES, so that the filter
+     * always agrees with ip_route_is_tracked(). */
+    enum {
+        IDX_LD_PROTOCOL = 7,
+        IDX_JEQ_PROTOCOL,
+        IDX_LD_TYPE = IDX_JEQ_PROTOCOL + IP_ROUTE_TRACKED_PROTOCOLS_NUM,
+        IDX_JEQ_TYPE,
+        IDX_DROP = IDX_JEQ_TYPE + IP_ROUTE_TRACKED_TYPES_NUM,
+        IDX_ACCEPT,
+        IDX_NUM,
+    };
+#define _JUMP(idx, target) ((guint8) ((target) - ((idx) + 1)))
+    struct sock_filter filter[IDX_NUM] = {
+        /* A <- nlmsg_type */
+        [0] = BPF_STMT(BPF_LD + BPF_H + BPF_ABS, offsetof(struct nlmsghdr, nlmsg_type)),
+        [1] = BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, htobe16(RTM_NEWROUTE), 1, 0),
+        [2] = BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, htobe16(RTM_DELROUTE), 0, _JUMP(2, IDX_ACCEPT)),
+        /* A <- nlmsg_pid */
+        [3] = BPF_STMT(BPF_LD + BPF_W + BPF_ABS, offsetof(struct nlmsghdr, nlmsg_pid)),
+        [4] = BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K,
+                       htobe32(nl_socket_get_local_port(sk)),
+                       _JUMP(4, IDX_ACCEPT),
+                       0),
+        /* A <- nlmsg_flags */
+        [5] = BPF_STMT(BPF_LD + BPF_H + BPF_ABS, offsetof(struct nlmsghdr, nlmsg_flags)),
+        [6] = BPF_JUMP(BPF_JMP + BPF_JSET + BPF_K, htobe16(NLM_F_REPLACE), _JUMP(6, IDX_ACCEPT), 0),
+        /* A <- rtm_protocol, must be one of IP_ROUTE_TRACKED_PROTOCOLS */
+        [IDX_LD_PROTOCOL] = BPF_STMT(BPF_LD + BPF_B + BPF_ABS,
+                                     NLMSG_HDRLEN + offsetof(struct rtmsg, rtm_protocol)),
+        /* A <- rtm_type, must be one of IP_ROUTE_TRACKED_TYPES */
+        [IDX_LD_TYPE] =
+            BPF_STMT(BPF_LD + BPF_B + BPF_ABS, NLMSG_HDRLEN + offsetof(struct rtmsg, rtm_type)),
+        [IDX_DROP]   = BPF_STMT(BPF_RET + BPF_K, 0),
+        [IDX_ACCEPT] = BPF_STMT(BPF_RET + BPF_K, UINT32_MAX),
+    };
+    const struct sock_fprog fprog = {
+        .len    = G_N_ELEMENTS(filter),
+        .filter = filter,
+    };
+    guint i;
+
+    /* BPF jump offsets are only 8 bit. */
+    G_STATIC_ASSERT_EXPR(IDX_NUM <= G_MAXUINT8);
+
+    for (i = 0; i < IP_ROUTE_TRACKED_PROTOCOLS_NUM; i++) {
+        const guint idx = IDX_JEQ_PROTOCOL + i;
+
+        filter[idx] = (struct sock_filter) BPF_JUMP(
+            BPF_JMP + BPF_JEQ + BPF_K,
+            ip_route_tracked_protocols[i],
+            _JUMP(idx, IDX_LD_TYPE),
+            i == IP_ROUTE_TRACKED_PROTOCOLS_NUM - 1 ? _JUMP(idx, IDX_DROP) : 0);
+    }
+
+    for (i = 0; i < IP_ROUTE_TRACKED_TYPES_NUM; i++) {
+        const guint idx = IDX_JEQ_TYPE + i;
+
+        filter[idx] = (struct sock_filter) BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K,
+                                                    ip_route_tracked_types[i],
+                                                    _JUMP(idx, IDX_ACCEPT),
+                                                    0);
+    }
+#undef _JUMP
+
+    if (setsockopt(nl_socket_get_fd(sk), SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) < 0)
+        return -nm_errno_from_native(errno);
+
+    return 0;
+}
+
 /* Copied and heavily modified from libnl3's rtnl_route_parse() and parse_multipath(). */
 static NMPObject *
 _new_from_nl_route(const struct nlmsghdr *nlh, gboolean id_only, ParseNlmsgIter *parse_nlmsg_iter)
@@ -4072,7 +4278,7 @@ _new_from_nl_route(const struct nlmsghdr *nlh, gboolean id_only, ParseNlmsgIter
      * NLM_F_REPLACE. See nmp_cache_update_netlink_route().
      */
     if (!ip_route_is_tracked(rtm->rtm_protocol, rtm->rtm_type)
-        && !(nlh->nlmsg_flags & NLM_F_REPLACE))
+        && !(nlh->nlmsg_flags & NLM_F_REPLACE) && !parse_nlmsg_iter->route_get_reply)
         return NULL;
 
     addr_family = rtm->rtm_family;
@@ -4896,6 +5102,46 @@ nmp_object_new_from_nl(NMPlatform               *platform,
     }
 }
 
+/**
+ * nmtst_linux_platform_new_object_from_nl:
+ * @platform: the platform instance.
+ * @cache: (nullable): the cache to complete the object from.
+ * @nlh: a rtnetlink message.
+ *
+ * Parses @nlh like a received notification. This is only for tests and benchmarks,
+ * which feed synthetic messages to the cache. For multipath IPv6 routes, only the
+ * first next hop gets parsed.
+ *
+ * @platform does not need to be a #NMLinuxPlatform, so that callers can parse
+ * messages without opening netlink sockets. In that case, links whose parsing
+ * needs generic netlink (Wi-Fi, WPAN and WireGuard) are not supported.
+ *
+ * Returns: (nullable): the new object.
+ */
+NMPObject *
+nmtst_linux_platform_new_object_from_nl(NMPlatform            *platform,
+                                        const NMPCache        *cache,
+                                        const struct nlmsghdr *nlh)
+{
+    ParseNlmsgIter           parse_nlmsg_iter;
+    gboolean                 is_del;
+    const struct nl_msg_lite msg = {
+        .nm_protocol = NETLINK_ROUTE,
+        .nm_nlh      = nlh,
+        .nm_size     = NLMSG_ALIGN(nlh->nlmsg_len),
+    };
+
+    g_return_val_if_fail(NM_IS_PLATFORM(platform), NULL);
+
+    parse_nlmsg_iter = (ParseNlmsgIter) {
+        .iter_more = FALSE,
+    };
+
+    is_del = NM_IN_SET(nlh->nlmsg_type, RTM_DELLINK, RTM_DELADDR, RTM_DELROUTE);
+
+    return nmp_object_new_from_nl(platform, cache, &msg, is_del, &parse_nlmsg_iter);
+}
+
 /*****************************************************************************/
 
 static gboolean
@@ -7008,6 +7254,95 @@ delayed_action_refresh_all_in_progress(NMPlatform *platform, DelayedActionType a
     return (priv->delayed_action.refresh_all_in_progress[refresh_all_type] > 0);
 }
 
+static void
+_pruning_drop_interrupted(NMPlatform *platform, RefreshAllType refresh_all_type)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    /* The request of the interrupted dump incremented the pruning counter, and
+     * the restart increments it again. But cache_prune_all() only decrements it
+     * once after handling the delayed actions, so the type would not get pruned.
+     * An interrupted dump must not prune anyway, drop its share. */
+    if (priv->pruning[refresh_all_type] > 0)
+        priv->pruning[refresh_all_type] -= 1;
+}
+
+static void
+delayed_action_refresh_all_done(NMPlatform                         *platform,
+                                DelayedActionWaitForNlResponseData *data,
+                                WaitForNlResponseResult             seq_result)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    RefreshAllType          refresh_all_type;
+    guint8                 *p_restarts;
+
+    nm_assert(data->response_type == DELAYED_ACTION_RESPONSE_TYPE_REFRESH_ALL_IN_PROGRESS);
+    nm_assert(data->response.out_refresh_all_in_progress);
+
+    refresh_all_type =
+        data->response.out_refresh_all_in_progress - priv->delayed_action.refresh_all_in_progress;
+    nm_assert(_NM_INT_NOT_NEGATIVE(refresh_all_type) && refresh_all_type < _REFRESH_ALL_TYPE_NUM);
+
+    *data->response.out_refresh_all_in_progress -= 1;
+    data->response.out_refresh_all_in_progress = NULL;
+
+    p_restarts = &priv->delayed_action.dump_intr_restarts[refresh_all_type];
+
+    if (seq_result != WAIT_FOR_NL_RESPONSE_RESULT_FAILED_DUMP_INTR) {
+        *p_restarts = 0;
+        return;
+    }
+
+    if (data->out_seq_result) {
+        /* The requester waits for the result and restarts the dump itself. */
+        return;
+    }
+
+    if (*p_restarts >= DUMP_INTR_RESTARTS_MAX) {
+        _LOGW("delayed-action: dump of %s interrupted %u times in a row, cache might be "
+              "inconsistent",
+              delayed_action_to_string(delayed_action_type_from_refresh_all_type(refresh_all_type)),
+              (guint) *p_restarts);
+        *p_restarts = 0;
+        return;
+    }
+
+    (*p_restarts)++;
+
+    if (NM_IN_SET(refresh_all_type,
+                  REFRESH_ALL_TYPE_RTNL_IP4_ROUTES,
+                  REFRESH_ALL_TYPE_RTNL_IP6_ROUTES)) {
+        const int IS_IPv4 = (refresh_all_type == REFRESH_ALL_TYPE_RTNL_IP4_ROUTES);
+        guint     i;
+
+        for (i = 0; i < IP_ROUTE_TRACKED_PROTOCOLS_NUM; i++) {
+            if (priv->delayed_action.route_dump_seq[IS_IPv4][i] == data->seq_number)
+                break;
+        }
+        if (i < IP_ROUTE_TRACKED_PROTOCOLS_NUM) {
+            /* The dumps of the other protocols are fine. Only dump the
+             * routes of this protocol again, see do_request_routes_restart(). */
+            _LOGD("delayed-action: dump of IPv%c routes with protocol %u interrupted, restart it",
+                  nm_utils_addr_family_to_char(IS_IPv4 ? AF_INET : AF_INET6),
+                  ip_route_tracked_protocols[i]);
+            if (priv->delayed_action.route_dump_restart[IS_IPv4] == 0)
+                _pruning_drop_interrupted(platform, refresh_all_type);
+            priv->delayed_action.route_dump_restart[IS_IPv4] |= (1u << i);
+            return;
+        }
+    }
+
+    /* The dump may miss objects. Dump again. The objects seen so far still
+     * have their dirty flag cleared, but the new request marks all objects as
+     * dirty again, before we prune. */
+    _LOGD("delayed-action: dump of %s interrupted, restart it",
+          delayed_action_to_string(delayed_action_type_from_refresh_all_type(refresh_all_type)));
+    _pruning_drop_interrupted(platform, refresh_all_type);
+    delayed_action_schedule(platform,
+                            delayed_action_type_from_refresh_all_type(refresh_all_type),
+                            NULL);
+}
+
 static void
 delayed_action_wait_for_response_complete(NMPlatform             *platform,
                                           NMPNetlinkProtocol      netlink_protocol,
@@ -7037,8 +7372,7 @@ delayed_action_wait_for_response_complete(NMPlatform             *platform,
     case DELAYED_ACTION_RESPONSE_TYPE_REFRESH_ALL_IN_PROGRESS:
         if (data->response.out_refresh_all_in_progress) {
             nm_assert(*data->response.out_refresh_all_in_progress > 0);
-            *data->response.out_refresh_all_in_progress -= 1;
-            data->response.out_refresh_all_in_progress = NULL;
+            delayed_action_refresh_all_done(platform, data, seq_result);
         }
         break;
     case DELAYED_ACTION_RESPONSE_TYPE_ROUTE_GET:
@@ -7169,8 +7503,11 @@ delayed_action_handle_one(NMPlatform *platform)
     gpointer                user_data;
     NMPNetlinkProtocol      netlink_protocol;
     DelayedActionType       iflags;
+    int                     IS_IPv4;
 
-    if (priv->delayed_action.flags == DELAYED_ACTION_TYPE_NONE)
+    if (priv->delayed_action.flags == DELAYED_ACTION_TYPE_NONE
+        && !priv->delayed_action.route_dump_restart[0]
+        && !priv->delayed_action.route_dump_restart[1])
         return FALSE;
 
     /* First process DELAYED_ACTION_TYPE_CONTROLLER_CONNECTED actions.
@@ -7238,6 +7575,15 @@ delayed_action_handle_one(NMPlatform *platform)
         return TRUE;
     }
 
+    /* Interrupted route dumps only get restarted for their protocol. This comes
+     * after the refresh-all actions, which would dump all protocols anyway. */
+    for (IS_IPv4 = 1; IS_IPv4 >= 0; IS_IPv4--) {
+        if (priv->delayed_action.route_dump_restart[IS_IPv4]) {
+            do_request_routes_restart(platform, IS_IPv4);
+            return TRUE;
+        }
+    }
+
     if (NM_FLAGS_HAS(priv->delayed_action.flags, DELAYED_ACTION_TYPE_REFRESH_LINK)) {
         nm_assert(priv->delayed_action.list_refresh_link->len > 0);
 
@@ -7462,6 +7808,164 @@ cache_prune_all(NMPlatform *platform)
     }
 }
 
+static void
+_event_clear(PlatformEvent *event)
+{
+    if (event->type == EVENT_TYPE_CACHE) {
+        nmp_object_unref(event->cache.obj_old);
+        nmp_object_unref(event->cache.obj_new);
+    }
+    event->type = EVENT_TYPE_NONE;
+}
+
+static PlatformEvent *
+_event_history_add(NMPlatform *platform, EventType type)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    PlatformEvent          *event;
+
+    if (priv->event_history.size == 0)
+        return NULL;
+
+    if (G_UNLIKELY(!priv->event_history.buf))
+        priv->event_history.buf = g_new0(PlatformEvent, priv->event_history.size);
+
+    if (priv->event_history.len < priv->event_history.size) {
+        event = &priv->event_history.buf[(priv->event_history.head + priv->event_history.len)
+                                         % priv->event_history.size];
+        priv->event_history.len++;
+    } else {
+        /* the ring is full. Overwrite the oldest entry. */
+        event                    = &priv->event_history.buf[priv->event_history.head];
+        priv->event_history.head = (priv->event_history.head + 1) % priv->event_history.size;
+        _event_clear(event);
+    }
+
+    event->timestamp_msec = nm_utils_get_monotonic_timestamp_msec();
+    event->type           = type;
+    return event;
+}
+
+static void
+_event_history_clear(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    guint                   i;
+
+    if (!priv->event_history.buf)
+        return;
+
+    for (i = 0; i < priv->event_history.size; i++)
+        _event_clear(&priv->event_history.buf[i]);
+    nm_clear_g_free(&priv->event_history.buf);
+    priv->event_history.head = 0;
+    priv->event_history.len  = 0;
+}
+
+static void
+set_event_history(NMPlatform *platform, guint size)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    size = NM_MIN(size, (guint) EVENT_HISTORY_SIZE_MAX);
+    if (size == priv->event_history.size)
+        return;
+
+    _event_history_clear(platform);
+    priv->event_history.size = size;
+}
+
+static const char *
+_cache_op_to_string(NMPCacheOpsType cache_op)
+{
+    switch (cache_op) {
+    case NMP_CACHE_OPS_UPDATED:
+        return "UPDATE";
+    case NMP_CACHE_OPS_REMOVED:
+        return "REMOVE";
+    case NMP_CACHE_OPS_ADDED:
+        return "ADD";
+    default:
+        return "???";
+    }
+}
+
+static char **
+get_events(NMPlatform *platform, gint64 max_age_msec)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    GPtrArray              *lines;
+    gint64                  now_msec;
+    guint                   i;
+
+    lines    = g_ptr_array_new();
+    now_msec = nm_utils_get_monotonic_timestamp_msec();
+
+    for (i = 0; i < priv->event_history.len; i++) {
+        const PlatformEvent *event =
+            &priv->event_history.buf[(priv->event_history.head + i) % priv->event_history.size];
+        const gint64 age_msec = now_msec - event->timestamp_msec;
+        char         str_buf[NM_UTILS_TO_STRING_BUFFER_SIZE];
+        char         str_buf2[NM_UTILS_TO_STRING_BUFFER_SIZE];
+
+        if (max_age_msec >= 0 && age_msec > max_age_msec)
+            continue;
+
+        switch (event->type) {
+        case EVENT_TYPE_CACHE:
+        {
+            const NMPCacheOpsType cache_op = event->cache.cache_op;
+            const NMPObject      *obj      = event->cache.obj_old ?: event->cache.obj_new;
+
+            g_ptr_array_add(
+                lines,
+                g_strdup_printf(
+                    "event[-%" G_GINT64_FORMAT ".%03d]: update-cache-%s: %s: %s%s%s",
+                    age_msec / 1000,
+                    (int) (age_msec % 1000),
+                    NMP_OBJECT_GET_CLASS(obj)->obj_type_name,
+                    _cache_op_to_string(cache_op),
+                    nmp_object_to_string(obj,
+                                         cache_op == NMP_CACHE_OPS_REMOVED
+                                             ? NMP_OBJECT_TO_STRING_ID
+                                             : NMP_OBJECT_TO_STRING_ALL,
+                                         str_buf2,
+                                         sizeof(str_buf2)),
+                    (cache_op == NMP_CACHE_OPS_UPDATED) ? " -> " : "",
+                    (cache_op == NMP_CACHE_OPS_UPDATED)
+                        ? nmp_object_to_string(event->cache.obj_new,
+                                               NMP_OBJECT_TO_STRING_ALL,
+                                               str_buf,
+                                               sizeof(str_buf))
+                        : ""));
+            break;
+        }
+        case EVENT_TYPE_NETLINK:
+            g_ptr_array_add(
+                lines,
+                g_strdup_printf(
+                    "event[-%" G_GINT64_FORMAT ".%03d]: %s: recvmsg: %s",
+                    age_msec / 1000,
+                    (int) (age_msec % 1000),
+                    nmp_netlink_protocol_info(event->netlink.netlink_protocol)->name,
+                    nl_nlmsghdr_to_str(
+                        nmp_netlink_protocol_info(event->netlink.netlink_protocol)
+                            ->netlink_protocol,
+                        event->netlink.pktinfo_group,
+                        &event->netlink.msg.hdr,
+                        str_buf,
+                        sizeof(str_buf))));
+            break;
+        default:
+            nm_assert_not_reached();
+            break;
+        }
+    }
+
+    g_ptr_array_add(lines, NULL);
+    return (char **) g_ptr_array_free(lines, FALSE);
+}
+
 static void
 cache_on_change(NMPlatform      *platform,
                 NMPCacheOpsType  cache_op,
@@ -7469,6 +7973,7 @@ cache_on_change(NMPlatform      *platform,
                 const NMPObject *obj_new)
 {
     const NMPClass *klass;
+    PlatformEvent  *event;
     char            str_buf[NM_UTILS_TO_STRING_BUFFER_SIZE];
     char            str_buf2[NM_UTILS_TO_STRING_BUFFER_SIZE];
     NMPCache       *cache = nm_platform_get_cache(platform);
@@ -7478,13 +7983,18 @@ cache_on_change(NMPlatform      *platform,
 
     klass = obj_old ? NMP_OBJECT_GET_CLASS(obj_old) : NMP_OBJECT_GET_CLASS(obj_new);
 
+    event = _event_history_add(platform, EVENT_TYPE_CACHE);
+    if (event) {
+        event->cache.obj_old  = cache_op == NMP_CACHE_OPS_REMOVED ? nmp_object_clone(obj_old, TRUE)
+                                                                  : nmp_object_ref(obj_old);
+        event->cache.obj_new  = nmp_object_ref(obj_new);
+        event->cache.cache_op = cache_op;
+    }
+
     _LOGt(
         "update-cache-%s: %s: %s%s%s",
         klass->obj_type_name,
-        (cache_op == NMP_CACHE_OPS_UPDATED ? "UPDATE"
-                                           : (cache_op == NMP_CACHE_OPS_REMOVED   ? "REMOVE"
-                                              : (cache_op == NMP_CACHE_OPS_ADDED) ? "ADD"
-                                                                                  : "???")),
+        _cache_op_to_string(cache_op),
         (cache_op != NMP_CACHE_OPS_ADDED
              ? nmp_object_to_string(obj_old, NMP_OBJECT_TO_STRING_ALL, str_buf2, sizeof(str_buf2))
              : nmp_object_to_string(obj_new, NMP_OBJECT_TO_STRING_ALL, str_buf2, sizeof(str_buf2))),
@@ -7849,6 +8359,94 @@ _netlink_send_nlmsg_rtnl(NMPlatform              *platform,
                                NULL);
 }
 
+/**
+ * _netlink_send_nlmsg_rtnl_batch:
+ * @platform: the #NMPlatform instance.
+ * @nlmsgs: the netlink requests to send.
+ * @n_nlmsgs: the number of requests in @nlmsgs. At most %OBJECT_BATCH_WINDOW_SIZE.
+ * @out_seq_results: an array of @n_nlmsgs results.
+ * @out_extack_msgs: (nullable): an array of @n_nlmsgs extack messages.
+ *
+ * Like _netlink_send_nlmsg_rtnl(), but sends all requests with one sendmsg() call.
+ * Kernel processes the requests in order and replies to each of them individually,
+ * so the result for each sequence number still gets tracked separately.
+ *
+ * Returns: 0 on success or a negative error code. On failure, no request
+ *   was sent.
+ */
+static int
+_netlink_send_nlmsg_rtnl_batch(NMPlatform              *platform,
+                               struct nl_msg *const    *nlmsgs,
+                               guint                    n_nlmsgs,
+                               WaitForNlResponseResult *out_seq_results,
+                               char                   **out_extack_msgs)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    struct iovec            iov[OBJECT_BATCH_WINDOW_SIZE];
+    guint32                 seqs[OBJECT_BATCH_WINDOW_SIZE];
+    guint                   i;
+
+    nm_assert(n_nlmsgs > 0 && n_nlmsgs <= OBJECT_BATCH_WINDOW_SIZE);
+
+    for (i = 0; i < n_nlmsgs; i++) {
+        struct nlmsghdr *nlhdr = nlmsg_hdr(nlmsgs[i]);
+
+        nm_assert(out_seq_results[i] == WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN);
+
+        /* The messages get concatenated in one datagram. Each message must
+         * start aligned. */
+        nm_assert(nlhdr->nlmsg_len == NLMSG_ALIGN(nlhdr->nlmsg_len));
+
+        seqs[i]          = _nlh_seq_next_get(priv, NMP_NETLINK_ROUTE);
+        nlhdr->nlmsg_seq = seqs[i];
+        if (!nlhdr->nlmsg_pid)
+            nlhdr->nlmsg_pid = nl_socket_get_local_port(priv->sk_rtnl);
+        nlhdr->nlmsg_flags |= (NLM_F_REQUEST | NLM_F_ACK);
+
+        iov[i] = (struct iovec) {
+            .iov_base = nlhdr,
+            .iov_len  = nlhdr->nlmsg_len,
+        };
+    }
+
+    {
+        struct sockaddr_nl nladdr = {
+            .nl_family = AF_NETLINK,
+        };
+        struct msghdr msg = {
+            .msg_name    = &nladdr,
+            .msg_namelen = sizeof(nladdr),
+            .msg_iov     = iov,
+            .msg_iovlen  = n_nlmsgs,
+        };
+        int try_count = 0;
+
+again:
+        if (sendmsg(nl_socket_get_fd(priv->sk_rtnl), &msg, 0) < 0) {
+            int errsv = errno;
+
+            if (errsv == EINTR && try_count++ < 100)
+                goto again;
+            _LOGI("netlink: nl-send-nlmsg-batch: failed sending %u messages: %s (%d)",
+                  n_nlmsgs,
+                  nm_strerror_native(errsv),
+                  errsv);
+            return -nm_errno_from_native(errsv);
+        }
+    }
+
+    for (i = 0; i < n_nlmsgs; i++) {
+        delayed_action_schedule_WAIT_FOR_RESPONSE(platform,
+                                                  NMP_NETLINK_ROUTE,
+                                                  seqs[i],
+                                                  &out_seq_results[i],
+                                                  out_extack_msgs ? &out_extack_msgs[i] : NULL,
+                                                  DELAYED_ACTION_RESPONSE_TYPE_VOID,
+                                                  NULL);
+    }
+    return 0;
+}
+
 static void
 do_request_link_no_delayed_actions(NMPlatform *platform, int ifindex, const char *name)
 {
@@ -7992,6 +8590,123 @@ _nl_msg_new_dump_genl_families(void)
     return g_steal_pointer(&nlmsg);
 }
 
+static void
+do_request_routes(NMPlatform *platform, RefreshAllType refresh_all_type, guint32 protocols)
+{
+    NMLinuxPlatformPrivate *priv             = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    const RefreshAllInfo   *refresh_all_info = refresh_all_type_get_info(refresh_all_type);
+    const int               IS_IPv4     = (refresh_all_type == REFRESH_ALL_TYPE_RTNL_IP4_ROUTES);
+    guint                   retry_count = 0;
+    int                    *out_refresh_all_in_progress;
+    struct rtmsg            rtm;
+    guint                   i;
+
+    nm_assert(NM_IN_SET(refresh_all_type,
+                        REFRESH_ALL_TYPE_RTNL_IP4_ROUTES,
+                        REFRESH_ALL_TYPE_RTNL_IP6_ROUTES));
+
+    out_refresh_all_in_progress = &priv->delayed_action.refresh_all_in_progress[refresh_all_type];
+
+    rtm = (struct rtmsg) {
+        .rtm_family = refresh_all_info->addr_family_for_dump,
+    };
+
+    /* Routes are handled specially because we want to request only routes
+     * for protocols we track. The reason is that there might be millions of
+     * BGP routes we don't track and it would be very inefficient to dump them
+     * all. Therefore, perform separate dumps, each for a specific protocol we
+     * track. */
+    for (i = 0; i < IP_ROUTE_TRACKED_PROTOCOLS_NUM; i++) {
+        nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+
+        if (retry_count > 0) {
+            /* Try again previous protocol */
+            i--;
+        }
+
+        if (!NM_FLAGS_ANY(protocols, 1u << i))
+            continue;
+
+        /* If we try to request a new dump while the previous is still
+         * in progress, kernel returns -EBUSY. Complete the previous
+         * dump by reading from the socket. */
+        event_handler_read_netlink(platform, refresh_all_info->protocol, FALSE);
+
+        nlmsg = nlmsg_alloc_new(0, RTM_GETROUTE, NLM_F_DUMP);
+
+        rtm.rtm_protocol = ip_route_tracked_protocols[i];
+
+        if (nlmsg_append_struct(nlmsg, &rtm) < 0)
+            g_return_if_reached();
+
+        *out_refresh_all_in_progress += 1;
+
+        if (_netlink_send_nlmsg(platform,
+                                refresh_all_info->protocol,
+                                nlmsg,
+                                NULL,
+                                NULL,
+                                DELAYED_ACTION_RESPONSE_TYPE_REFRESH_ALL_IN_PROGRESS,
+                                out_refresh_all_in_progress)
+            < 0) {
+            *out_refresh_all_in_progress -= 1;
+            retry_count++;
+            if (retry_count > 4) {
+                _LOGE("failed dumping IPv%c routes with protocol %u, cache might be "
+                      "inconsistent",
+                      nm_utils_addr_family_to_char(rtm.rtm_family),
+                      rtm.rtm_protocol);
+                retry_count = 0;
+                /* Give up and try the next protocol */
+            }
+        } else {
+            priv->delayed_action.route_dump_seq[IS_IPv4][i] = nlmsg_hdr(nlmsg)->nlmsg_seq;
+            retry_count = 0;
+        }
+    }
+}
+
+static void
+do_request_routes_restart(NMPlatform *platform, int IS_IPv4)
+{
+    NMLinuxPlatformPrivate *priv  = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    NMPCache               *cache = nm_platform_get_cache(platform);
+    const RefreshAllType    refresh_all_type =
+        IS_IPv4 ? REFRESH_ALL_TYPE_RTNL_IP4_ROUTES : REFRESH_ALL_TYPE_RTNL_IP6_ROUTES;
+    const guint32    protocols = priv->delayed_action.route_dump_restart[IS_IPv4];
+    NMDedupMultiIter iter;
+    NMPLookup        lookup;
+
+    nm_assert(protocols != 0);
+
+    priv->delayed_action.route_dump_restart[IS_IPv4] = 0;
+
+    _LOGt_delayed_action(delayed_action_type_from_refresh_all_type(refresh_all_type),
+                         NULL,
+                         "handle (restart interrupted protocols)");
+
+    /* Only the routes of the interrupted protocols might be missing from the
+     * last dump. Only they get marked as dirty and can get pruned. */
+    priv->pruning[refresh_all_type] += 1;
+    nmp_lookup_init_obj_type(&lookup, NMP_OBJECT_TYPE_IP_ROUTE(IS_IPv4));
+    nm_dedup_multi_iter_init(&iter, nmp_cache_lookup(cache, &lookup));
+    while (nm_dedup_multi_iter_next(&iter)) {
+        const guint8 rtprot = nmp_utils_ip_config_source_coerce_to_rtprot(
+            NMP_OBJECT_CAST_IP_ROUTE(iter.current->obj)->rt_source);
+        guint i;
+
+        for (i = 0; i < IP_ROUTE_TRACKED_PROTOCOLS_NUM; i++) {
+            if (ip_route_tracked_protocols[i] == rtprot) {
+                if (NM_FLAGS_ANY(protocols, 1u << i))
+                    nm_dedup_multi_entry_set_dirty(iter.current, TRUE);
+                break;
+            }
+        }
+    }
+
+    do_request_routes(platform, refresh_all_type, protocols);
+}
+
 static void
 do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action_type)
 {
@@ -8060,66 +8775,17 @@ do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action
             }
         }
 
-        /* Routes are handled specially because we want to request only routes
-         * for protocols we track. The reason is that there might be millions of
-         * BGP routes we don't track and it would be very inefficient to dump them
-         * all. Therefore, perform separate dumps, each for a specific protocol we
-         * track. */
         if (NM_IN_SET(refresh_all_type,
                       REFRESH_ALL_TYPE_RTNL_IP4_ROUTES,
                       REFRESH_ALL_TYPE_RTNL_IP6_ROUTES)) {
-            struct rtmsg rtm = {
-                .rtm_family = refresh_all_info->addr_family_for_dump,
-            };
-            guint retry_count = 0;
-            guint i;
-
-            for (i = 0; i < G_N_ELEMENTS(ip_route_tracked_protocols); i++) {
-                nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
-
-                if (retry_count > 0) {
-                    /* Try again previous protocol */
-                    i--;
-                }
-
-                /* If we try to request a new dump while the previous is still
-                 * in progress, kernel returns -EBUSY. Complete the previous
-                 * dump by reading from the socket. */
-                event_handler_read_netlink(platform, refresh_all_info->protocol, FALSE);
-
-                nlmsg = nlmsg_alloc_new(0, RTM_GETROUTE, NLM_F_DUMP);
-                if (!nlmsg)
-                    goto next_after_fail;
-
-                rtm.rtm_protocol = ip_route_tracked_protocols[i];
-
-                if (nlmsg_append_struct(nlmsg, &rtm) < 0)
-                    g_return_if_fail(FALSE);
-
-                *out_refresh_all_in_progress += 1;
-
-                if (_netlink_send_nlmsg(platform,
-                                        refresh_all_info->protocol,
-                                        nlmsg,
-                                        NULL,
-                                        NULL,
-                                        DELAYED_ACTION_RESPONSE_TYPE_REFRESH_ALL_IN_PROGRESS,
-                                        out_refresh_all_in_progress)
-                    < 0) {
-                    *out_refresh_all_in_progress -= 1;
-                    retry_count++;
-                    if (retry_count > 4) {
-                        _LOGE("failed dumping IPv%c routes with protocol %u, cache might be "
-                              "inconsistent",
-                              nm_utils_addr_family_to_char(rtm.rtm_family),
-                              rtm.rtm_protocol);
-                        retry_count = 0;
-                        /* Give up and try the next protocol */
-                    }
-                } else {
-                    retry_count = 0;
-                }
-            }
+            const int IS_IPv4 = (refresh_all_type == REFRESH_ALL_TYPE_RTNL_IP4_ROUTES);
+
+            /* This dumps all protocols, so pending restarts of single protocols
+             * are covered too. */
+            priv->delayed_action.route_dump_restart[IS_IPv4] = 0;
+            do_request_routes(platform,
+                              refresh_all_type,
+                              (1u << IP_ROUTE_TRACKED_PROTOCOLS_NUM) - 1u);
         } else {
             nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
 
@@ -8155,11 +8821,111 @@ next_after_fail:
     }
 }
 
+static void
+do_request_addresses_by_ifindex(NMPlatform *platform, NMPObjectType obj_type, int ifindex)
+{
+    NMLinuxPlatformPrivate *priv        = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    WaitForNlResponseResult seq_result  = WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN;
+    const int               addr_family = NMP_OBJECT_TYPE_TO_ADDR_FAMILY(obj_type);
+    RefreshAllType          refresh_all_type;
+    int                    *out_refresh_all_in_progress;
+    NMPLookup               lookup;
+    guint                   try_count = 0;
+
+    nm_assert(NM_IN_SET(obj_type, NMP_OBJECT_TYPE_IP4_ADDRESS, NMP_OBJECT_TYPE_IP6_ADDRESS));
+    nm_assert(ifindex > 0);
+
+    refresh_all_type = addr_family == AF_INET ? REFRESH_ALL_TYPE_RTNL_IP4_ADDRESSES
+                                              : REFRESH_ALL_TYPE_RTNL_IP6_ADDRESSES;
+
+    out_refresh_all_in_progress = &priv->delayed_action.refresh_all_in_progress[refresh_all_type];
+
+    nmp_lookup_init_object_by_ifindex(&lookup, obj_type, ifindex);
+
+    do {
+        nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+
+        _LOGD("do-request-addresses: IPv%c, ifindex %d%s",
+              nm_utils_addr_family_to_char(addr_family),
+              ifindex,
+              try_count > 0 ? " (dump interrupted, retry)" : "");
+
+        /* Only mark the addresses of this interface as dirty. They get pruned below,
+         * unless the dump sees them again. */
+        nmp_cache_dirty_set_all_main(nm_platform_get_cache(platform), &lookup);
+
+        event_handler_read_netlink(platform, NMP_NETLINK_ROUTE, FALSE);
+
+        nlmsg = nlmsg_alloc_new(0, RTM_GETADDR, NLM_F_DUMP);
+
+        {
+            const struct ifaddrmsg ifm = {
+                .ifa_family = addr_family,
+                .ifa_index  = ifindex,
+            };
+
+            /* With NETLINK_GET_STRICT_CHK, kernel only dumps the addresses of @ifindex.
+             * Older kernels ignore the filter and dump all addresses, which is only
+             * slower. */
+            if (nlmsg_append_struct(nlmsg, &ifm) < 0)
+                g_return_if_reached();
+        }
+
+        seq_result = WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN;
+        *out_refresh_all_in_progress += 1;
+        if (_netlink_send_nlmsg(platform,
+                                NMP_NETLINK_ROUTE,
+                                nlmsg,
+                                &seq_result,
+                                NULL,
+                                DELAYED_ACTION_RESPONSE_TYPE_REFRESH_ALL_IN_PROGRESS,
+                                out_refresh_all_in_progress)
+            < 0) {
+            *out_refresh_all_in_progress -= 1;
+            _LOGE("do-request-addresses: IPv%c, ifindex %d: failed sending netlink request",
+                  nm_utils_addr_family_to_char(addr_family),
+                  ifindex);
+            return;
+        }
+
+        delayed_action_handle_all(platform);
+
+        /* If the addresses changed while kernel was dumping them, the dump
+         * might lack some of them. Don't prune based on such a dump, but
+         * dump again. */
+    } while (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_FAILED_DUMP_INTR
+             && ++try_count < DUMP_INTR_RESTARTS_MAX);
+
+    /* On failure, the dirty flags stay set. That is harmless, they only have
+     * an effect if a dump of the same type gets pruned, and that sets all
+     * flags anew. */
+    if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK)
+        cache_prune_one_type(platform, &lookup);
+}
+
 static void
 do_request_one_type_by_needle_object(NMPlatform *platform, const NMPObject *obj_needle)
 {
-    do_request_all_no_delayed_actions(platform,
-                                      delayed_action_refresh_from_needle_object(obj_needle));
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    DelayedActionType       action_type;
+
+    action_type = delayed_action_refresh_from_needle_object(obj_needle);
+
+    if (NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_needle),
+                  NMP_OBJECT_TYPE_IP4_ADDRESS,
+                  NMP_OBJECT_TYPE_IP6_ADDRESS)
+        && NMP_OBJECT_CAST_IP_ADDRESS(obj_needle)->ifindex > 0
+        && !NM_FLAGS_ANY(priv->delayed_action.flags, action_type)) {
+        /* Refetching all addresses is expensive on hosts with many interfaces.
+         * We only care about the interface of the needle, so only dump (and prune)
+         * its addresses. */
+        do_request_addresses_by_ifindex(platform,
+                                        NMP_OBJECT_GET_TYPE(obj_needle),
+                                        NMP_OBJECT_CAST_IP_ADDRESS(obj_needle)->ifindex);
+        return;
+    }
+
+    do_request_all_no_delayed_actions(platform, action_type);
     delayed_action_handle_all(platform);
 }
 
@@ -8188,8 +8954,7 @@ event_seq_check_refresh_all(NMPlatform        *platform,
         if (data->response_type == DELAYED_ACTION_RESPONSE_TYPE_REFRESH_ALL_IN_PROGRESS
             && data->response.out_refresh_all_in_progress
             && data->seq_number == priv->proto_data_x[netlink_protocol].nlh_seq_last_seen) {
-            *data->response.out_refresh_all_in_progress -= 1;
-            data->response.out_refresh_all_in_progress = NULL;
+            delayed_action_refresh_all_done(platform, data, data->seq_result);
             break;
         }
     }
@@ -8227,7 +8992,8 @@ event_seq_check(NMPlatform             *platform,
 
         /* We potentially receive many parts partial responses for the same sequence number.
          * Thus, we only remember the result, and collect it later. */
-        if (data->seq_result < 0) {
+        if (data->seq_result < 0
+            || data->seq_result == WAIT_FOR_NL_RESPONSE_RESULT_FAILED_DUMP_INTR) {
             /* we already saw an error for this sequence number.
              * Preserve it. */
         } else if (seq_result != WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_UNKNOWN
@@ -8241,6 +9007,30 @@ event_seq_check(NMPlatform             *platform,
     }
 }
 
+static gboolean
+_rtnl_is_route_get_reply(NMPlatform *platform, const struct nlmsghdr *msghdr)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    guint                   i;
+
+    if (msghdr->nlmsg_type != RTM_NEWROUTE || msghdr->nlmsg_seq == 0
+        || NM_FLAGS_HAS(msghdr->nlmsg_flags, NLM_F_MULTI))
+        return FALSE;
+
+    if (!NM_FLAGS_HAS(priv->delayed_action.flags, DELAYED_ACTION_TYPE_WAIT_FOR_RESPONSE_RTNL))
+        return FALSE;
+
+    for (i = 0; i < priv->delayed_action.list_wait_for_response_rtnl->len; i++) {
+        const DelayedActionWaitForNlResponseData *data =
+            delayed_action_get_list_wait_for_resonse(priv, NMP_NETLINK_ROUTE, i);
+
+        if (data->response_type == DELAYED_ACTION_RESPONSE_TYPE_ROUTE_GET
+            && data->seq_number == msghdr->nlmsg_seq)
+            return TRUE;
+    }
+    return FALSE;
+}
+
 static void
 _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
 {
@@ -8270,7 +9060,8 @@ _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
     }
 
     parse_nlmsg_iter = (ParseNlmsgIter) {
-        .iter_more = FALSE,
+        .iter_more       = FALSE,
+        .route_get_reply = _rtnl_is_route_get_reply(platform, msghdr),
     };
 
     obj = nmp_object_new_from_nl(platform, cache, msg, is_del, &parse_nlmsg_iter);
@@ -8355,6 +9146,15 @@ _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
                 }
             }
 
+            if (parse_nlmsg_iter.route_get_reply) {
+                const struct rtmsg *rtm = nlmsg_data(msghdr);
+
+                /* The caller got the result of the route lookup. Don't add
+                 * untracked routes to the cache. */
+                if (!ip_route_is_tracked(rtm->rtm_protocol, rtm->rtm_type))
+                    return;
+            }
+
             route_is_alive = ip_route_is_alive(NMP_OBJECT_CAST_IP_ROUTE(obj));
 
             cache_op = nmp_cache_update_netlink_route(cache,
@@ -8586,6 +9386,36 @@ do_add_addrroute(NMPlatform      *platform,
     return wait_for_nl_response_to_nmerr(seq_result);
 }
 
+static gboolean
+_delete_object_result_is_success(const NMPObject        *obj_id,
+                                 WaitForNlResponseResult seq_result,
+                                 const char            **out_log_detail)
+{
+    const char *log_detail = "";
+    gboolean    success    = TRUE;
+
+    if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK) {
+        /* ok */
+    } else if (NM_IN_SET(-((int) seq_result), ESRCH, ENOENT))
+        log_detail = ", meaning the object was already removed";
+    else if (NM_IN_SET(-((int) seq_result), ENXIO)
+             && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id), NMP_OBJECT_TYPE_IP6_ADDRESS)) {
+        /* On RHEL7 kernel, deleting a non existing address fails with ENXIO */
+        log_detail = ", meaning the address was already removed";
+    } else if (NM_IN_SET(-((int) seq_result), ENODEV)) {
+        log_detail = ", meaning the device was already removed";
+    } else if (NM_IN_SET(-((int) seq_result), EADDRNOTAVAIL)
+               && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id),
+                            NMP_OBJECT_TYPE_IP4_ADDRESS,
+                            NMP_OBJECT_TYPE_IP6_ADDRESS))
+        log_detail = ", meaning the address was already removed";
+    else
+        success = FALSE;
+
+    NM_SET_OUT(out_log_detail, log_detail);
+    return success;
+}
+
 static gboolean
 do_delete_object(NMPlatform *platform, const NMPObject *obj_id, struct nl_msg *nlmsg)
 {
@@ -8616,24 +9446,7 @@ do_delete_object(NMPlatform *platform, const NMPObject *obj_id, struct nl_msg *n
 
         nm_assert(seq_result != WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN);
 
-        success = TRUE;
-        if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK) {
-            /* ok */
-        } else if (NM_IN_SET(-((int) seq_result), ESRCH, ENOENT))
-            log_detail = ", meaning the object was already removed";
-        else if (NM_IN_SET(-((int) seq_result), ENXIO)
-                 && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id), NMP_OBJECT_TYPE_IP6_ADDRESS)) {
-            /* On RHEL7 kernel, deleting a non existing address fails with ENXIO */
-            log_detail = ", meaning the address was already removed";
-        } else if (NM_IN_SET(-((int) seq_result), ENODEV)) {
-            log_detail = ", meaning the device was already removed";
-        } else if (NM_IN_SET(-((int) seq_result), EADDRNOTAVAIL)
-                   && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id),
-                                NMP_OBJECT_TYPE_IP4_ADDRESS,
-                                NMP_OBJECT_TYPE_IP6_ADDRESS))
-            log_detail = ", meaning the address was already removed";
-        else
-            success = FALSE;
+        success = _delete_object_result_is_success(obj_id, seq_result, &log_detail);
 
         _NMLOG(success ? LOGL_DEBUG : LOGL_WARN,
                "do-delete-%s[%s]: %s%s",
@@ -10762,6 +11575,213 @@ object_delete(NMPlatform *platform, const NMPObject *obj)
     return do_delete_object(platform, obj, nlmsg);
 }
 
+static struct nl_msg *
+_nl_msg_new_batch_op(const NMPlatformObjBatchOp *op)
+{
+    const NMPObject *obj = op->obj;
+
+    switch (NMP_OBJECT_GET_TYPE(obj)) {
+    case NMP_OBJECT_TYPE_IP4_ROUTE:
+    case NMP_OBJECT_TYPE_IP6_ROUTE:
+        if (op->is_delete)
+            return _nl_msg_new_route(RTM_DELROUTE, 0, obj);
+        return _nl_msg_new_route(RTM_NEWROUTE, op->nlm_flags & NMP_NLM_FLAG_FMASK, obj);
+    default:
+        break;
+    }
+
+    /* Besides routes, we only batch deletions. */
+    if (!op->is_delete)
+        return NULL;
+
+    switch (NMP_OBJECT_GET_TYPE(obj)) {
+    case NMP_OBJECT_TYPE_IP4_ADDRESS:
+        return _nl_msg_new_address(RTM_DELADDR,
+                                   0,
+                                   AF_INET,
+                                   obj->ip4_address.ifindex,
+                                   &obj->ip4_address.address,
+                                   obj->ip4_address.plen,
+                                   &obj->ip4_address.peer_address,
+                                   0,
+                                   RT_SCOPE_NOWHERE,
+                                   NM_PLATFORM_LIFETIME_PERMANENT,
+                                   NM_PLATFORM_LIFETIME_PERMANENT,
+                                   0,
+                                   NULL);
+    case NMP_OBJECT_TYPE_IP6_ADDRESS:
+        return _nl_msg_new_address(RTM_DELADDR,
+                                   0,
+                                   AF_INET6,
+                                   obj->ip6_address.ifindex,
+                                   &obj->ip6_address.address,
+                                   obj->ip6_address.plen,
+                                   NULL,
+                                   0,
+                                   RT_SCOPE_NOWHERE,
+                                   NM_PLATFORM_LIFETIME_PERMANENT,
+                                   NM_PLATFORM_LIFETIME_PERMANENT,
+                                   0,
+                                   NULL);
+    case NMP_OBJECT_TYPE_ROUTING_RULE:
+        return _nl_msg_new_routing_rule(RTM_DELRULE, 0, NMP_OBJECT_CAST_ROUTING_RULE(obj));
+    case NMP_OBJECT_TYPE_QDISC:
+        return _nl_msg_new_qdisc(RTM_DELQDISC, 0, NMP_OBJECT_CAST_QDISC(obj));
+    case NMP_OBJECT_TYPE_TFILTER:
+        return _nl_msg_new_tfilter(RTM_DELTFILTER, 0, NMP_OBJECT_CAST_TFILTER(obj));
+    default:
+        return NULL;
+    }
+}
+
+static void
+object_batch(NMPlatform *platform, NMPlatformObjBatchOp *ops, guint n_ops)
+{
+    gs_unref_ptrarray GPtrArray *keep_alive = NULL;
+    guint                        i_next;
+    int                          try_count = 0;
+    guint                        i;
+
+    if (n_ops == 0)
+        return;
+
+    for (i = 0; i < n_ops; i++) {
+        if (!NMP_OBJECT_IS_STACKINIT(ops[i].obj)) {
+            /* Objects from the cache might get destroyed while we process the
+             * responses. Keep them alive. */
+            if (!keep_alive)
+                keep_alive = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+            g_ptr_array_add(keep_alive, (gpointer) nmp_object_ref(ops[i].obj));
+        }
+    }
+
+    event_handler_read_netlink(platform, NMP_NETLINK_ROUTE, FALSE);
+
+    i_next = 0;
+    while (i_next < n_ops) {
+        struct nl_msg          *nlmsgs[OBJECT_BATCH_WINDOW_SIZE];
+        WaitForNlResponseResult seq_results[OBJECT_BATCH_WINDOW_SIZE];
+        char                   *extack_msgs[OBJECT_BATCH_WINDOW_SIZE];
+        guint                   i_msg[OBJECT_BATCH_WINDOW_SIZE];
+        const guint             n_window = NM_MIN(n_ops - i_next, OBJECT_BATCH_WINDOW_SIZE);
+        guint                   n_nlmsgs = 0;
+        guint                   i_resync = G_MAXUINT;
+        int                     nle      = 0;
+        guint                   j;
+
+        for (j = 0; j < n_window; j++) {
+            NMPlatformObjBatchOp *op = &ops[i_next + j];
+
+            nm_clear_g_free(&op->extack_msg);
+
+            i_msg[j]         = G_MAXUINT;
+            nlmsgs[n_nlmsgs] = _nl_msg_new_batch_op(op);
+            if (!nlmsgs[n_nlmsgs]) {
+                nm_assert_not_reached();
+                continue;
+            }
+            seq_results[n_nlmsgs] = WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN;
+            extack_msgs[n_nlmsgs] = NULL;
+            i_msg[j]              = n_nlmsgs++;
+        }
+
+        if (n_nlmsgs > 0) {
+            nle = _netlink_send_nlmsg_rtnl_batch(platform,
+                                                 nlmsgs,
+                                                 n_nlmsgs,
+                                                 seq_results,
+                                                 extack_msgs);
+            for (j = 0; j < n_nlmsgs; j++)
+                nlmsg_free(nlmsgs[j]);
+            if (nle >= 0)
+                delayed_action_handle_all(platform);
+        }
+
+        for (j = 0; j < n_window; j++) {
+            NMPlatformObjBatchOp   *op = &ops[i_next + j];
+            WaitForNlResponseResult seq_result;
+            char                    sbuf1[NM_UTILS_TO_STRING_BUFFER_SIZE];
+            char                    s_buf[256];
+            const char             *log_detail = "";
+            gboolean                success;
+
+            if (i_msg[j] == G_MAXUINT) {
+                /* we failed to create the message. */
+                op->result = -NME_BUG;
+                continue;
+            }
+
+            if (nle < 0) {
+                _LOGE("do-%s-%s[%s]: failure sending netlink request \"%s\" (%d)",
+                      op->is_delete ? "delete" : "add",
+                      NMP_OBJECT_GET_CLASS(op->obj)->obj_type_name,
+                      nmp_object_to_string(op->obj, NMP_OBJECT_TO_STRING_ID, sbuf1, sizeof(sbuf1)),
+                      nm_strerror(nle),
+                      -nle);
+                op->result = -NME_PL_NETLINK;
+                continue;
+            }
+
+            seq_result     = seq_results[i_msg[j]];
+            op->extack_msg = extack_msgs[i_msg[j]];
+
+            nm_assert(seq_result != WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN);
+
+            if (op->is_delete)
+                success = _delete_object_result_is_success(op->obj, seq_result, &log_detail);
+            else {
+                success = (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK
+                           || (NM_FLAGS_HAS(op->nlm_flags, NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE)
+                               && seq_result < 0));
+            }
+
+            _NMLOG(success ? LOGL_DEBUG : LOGL_WARN,
+                   "do-%s-%s[%s]: %s%s",
+                   op->is_delete ? "delete" : "add",
+                   NMP_OBJECT_GET_CLASS(op->obj)->obj_type_name,
+                   nmp_object_to_string(op->obj, NMP_OBJECT_TO_STRING_ID, sbuf1, sizeof(sbuf1)),
+                   wait_for_nl_response_to_string(seq_result, op->extack_msg, s_buf, sizeof(s_buf)),
+                   log_detail);
+
+            if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_FAILED_RESYNC && i_resync == G_MAXUINT)
+                i_resync = j;
+
+            if (op->is_delete)
+                op->result = success ? 0 : wait_for_nl_response_to_nmerr(seq_result);
+            else
+                op->result = wait_for_nl_response_to_nmerr(seq_result);
+        }
+
+        if (i_resync != G_MAXUINT && ++try_count < RESYNC_RETRIES) {
+            /* The response got lost, we don't know whether kernel applied the
+             * request. Send it again, together with all requests that followed
+             * it, so that kernel still sees them in their original order (for
+             * example, the deletion of a route before the addition of its
+             * replacement). Replaying a request that already succeeded is
+             * harmless: deletions then fail with ESRCH and additions with
+             * EEXIST, which the callers accept. */
+            i_next += i_resync;
+            continue;
+        }
+
+        i_next += n_window;
+    }
+
+    for (i = 0; i < n_ops; i++) {
+        const NMPObject *obj = ops[i].obj;
+
+        /* Like do_delete_object(), refetch objects that are still in the cache
+         * after the ACK (rh#1484434). */
+        if (ops[i].is_delete
+            && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj),
+                         NMP_OBJECT_TYPE_IP6_ADDRESS,
+                         NMP_OBJECT_TYPE_QDISC,
+                         NMP_OBJECT_TYPE_TFILTER)
+            && nmp_cache_lookup_obj(nm_platform_get_cache(platform), obj))
+            do_request_one_type_by_needle_object(platform, obj);
+    }
+}
+
 /*****************************************************************************/
 
 static int
@@ -11208,6 +12228,40 @@ _nl_event_handler_rtnl(int fd, GIOCondition io_condition, gpointer user_data)
     return _nl_event_handler(user_data, DELAYED_ACTION_TYPE_READ_RTNL);
 }
 
+static gboolean
+_resync_backoff_cb(NMPlatform *platform, NMPNetlinkProtocol netlink_protocol)
+{
+    NMLinuxPlatformPrivate  *priv       = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    NetlinkProtocolPrivData *proto_data = &priv->proto_data_x[netlink_protocol];
+
+    nm_clear_g_source_inst(&proto_data->resync_backoff_source);
+
+    proto_data->resync_count++;
+
+    _LOGI("netlink[%s]: backoff done. Resynchronize platform cache (overflows: %" G_GUINT64_FORMAT
+          ", coalesced: %" G_GUINT64_FORMAT ", resyncs: %" G_GUINT64_FORMAT ")",
+          nmp_netlink_protocol_info(netlink_protocol)->name,
+          proto_data->overflow_count,
+          proto_data->overflow_coalesced_count,
+          proto_data->resync_count);
+
+    delayed_action_schedule_refresh_all(platform, netlink_protocol);
+    delayed_action_handle_all(platform);
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+_resync_backoff_cb_genl(gpointer user_data)
+{
+    return _resync_backoff_cb(user_data, NMP_NETLINK_GENERIC);
+}
+
+static gboolean
+_resync_backoff_cb_rtnl(gpointer user_data)
+{
+    return _resync_backoff_cb(user_data, NMP_NETLINK_ROUTE);
+}
+
 /*****************************************************************************/
 
 static int
@@ -11215,18 +12269,19 @@ _netlink_recv_handle(NMPlatform        *platform,
                      NMPNetlinkProtocol netlink_protocol,
                      gboolean           handle_events)
 {
-    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
-    int                     n;
-    int                     retval      = 0;
-    gboolean                multipart   = 0;
-    gboolean                interrupted = FALSE;
-    struct nlmsghdr        *hdr;
-    struct sockaddr_nl      nla;
-    struct ucred            creds;
-    gboolean                creds_has;
-    guint32                 pktinfo_group = 0;
-    gboolean                pktinfo_has   = FALSE;
-    const char *const       log_prefix    = nmp_netlink_protocol_info(netlink_protocol)->name;
+    NMLinuxPlatformPrivate  *priv       = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    NetlinkProtocolPrivData *proto_data = &priv->proto_data_x[netlink_protocol];
+    int                      n;
+    int                      retval      = 0;
+    gboolean                 multipart   = 0;
+    gboolean                 interrupted = FALSE;
+    struct nlmsghdr         *hdr;
+    struct sockaddr_nl       nla;
+    struct ucred             creds;
+    gboolean                 creds_has;
+    guint32                  pktinfo_group = 0;
+    gboolean                 pktinfo_has   = FALSE;
+    const char *const        log_prefix    = nmp_netlink_protocol_info(netlink_protocol)->name;
 
 continue_reading:
 
@@ -11243,6 +12298,9 @@ continue_reading:
         return n;
     }
 
+    proto_data->rx_bytes += n;
+    proto_data->burst_bytes += n;
+
     if (!creds_has || creds.pid) {
         if (!creds_has)
             _LOGT("%s: recvmsg: received message without credentials", log_prefix);
@@ -11268,6 +12326,19 @@ continue_reading:
 
         nm_assert((((uintptr_t) (const void *) msg.nm_nlh) % NLMSG_ALIGNTO) == 0);
 
+        proto_data->rx_messages++;
+
+        if (priv->event_history.size > 0) {
+            PlatformEvent *event = _event_history_add(platform, EVENT_TYPE_NETLINK);
+
+            memset(&event->netlink.msg, 0, sizeof(event->netlink.msg));
+            memcpy(&event->netlink.msg,
+                   msg.nm_nlh,
+                   NM_MIN((gsize) msg.nm_nlh->nlmsg_len, sizeof(event->netlink.msg)));
+            event->netlink.pktinfo_group    = pktinfo_group;
+            event->netlink.netlink_protocol = netlink_protocol;
+        }
+
         _LOGt("%s: recvmsg: new message %s",
               log_prefix,
               nl_nlmsghdr_to_str(nmp_netlink_protocol_info(netlink_protocol)->netlink_protocol,
@@ -11359,6 +12430,17 @@ continue_reading:
             seq_result = WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK;
         }
 
+        if ((msg.nm_nlh->nlmsg_flags & NLM_F_DUMP_INTR) && seq_result >= 0) {
+            /* The dump is inconsistent. Remember that for the request, so that
+             * it gets restarted. */
+            seq_result = WAIT_FOR_NL_RESPONSE_RESULT_FAILED_DUMP_INTR;
+        } else if (G_UNLIKELY(priv->nmtst_dump_intr.n > 0) && seq_result >= 0
+                   && (msg.nm_nlh->nlmsg_flags & NLM_F_MULTI)
+                   && msg.nm_nlh->nlmsg_type == priv->nmtst_dump_intr.nlmsg_type) {
+            priv->nmtst_dump_intr.n--;
+            seq_result = WAIT_FOR_NL_RESPONSE_RESULT_FAILED_DUMP_INTR;
+        }
+
         event_seq_check(platform, netlink_protocol, seq_number, seq_result, extack_msg);
 
         if (retval != 0)
@@ -11387,6 +12469,59 @@ stop:
 
 /*****************************************************************************/
 
+static void
+_netlink_rcvbuf_adapt(NMPlatform *platform, NMPNetlinkProtocol netlink_protocol, gboolean overflow)
+{
+    NMLinuxPlatformPrivate  *priv       = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    NetlinkProtocolPrivData *proto_data = &priv->proto_data_x[netlink_protocol];
+    gsize                    burst_bytes;
+    int                      rcvbuf_size;
+    int                      r;
+
+    burst_bytes             = proto_data->burst_bytes;
+    proto_data->burst_bytes = 0;
+
+    if (proto_data->rcvbuf_at_limit || proto_data->rcvbuf_size <= 0
+        || proto_data->rcvbuf_size >= NETLINK_RCVBUF_MAX)
+        return;
+
+    /* The kernel accounts the memory of the queued skbs, which is considerably
+     * more than the payload that we read. Grow the buffer already when a burst
+     * reaches a quarter of it, so that the next (larger) burst still fits. */
+    if (!overflow && burst_bytes < (gsize) proto_data->rcvbuf_size / 4)
+        return;
+
+    rcvbuf_size = NM_MIN(proto_data->rcvbuf_size, NETLINK_RCVBUF_MAX / 2) * 2;
+
+    r = nl_socket_set_rcvbuf_force(priv->sk_x[netlink_protocol], rcvbuf_size);
+    if (r < 0) {
+        _LOGW("netlink[%s]: failed to grow receive buffer to %d bytes: %s",
+              nmp_netlink_protocol_info(netlink_protocol)->name,
+              rcvbuf_size,
+              nm_strerror(r));
+        return;
+    }
+
+    r = nl_socket_get_rcvbuf(priv->sk_x[netlink_protocol]);
+    if (r <= proto_data->rcvbuf_size) {
+        /* We are not privileged and already at the limit of net.core.rmem_max.
+         * Don't retry. */
+        _LOGD("netlink[%s]: cannot grow receive buffer beyond %d bytes",
+              nmp_netlink_protocol_info(netlink_protocol)->name,
+              proto_data->rcvbuf_size);
+        proto_data->rcvbuf_at_limit = TRUE;
+        return;
+    }
+
+    _LOGD("netlink[%s]: grow receive buffer from %d to %d bytes (%s, burst of %zu bytes)",
+          nmp_netlink_protocol_info(netlink_protocol)->name,
+          proto_data->rcvbuf_size,
+          r,
+          overflow ? "overflow" : "large burst",
+          burst_bytes);
+    proto_data->rcvbuf_size = r;
+}
+
 static gboolean
 event_handler_read_netlink(NMPlatform        *platform,
                            NMPNetlinkProtocol netlink_protocol,
@@ -11415,15 +12550,18 @@ event_handler_read_netlink(NMPlatform        *platform,
 
     for (;;) {
         for (;;) {
-            int nle;
+            NetlinkProtocolPrivData *proto_data;
+            int                      nle;
 
             nle = _netlink_recv_handle(platform, netlink_protocol, TRUE);
 
             if (nle < 0) {
                 switch (nle) {
                 case -EAGAIN:
+                    _netlink_rcvbuf_adapt(platform, netlink_protocol, FALSE);
                     goto after_read;
                 case -NME_NL_DUMP_INTR:
+                    /* The interrupted dump gets restarted, see delayed_action_refresh_all_done(). */
                     _LOGD("netlink[%s]: read: uncritical failure to retrieve incoming events: %s "
                           "(%d)",
                           nmp_netlink_protocol_info(netlink_protocol)->name,
@@ -11447,25 +12585,51 @@ event_handler_read_netlink(NMPlatform        *platform,
                               _reason;
                           }));
 
+                    /* We cannot resync only some interfaces or tables. The lost
+                     * notifications could have been about any object, and kernel does
+                     * not tell us which ones. A dump that only covers a part of the
+                     * objects would leave the rest stale. The full resync is still
+                     * cheap for routes, because we only dump the protocols that we
+                     * track. */
+                    _netlink_recv_handle(platform, netlink_protocol, FALSE);
+                    delayed_action_wait_for_nl_response_complete_all(
+                        platform,
+                        netlink_protocol,
+                        WAIT_FOR_NL_RESPONSE_RESULT_FAILED_RESYNC);
+
+                    proto_data = &priv->proto_data_x[netlink_protocol];
+
                     if (nle == -ENOBUFS) {
+                        proto_data->overflow_count++;
+                        _netlink_rcvbuf_adapt(platform, netlink_protocol, TRUE);
+                    }
+
+                    if (proto_data->resync_backoff_source) {
+                        /* A resync is already pending. It will also cover
+                         * whatever we lost now. */
+                        proto_data->overflow_coalesced_count++;
+                        _LOGD("netlink[%s]: resync already scheduled",
+                              nmp_netlink_protocol_info(netlink_protocol)->name);
+                    } else if (nle == -ENOBUFS) {
                         /* Netlink notifications are coming faster than what
                          * we can process them. Backoff a bit so we give some
                          * time for this burst to finish, and we don't
                          * contribute to starve the system contending for the
-                         * kernel's RTNL lock.
+                         * kernel's RTNL lock. Don't block the main loop for
+                         * that, but resync from a timer.
                          */
                         _LOGI("netlink[%s]: backoff for %d seconds before the resync.",
                               nmp_netlink_protocol_info(netlink_protocol)->name,
                               RESYNC_BACKOFF_SECONDS);
-                        sleep(RESYNC_BACKOFF_SECONDS);
+                        proto_data->resync_backoff_source = nm_g_timeout_add_seconds_source(
+                            RESYNC_BACKOFF_SECONDS,
+                            netlink_protocol == NMP_NETLINK_ROUTE ? _resync_backoff_cb_rtnl
+                                                                  : _resync_backoff_cb_genl,
+                            platform);
+                    } else {
+                        proto_data->resync_count++;
+                        delayed_action_schedule_refresh_all(platform, netlink_protocol);
                     }
-
-                    _netlink_recv_handle(platform, netlink_protocol, FALSE);
-                    delayed_action_wait_for_nl_response_complete_all(
-                        platform,
-                        netlink_protocol,
-                        WAIT_FOR_NL_RESPONSE_RESULT_FAILED_RESYNC);
-                    delayed_action_schedule_refresh_all(platform, netlink_protocol);
                     break;
                 default:
                     _LOGE("netlink[%s]: read: failed to retrieve incoming events: %s (%d)",
@@ -12139,6 +13303,8 @@ constructed(GObject *_object)
     nle = nl_socket_add_memberships(priv->sk_genl, GENL_ID_CTRL, 0);
     g_assert(!nle);
 
+    priv->proto_data_genl.rcvbuf_size = nl_socket_get_rcvbuf(priv->sk_genl);
+
     fd = nl_socket_get_fd(priv->sk_genl);
 
     _LOGD("genl: generic netlink socket created: port=%u, fd=%d",
@@ -12162,6 +13328,12 @@ constructed(GObject *_object)
                         0);
     g_assert(!nle);
 
+    nle = ip_route_attach_socket_filter(priv->sk_rtnl);
+    if (nle < 0) {
+        _LOGW("rtnl: failed to attach socket filter for untracked routes: %s",
+              nm_strerror(nle));
+    }
+
     nle = nl_socket_add_memberships(priv->sk_rtnl,
                                     RTNLGRP_IPV4_IFADDR,
                                     RTNLGRP_IPV4_ROUTE,
@@ -12178,6 +13350,8 @@ constructed(GObject *_object)
         nm_assert(!nle);
     }
 
+    priv->proto_data_rtnl.rcvbuf_size = nl_socket_get_rcvbuf(priv->sk_rtnl);
+
     fd = nl_socket_get_fd(priv->sk_rtnl);
 
     _LOGD("rtnl: rtnetlink socket created: port=%u, fd=%d",
@@ -12252,6 +13426,77 @@ path_is_read_only_fs(const char *path)
     return FALSE;
 }
 
+/**
+ * nm_linux_platform_get_netlink_stats:
+ * @platform: the #NMLinuxPlatform instance.
+ * @netlink_protocol: either NETLINK_ROUTE or NETLINK_GENERIC.
+ * @out_stats: (out): the statistics.
+ *
+ * Returns how much the netlink socket of @netlink_protocol received,
+ * how often it overflowed and how often the cache got resynchronized
+ * as consequence.
+ */
+void
+nm_linux_platform_get_netlink_stats(NMPlatform                  *platform,
+                                    int                          netlink_protocol,
+                                    NMLinuxPlatformNetlinkStats *out_stats)
+{
+    NMLinuxPlatformPrivate  *priv;
+    NetlinkProtocolPrivData *proto_data;
+
+    g_return_if_fail(NM_IS_LINUX_PLATFORM(platform));
+    g_return_if_fail(NM_IN_SET(netlink_protocol, NETLINK_ROUTE, NETLINK_GENERIC));
+    g_return_if_fail(out_stats);
+
+    priv       = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    proto_data = netlink_protocol == NETLINK_ROUTE ? &priv->proto_data_rtnl
+                                                   : &priv->proto_data_genl;
+
+    *out_stats = (NMLinuxPlatformNetlinkStats) {
+        .overflows           = proto_data->overflow_count,
+        .overflows_coalesced = proto_data->overflow_coalesced_count,
+        .resyncs             = proto_data->resync_count,
+        .rx_bytes            = proto_data->rx_bytes,
+        .rx_messages         = proto_data->rx_messages,
+        .rcvbuf_size         = NM_MAX(proto_data->rcvbuf_size, 0),
+        .resync_pending      = !!proto_data->resync_backoff_source,
+    };
+}
+
+void
+nmtst_linux_platform_set_dump_intr(NMPlatform *platform, guint16 nlmsg_type, guint n)
+{
+    NMLinuxPlatformPrivate *priv;
+
+    g_return_if_fail(NM_IS_LINUX_PLATFORM(platform));
+
+    priv                             = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    priv->nmtst_dump_intr.nlmsg_type = nlmsg_type;
+    priv->nmtst_dump_intr.n          = n;
+}
+
+void
+nmtst_linux_platform_refresh_all(NMPlatform *platform)
+{
+    g_return_if_fail(NM_IS_LINUX_PLATFORM(platform));
+
+    delayed_action_schedule_refresh_all(platform, NMP_NETLINK_ROUTE);
+    delayed_action_handle_all(platform);
+}
+
+int
+nmtst_linux_platform_get_netlink_fd(NMPlatform *platform, int netlink_protocol)
+{
+    NMLinuxPlatformPrivate *priv;
+
+    g_return_val_if_fail(NM_IS_LINUX_PLATFORM(platform), -1);
+    g_return_val_if_fail(NM_IN_SET(netlink_protocol, NETLINK_ROUTE, NETLINK_GENERIC), -1);
+
+    priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    return nl_socket_get_fd(netlink_protocol == NETLINK_ROUTE ? priv->sk_rtnl : priv->sk_genl);
+}
+
 NMPlatform *
 nm_linux_platform_new(NMDedupMultiIndex *multi_idx,
                       gboolean           log_with_ptr,
@@ -12293,6 +13538,9 @@ dispose(GObject *object)
                                                      NMP_NETLINK_ROUTE,
                                                      WAIT_FOR_NL_RESPONSE_RESULT_FAILED_DISPOSING);
 
+    nm_clear_g_source_inst(&priv->proto_data_genl.resync_backoff_source);
+    nm_clear_g_source_inst(&priv->proto_data_rtnl.resync_backoff_source);
+
     priv->delayed_action.flags = DELAYED_ACTION_TYPE_NONE;
     g_ptr_array_set_size(priv->delayed_action.list_controller_connected, 0);
     g_ptr_array_set_size(priv->delayed_action.list_refresh_link, 0);
@@ -12331,6 +13579,8 @@ finalize(GObject *object)
 
     priv->udev_client = nm_udev_client_destroy(priv->udev_client);
 
+    _event_history_clear(NM_PLATFORM(object));
+
     G_OBJECT_CLASS(nm_linux_platform_parent_class)->finalize(object);
 
     g_free(priv->netlink_recv_buf.buf);
@@ -12419,6 +13669,7 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->link_tun_add = link_tun_add;
 
     platform_class->object_delete      = object_delete;
+    platform_class->object_batch       = object_batch;
     platform_class->ip4_address_add    = ip4_address_add;
     platform_class->ip6_address_add    = ip6_address_add;
     platform_class->ip4_address_delete = ip4_address_delete;
@@ -12434,7 +13685,9 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->tfilter_add    = tfilter_add;
     platform_class->tfilter_delete = tfilter_delete;
 
-    platform_class->process_events = process_events;
+    platform_class->process_events    = process_events;
+    platform_class->set_event_history = set_event_history;
+    platform_class->get_events        = get_events;
 
     platform_class->genl_get_family_id = genl_get_family_id;
     platform_class->mptcp_addr_update  = mptcp_addr_update;
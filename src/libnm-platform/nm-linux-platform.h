@@ -28,6 +28,20 @@ struct _NMDedupMultiIndex;
 NMEtherAddr **
 nm_linux_platform_get_bridge_fdb(NMPlatform *platform, int *ifindexes, guint ifindexes_len);
 
+typedef struct {
+    guint64 overflows;
+    guint64 overflows_coalesced;
+    guint64 resyncs;
+    guint64 rx_bytes;
+    guint64 rx_messages;
+    int     rcvbuf_size;
+    bool    resync_pending;
+} NMLinuxPlatformNetlinkStats;
+
+void nm_linux_platform_get_netlink_stats(NMPlatform                  *platform,
+                                         int                          netlink_protocol,
+                                         NMLinuxPlatformNetlinkStats *out_stats);
+
 NMPlatform *nm_linux_platform_new(struct _NMDedupMultiIndex *multi_idx,
                                   gboolean                   log_with_ptr,
                                   gboolean                   netns_support,
@@ -1063,6 +1063,40 @@ nl_socket_set_buffer_size(struct nl_sock *sk, int rxbuf, int txbuf)
     return 0;
 }
 
+int
+nl_socket_set_rcvbuf_force(struct nl_sock *sk, int rxbuf)
+{
+    nm_assert_sk(sk);
+    nm_assert(rxbuf > 0);
+
+    /* SO_RCVBUFFORCE lets privileged processes exceed net.core.rmem_max.
+     * Otherwise, fall back to SO_RCVBUF, which gets silently clamped. */
+    if (setsockopt(sk->s_fd, SOL_SOCKET, SO_RCVBUFFORCE, &rxbuf, sizeof(rxbuf)) == 0)
+        return 0;
+
+    if (setsockopt(sk->s_fd, SOL_SOCKET, SO_RCVBUF, &rxbuf, sizeof(rxbuf)) < 0)
+        return -nm_errno_from_native(errno);
+
+    return 0;
+}
+
+int
+nl_socket_get_rcvbuf(struct nl_sock *sk)
+{
+    int       rxbuf = 0;
+    socklen_t len   = sizeof(rxbuf);
+
+    nm_assert_sk(sk);
+
+    if (getsockopt(sk->s_fd, SOL_SOCKET, SO_RCVBUF, &rxbuf, &len) < 0)
+        return -nm_errno_from_native(errno);
+
+    /* The kernel reports twice the value that was set, to account for its
+     * bookkeeping overhead. Return the size that one would pass to
+     * nl_socket_set_rcvbuf_force(). */
+    return rxbuf / 2;
+}
+
 int
 nl_socket_add_memberships(struct nl_sock *sk, int group, ...)
 {
@@ -26,4 +26,16 @@ void nm_platform_cache_update_emit_signal(NMPlatform      *platform,
                                           const NMPObject *obj_old,
                                           const NMPObject *obj_new);
 
+/*****************************************************************************/
+
+int  nmtst_linux_platform_get_netlink_fd(NMPlatform *platform, int netlink_protocol);
+void nmtst_linux_platform_set_dump_intr(NMPlatform *platform, guint16 nlmsg_type, guint n);
+void nmtst_linux_platform_refresh_all(NMPlatform *platform);
+
+struct nlmsghdr;
+
+NMPObject *nmtst_linux_platform_new_object_from_nl(NMPlatform            *platform,
+                                                   const NMPCache        *cache,
+                                                   const struct nlmsghdr *nlh);
+
 #endif /* __NM_PLATFORM_PRIVATE_H__ */
@@ -259,6 +259,10 @@ G_DEFINE_TYPE(NMPlatform, nm_platform, G_TYPE_OBJECT)
 
 static void _ip4_dev_route_blacklist_schedule(NMPlatform *self);
 
+static gboolean _ip_route_stackinit(NMPObject *obj_stack, const NMPObject *obj);
+static void     _ip_route_add_prepare(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack);
+static void     _object_batch(NMPlatform *self, NMPlatformObjBatchOp *ops, guint n_ops);
+
 /*****************************************************************************/
 
 gboolean
@@ -545,6 +549,67 @@ nm_platform_process_events(NMPlatform *self)
         klass->process_events(self);
 }
 
+/**
+ * nm_platform_set_event_history:
+ * @self: platform instance
+ * @size: the number of recent events to remember. Zero disables
+ *   recording and drops the events remembered so far.
+ *
+ * The platform can remember recent cache changes and netlink messages
+ * without formatting them. They can be inspected later via
+ * nm_platform_get_events(), without having TRACE logging enabled all the time.
+ */
+void
+nm_platform_set_event_history(NMPlatform *self, guint size)
+{
+    _CHECK_SELF_VOID(self, klass);
+
+    if (klass->set_event_history)
+        klass->set_event_history(self, size);
+}
+
+/**
+ * nm_platform_get_events:
+ * @self: platform instance
+ * @max_age_msec: only return events that are not older than this many
+ *   milliseconds. A negative value returns all remembered events.
+ *
+ * Returns: (transfer full): a snapshot of the remembered events, rendered
+ *   as text and oldest first. Empty if nm_platform_set_event_history() did
+ *   not enable recording.
+ */
+char **
+nm_platform_get_events(NMPlatform *self, gint64 max_age_msec)
+{
+    _CHECK_SELF(self, klass, NULL);
+
+    if (!klass->get_events)
+        return g_new0(char *, 1);
+    return klass->get_events(self, max_age_msec);
+}
+
+/**
+ * nm_platform_dump_events:
+ * @self: platform instance
+ * @max_age_msec: only log events that are not older than this many
+ *   milliseconds. A negative value logs all remembered events.
+ *
+ * Logs the snapshot of nm_platform_get_events() at INFO level.
+ */
+void
+nm_platform_dump_events(NMPlatform *self, gint64 max_age_msec)
+{
+    gs_strfreev char **lines = NULL;
+    guint              i;
+
+    _CHECK_SELF_VOID(self, klass);
+
+    lines = nm_platform_get_events(self, max_age_msec);
+    for (i = 0; lines[i]; i++)
+        _LOGI("%s", lines[i]);
+    _LOGI("event: dumped %u recorded platform events", i);
+}
+
 const NMPlatformLink *
 nm_platform_process_events_ensure_link(NMPlatform *self, int ifindex, const char *ifname)
 {
@@ -4413,23 +4478,27 @@ nm_platform_ip_address_sync(NMPlatform           *self,
         known_addresses = NULL;
 
     if (nm_g_ptr_array_len(addresses_prune) > 0) {
+        gs_free const NMPObject **objs_delete = NULL;
+        guint                     n_delete    = 0;
+
         /* First delete addresses that we should prune (and which are no longer tracked
-         * as @known_addresses. */
+         * as @known_addresses. The deletions are sent as one batch. */
+        objs_delete = g_new(const NMPObject *, addresses_prune->len);
         for (i = 0; i < addresses_prune->len; i++) {
             const NMPObject *prune_obj = addresses_prune->pdata[i];
 
             nm_assert(NM_IN_SET(NMP_OBJECT_GET_TYPE(prune_obj),
                                 NMP_OBJECT_TYPE_IP4_ADDRESS,
                                 NMP_OBJECT_TYPE_IP6_ADDRESS));
+            nm_assert(NMP_OBJECT_CAST_IP_ADDRESS(prune_obj)->ifindex == ifindex);
 
             if (nm_g_hash_table_contains(known_addresses_idx, prune_obj))
                 continue;
 
-            nm_platform_ip_address_delete(self,
-                                          addr_family,
-                                          ifindex,
-                                          NMP_OBJECT_CAST_IP_ADDRESS(prune_obj));
+            objs_delete[n_delete++] = prune_obj;
         }
+
+        nm_platform_object_delete_many(self, objs_delete, n_delete, NULL);
     }
 
     /* ensure we have the platform cache up to date. */
@@ -5176,7 +5245,13 @@ nm_platform_ip_route_sync(NMPlatform *self,
     const int                      IS_IPv4 = NM_IS_IPv4(addr_family);
     const NMPlatformVTableRoute   *vt;
     gs_unref_hashtable GHashTable *routes_idx = NULL;
+    gs_free NMPlatformObjBatchOp  *ops        = NULL;
+    gs_free const NMPObject      **ops_conf   = NULL;
+    gs_free NMPObject             *objs_stack = NULL;
+    guint                          n_ops      = 0;
+    guint                          n_stack    = 0;
     const NMPObject               *conf_o;
+    const NMPObject               *prune_o;
     const NMDedupMultiEntry       *plat_entry;
     guint                          i;
     int                            i_type;
@@ -5189,10 +5264,17 @@ nm_platform_ip_route_sync(NMPlatform *self,
 
     vt = &nm_platform_vtable_route.vx[IS_IPv4];
 
+    if (routes && routes->len > 0) {
+        /* Each route to configure results at most in one deletion (of a conflicting
+         * route) and one addition. */
+        ops        = g_new(NMPlatformObjBatchOp, 2u * routes->len);
+        ops_conf   = g_new(const NMPObject *, 2u * routes->len);
+        objs_stack = g_new(NMPObject, routes->len);
+    }
+
     for (i_type = 0; routes && i_type < 2; i_type++) {
         for (i = 0; i < routes->len; i++) {
-            gs_free char *extack_msg = NULL;
-            int           r;
+            NMPObject *obj_stack;
 
             conf_o = routes->pdata[i];
 
@@ -5212,7 +5294,9 @@ nm_platform_ip_route_sync(NMPlatform *self,
                 || (i_type == 1 && VTABLE_IS_DEVICE_ROUTE(vt, conf_o))) {
                 /* we add routes in two runs over @i_type.
                  *
-                 * First device routes, then gateway routes. */
+                 * First device routes, then gateway routes. Kernel processes the
+                 * batched requests in order, so the device routes are already
+                 * configured when the gateway routes get added. */
                 continue;
             }
 
@@ -5242,74 +5326,100 @@ nm_platform_ip_route_sync(NMPlatform *self,
                     continue;
 
                 /* we need to replace the existing route with a (slightly) different
-                 * one. Delete it first. */
-                if (!nm_platform_object_delete(self, plat_o)) {
-                    /* ignore error. */
-                }
+                 * one. Delete it first. Errors are ignored. */
+                ops_conf[n_ops] = NULL;
+
+                ops[n_ops++] = (NMPlatformObjBatchOp) {
+                    .obj       = plat_o,
+                    .is_delete = TRUE,
+                };
             }
 
-            r = nm_platform_ip_route_add(self,
-                                         NMP_NLM_FLAG_APPEND
-                                             | NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE,
-                                         conf_o,
-                                         &extack_msg);
-            if (r == 0) {
-                /* success */
-            } else if (r == -EEXIST) {
-                /* Don't fail for EEXIST. It's not clear that the existing route
-                 * is identical to the one that we were about to add. However,
-                 * above we should have deleted conflicting (non-identical) routes. */
-                if (_LOGD_ENABLED()) {
-                    plat_entry =
-                        nm_platform_lookup_entry(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, conf_o);
-                    if (!plat_entry) {
-                        _LOG3D("route-sync: adding route %s failed with EEXIST, however we "
-                               "cannot find such a route",
-                               nmp_object_to_string(conf_o,
-                                                    NMP_OBJECT_TO_STRING_PUBLIC,
-                                                    sbuf1,
-                                                    sizeof(sbuf1)));
-                    } else if (vt->route_cmp(NMP_OBJECT_CAST_IPX_ROUTE(conf_o),
-                                             NMP_OBJECT_CAST_IPX_ROUTE(plat_entry->obj),
-                                             NM_PLATFORM_IP_ROUTE_CMP_TYPE_SEMANTICALLY)
-                               != 0) {
-                        _LOG3D("route-sync: adding route %s failed due to existing "
-                               "(different!) route %s",
-                               nmp_object_to_string(conf_o,
-                                                    NMP_OBJECT_TO_STRING_PUBLIC,
-                                                    sbuf1,
-                                                    sizeof(sbuf1)),
-                               nmp_object_to_string(plat_entry->obj,
-                                                    NMP_OBJECT_TO_STRING_PUBLIC,
-                                                    sbuf2,
-                                                    sizeof(sbuf2)));
-                    }
+            /* @conf_o is kept alive by @routes, so @obj_stack may alias its
+             * extra_nexthops. */
+            obj_stack = &objs_stack[n_stack++];
+            _ip_route_stackinit(obj_stack, conf_o);
+            _ip_route_add_prepare(self,
+                                  NMP_NLM_FLAG_APPEND | NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE,
+                                  obj_stack);
+
+            ops_conf[n_ops] = conf_o;
+
+            ops[n_ops++] = (NMPlatformObjBatchOp) {
+                .obj       = obj_stack,
+                .nlm_flags = NMP_NLM_FLAG_APPEND | NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE,
+            };
+        }
+    }
+
+    _object_batch(self, ops, n_ops);
+
+    for (i = 0; i < n_ops; i++) {
+        gs_free char *extack_msg = g_steal_pointer(&ops[i].extack_msg);
+        int           r          = ops[i].result;
+
+        conf_o = ops_conf[i];
+        if (!conf_o) {
+            /* ignore errors from deleting conflicting routes. */
+            continue;
+        }
+
+        if (r == 0) {
+            /* success */
+        } else if (r == -EEXIST) {
+            /* Don't fail for EEXIST. It's not clear that the existing route
+             * is identical to the one that we were about to add. However,
+             * above we should have deleted conflicting (non-identical) routes. */
+            if (_LOGD_ENABLED()) {
+                plat_entry = nm_platform_lookup_entry(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, conf_o);
+                if (!plat_entry) {
+                    _LOG3D("route-sync: adding route %s failed with EEXIST, however we "
+                           "cannot find such a route",
+                           nmp_object_to_string(conf_o,
+                                                NMP_OBJECT_TO_STRING_PUBLIC,
+                                                sbuf1,
+                                                sizeof(sbuf1)));
+                } else if (vt->route_cmp(NMP_OBJECT_CAST_IPX_ROUTE(conf_o),
+                                         NMP_OBJECT_CAST_IPX_ROUTE(plat_entry->obj),
+                                         NM_PLATFORM_IP_ROUTE_CMP_TYPE_SEMANTICALLY)
+                           != 0) {
+                    _LOG3D("route-sync: adding route %s failed due to existing "
+                           "(different!) route %s",
+                           nmp_object_to_string(conf_o,
+                                                NMP_OBJECT_TO_STRING_PUBLIC,
+                                                sbuf1,
+                                                sizeof(sbuf1)),
+                           nmp_object_to_string(plat_entry->obj,
+                                                NMP_OBJECT_TO_STRING_PUBLIC,
+                                                sbuf2,
+                                                sizeof(sbuf2)));
                 }
-            } else {
-                _LOG3D(
-                    "route-sync: failure to add IPv%c route: %s: %s%s%s%s",
-                    vt->is_ip4 ? '4' : '6',
-                    nmp_object_to_string(conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof(sbuf1)),
-                    nm_strerror(r),
-                    NM_PRINT_FMT_QUOTED(extack_msg, " (", extack_msg, ")", ""));
+            }
+        } else {
+            _LOG3D("route-sync: failure to add IPv%c route: %s: %s%s%s%s",
+                   vt->is_ip4 ? '4' : '6',
+                   nmp_object_to_string(conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof(sbuf1)),
+                   nm_strerror(r),
+                   NM_PRINT_FMT_QUOTED(extack_msg, " (", extack_msg, ")", ""));
 
-                success = FALSE;
+            success = FALSE;
 
-                if (out_routes_failed) {
-                    if (!*out_routes_failed) {
-                        *out_routes_failed =
-                            g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
-                    }
-                    g_ptr_array_add(*out_routes_failed, (gpointer) nmp_object_ref(conf_o));
+            if (out_routes_failed) {
+                if (!*out_routes_failed) {
+                    *out_routes_failed =
+                        g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
                 }
+                g_ptr_array_add(*out_routes_failed, (gpointer) nmp_object_ref(conf_o));
             }
         }
     }
 
-    if (routes_prune) {
-        for (i = 0; i < routes_prune->len; i++) {
-            const NMPObject *prune_o;
+    if (routes_prune && routes_prune->len > 0) {
+        nm_clear_g_free(&ops);
+        ops   = g_new(NMPlatformObjBatchOp, routes_prune->len);
+        n_ops = 0;
 
+        for (i = 0; i < routes_prune->len; i++) {
             prune_o = routes_prune->pdata[i];
 
             nm_assert((NM_IS_IPv4(addr_family)
@@ -5323,10 +5433,16 @@ nm_platform_ip_route_sync(NMPlatform *self,
             if (!nm_platform_lookup_entry(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, prune_o))
                 continue;
 
-            if (!nm_platform_object_delete(self, prune_o)) {
-                /* ignore error... */
-            }
+            ops[n_ops++] = (NMPlatformObjBatchOp) {
+                .obj       = prune_o,
+                .is_delete = TRUE,
+            };
         }
+
+        /* ignore errors... */
+        _object_batch(self, ops, n_ops);
+        for (i = 0; i < n_ops; i++)
+            nm_clear_g_free(&ops[i].extack_msg);
     }
 
     return success;
@@ -5509,14 +5625,12 @@ nm_platform_ip_route_normalize(int addr_family, NMPlatformIPRoute *route)
     }
 }
 
-static int
-_ip_route_add(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack, char **out_extack_msg)
+static void
+_ip_route_add_prepare(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack)
 {
     char sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
     int  ifindex;
 
-    _CHECK_SELF(self, klass, -NME_BUG);
-
     /* The caller already ensures that this is a stack allocated copy, that
      * - stays alive for the duration of the call.
      * - that the ip_route_add() implementation is allowed to modify.
@@ -5526,7 +5640,6 @@ _ip_route_add(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack, char **
     nm_assert(NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_stack),
                         NMP_OBJECT_TYPE_IP4_ROUTE,
                         NMP_OBJECT_TYPE_IP6_ROUTE));
-    nm_assert(!out_extack_msg || !*out_extack_msg);
 
     nm_assert(NMP_OBJECT_GET_TYPE(obj_stack) != NMP_OBJECT_TYPE_IP4_ROUTE
               || obj_stack->ip4_route.n_nexthops <= 1u || obj_stack->_ip4_route.extra_nexthops);
@@ -5540,6 +5653,16 @@ _ip_route_add(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack, char **
            _nmp_nlm_flag_to_string(flags & NMP_NLM_FLAG_FMASK),
            nm_utils_addr_family_to_char(NMP_OBJECT_GET_ADDR_FAMILY(obj_stack)),
            nmp_object_to_string(obj_stack, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)));
+}
+
+static int
+_ip_route_add(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack, char **out_extack_msg)
+{
+    _CHECK_SELF(self, klass, -NME_BUG);
+
+    nm_assert(!out_extack_msg || !*out_extack_msg);
+
+    _ip_route_add_prepare(self, flags, obj_stack);
 
     /* At this point, we pass "obj_stack" to the klass->ip_route_add() implementation.
      * The callee can rely on:
@@ -5551,6 +5674,25 @@ _ip_route_add(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack, char **
     return klass->ip_route_add(self, flags, obj_stack, out_extack_msg);
 }
 
+static gboolean
+_ip_route_stackinit(NMPObject *obj_stack, const NMPObject *obj)
+{
+    nm_assert(
+        NM_IN_SET(NMP_OBJECT_GET_TYPE(obj), NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE));
+
+    nmp_object_stackinit(obj_stack, NMP_OBJECT_GET_TYPE(obj), &obj->ip_route);
+
+    if (NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_IP4_ROUTE && obj->ip4_route.n_nexthops > 1u) {
+        /* @obj_stack aliases the extra_nexthops of @obj. The caller must ensure
+         * that @obj stays alive as long as @obj_stack is in use. */
+        nm_assert(obj->_ip4_route.extra_nexthops);
+        obj_stack->_ip4_route.extra_nexthops = obj->_ip4_route.extra_nexthops;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
 int
 nm_platform_ip_route_add(NMPlatform      *self,
                          NMPNlmFlags      flags,
@@ -5560,17 +5702,10 @@ nm_platform_ip_route_add(NMPlatform      *self,
     nm_auto_nmpobj const NMPObject *obj_keep_alive = NULL;
     NMPObject                       obj_stack;
 
-    nm_assert(
-        NM_IN_SET(NMP_OBJECT_GET_TYPE(obj), NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE));
-
-    nmp_object_stackinit(&obj_stack, NMP_OBJECT_GET_TYPE(obj), &obj->ip_route);
-
-    if (NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_IP4_ROUTE && obj->ip4_route.n_nexthops > 1u) {
+    if (_ip_route_stackinit(&obj_stack, obj)) {
         /* Ensure @obj stays alive, so we can alias extra_nexthops from the stackallocated
          * @obj_stack. */
-        nm_assert(obj->_ip4_route.extra_nexthops);
-        obj_keep_alive                      = nmp_object_ref(obj);
-        obj_stack._ip4_route.extra_nexthops = obj->_ip4_route.extra_nexthops;
+        obj_keep_alive = nmp_object_ref(obj);
     }
 
     return _ip_route_add(self, flags, &obj_stack, out_extack_msg);
@@ -5617,14 +5752,12 @@ nm_platform_ip6_route_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformI
     return _ip_route_add(self, flags, &obj, NULL);
 }
 
-gboolean
-nm_platform_object_delete(NMPlatform *self, const NMPObject *obj)
+static void
+_object_delete_log(NMPlatform *self, const NMPObject *obj)
 {
     char sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
     int  ifindex;
 
-    _CHECK_SELF(self, klass, FALSE);
-
     if (_LOGD_ENABLED()) {
         switch (NMP_OBJECT_GET_TYPE(obj)) {
         case NMP_OBJECT_TYPE_ROUTING_RULE:
@@ -5633,6 +5766,8 @@ nm_platform_object_delete(NMPlatform *self, const NMPObject *obj)
                   NMP_OBJECT_GET_CLASS(obj)->obj_type_name,
                   nmp_object_to_string(obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)));
             break;
+        case NMP_OBJECT_TYPE_IP4_ADDRESS:
+        case NMP_OBJECT_TYPE_IP6_ADDRESS:
         case NMP_OBJECT_TYPE_IP4_ROUTE:
         case NMP_OBJECT_TYPE_IP6_ROUTE:
         case NMP_OBJECT_TYPE_QDISC:
@@ -5643,13 +5778,160 @@ nm_platform_object_delete(NMPlatform *self, const NMPObject *obj)
                    nmp_object_to_string(obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)));
             break;
         default:
-            g_return_val_if_reached(FALSE);
+            g_return_if_reached();
         }
     }
+}
+
+gboolean
+nm_platform_object_delete(NMPlatform *self, const NMPObject *obj)
+{
+    _CHECK_SELF(self, klass, FALSE);
+
+    _object_delete_log(self, obj);
 
     return klass->object_delete(self, obj);
 }
 
+/**
+ * _object_batch:
+ * @self: the #NMPlatform instance.
+ * @ops: the operations to perform.
+ * @n_ops: the number of operations in @ops.
+ *
+ * Performs the additions and deletions in @ops, in the given order. If the
+ * platform implementation supports it, the requests are sent without waiting
+ * for each individual response, which avoids one netlink round trip per object.
+ * The result for each operation is returned in #NMPlatformObjBatchOp.result.
+ *
+ * Only routes can be added. The routes to add must already be prepared with
+ * _ip_route_add_prepare(). Deletions are supported for addresses, routes,
+ * routing rules, qdiscs and tfilters.
+ */
+static void
+_object_batch(NMPlatform *self, NMPlatformObjBatchOp *ops, guint n_ops)
+{
+    gboolean success;
+    guint    i;
+
+    _CHECK_SELF_VOID(self, klass);
+
+    for (i = 0; i < n_ops; i++) {
+        NMPlatformObjBatchOp *op = &ops[i];
+
+        nm_assert(!op->extack_msg);
+
+        op->result = 0;
+
+        if (op->is_delete) {
+            nm_assert(NM_IN_SET(NMP_OBJECT_GET_TYPE(op->obj),
+                                NMP_OBJECT_TYPE_IP4_ADDRESS,
+                                NMP_OBJECT_TYPE_IP6_ADDRESS,
+                                NMP_OBJECT_TYPE_IP4_ROUTE,
+                                NMP_OBJECT_TYPE_IP6_ROUTE,
+                                NMP_OBJECT_TYPE_ROUTING_RULE,
+                                NMP_OBJECT_TYPE_QDISC,
+                                NMP_OBJECT_TYPE_TFILTER));
+            _object_delete_log(self, op->obj);
+        } else {
+            nm_assert(NMP_OBJECT_IS_STACKINIT(op->obj));
+            nm_assert(NM_IN_SET(NMP_OBJECT_GET_TYPE(op->obj),
+                                NMP_OBJECT_TYPE_IP4_ROUTE,
+                                NMP_OBJECT_TYPE_IP6_ROUTE));
+        }
+    }
+
+    if (klass->object_batch) {
+        klass->object_batch(self, ops, n_ops);
+        return;
+    }
+
+    for (i = 0; i < n_ops; i++) {
+        NMPlatformObjBatchOp *op = &ops[i];
+
+        if (!op->is_delete) {
+            op->result =
+                klass->ip_route_add(self, op->nlm_flags, (NMPObject *) op->obj, &op->extack_msg);
+            continue;
+        }
+
+        switch (NMP_OBJECT_GET_TYPE(op->obj)) {
+        case NMP_OBJECT_TYPE_IP4_ADDRESS:
+            success = klass->ip4_address_delete(self,
+                                                op->obj->ip4_address.ifindex,
+                                                op->obj->ip4_address.address,
+                                                op->obj->ip4_address.plen,
+                                                op->obj->ip4_address.peer_address);
+            break;
+        case NMP_OBJECT_TYPE_IP6_ADDRESS:
+            success = klass->ip6_address_delete(self,
+                                                op->obj->ip6_address.ifindex,
+                                                op->obj->ip6_address.address,
+                                                op->obj->ip6_address.plen);
+            break;
+        default:
+            success = klass->object_delete(self, op->obj);
+            break;
+        }
+        if (!success)
+            op->result = -NME_UNSPEC;
+    }
+}
+
+/**
+ * nm_platform_object_delete_many:
+ * @self: the #NMPlatform instance.
+ * @objs: the objects to delete.
+ * @n_objs: the number of objects in @objs.
+ * @out_results: (out) (optional): if given, an array of @n_objs elements that
+ *   receives 0 or a negative NME error code for each object.
+ *
+ * Deletes all objects in @objs. Unlike calling nm_platform_object_delete() in a
+ * loop, the requests are pipelined and we don't wait for the kernel to acknowledge
+ * each of them before sending the next.
+ *
+ * Supported are addresses, routes, routing rules, qdiscs and tfilters.
+ *
+ * Returns: %TRUE if all objects were deleted (or were already absent).
+ */
+gboolean
+nm_platform_object_delete_many(NMPlatform             *self,
+                               const NMPObject *const *objs,
+                               guint                   n_objs,
+                               int                    *out_results)
+{
+    gs_free NMPlatformObjBatchOp *ops     = NULL;
+    gboolean                      success = TRUE;
+    guint                         i;
+
+    _CHECK_SELF(self, klass, FALSE);
+
+    if (n_objs == 0)
+        return TRUE;
+
+    g_return_val_if_fail(objs, FALSE);
+
+    ops = g_new(NMPlatformObjBatchOp, n_objs);
+    for (i = 0; i < n_objs; i++) {
+        ops[i] = (NMPlatformObjBatchOp) {
+            .obj       = objs[i],
+            .is_delete = TRUE,
+        };
+    }
+
+    _object_batch(self, ops, n_objs);
+
+    for (i = 0; i < n_objs; i++) {
+        if (ops[i].result < 0)
+            success = FALSE;
+        if (out_results)
+            out_results[i] = ops[i].result;
+        nm_clear_g_free(&ops[i].extack_msg);
+    }
+
+    return success;
+}
+
 /*****************************************************************************/
 
 int
@@ -1038,6 +1038,25 @@ typedef enum {
 
 typedef void (*NMPlatformAsyncCallback)(GError *error, gpointer user_data);
 
+typedef struct {
+    /* The object to add or delete.
+     *
+     * For additions, this must be a stack-allocated object (see NMP_OBJECT_IS_STACKINIT())
+     * that is already normalized and that stays alive for the duration of the batch.
+     * Like for the ip_route_add() hook, the implementation is allowed to modify it. */
+    const NMPObject *obj;
+
+    /* (out): the error message that kernel sent along with a failure (if any). */
+    char *extack_msg;
+
+    /* (out): zero on success or a negative error code. For deletions, an object
+     * that is already gone counts as success. */
+    int result;
+
+    NMPNlmFlags nlm_flags;
+    bool        is_delete : 1;
+} NMPlatformObjBatchOp;
+
 typedef struct {
     __NMPlatformObjWithIfindex_COMMON;
     guint32  id;
@@ -1151,6 +1170,8 @@ typedef struct {
 
     void (*refresh_all)(NMPlatform *self, NMPObjectType obj_type);
     void (*process_events)(NMPlatform *self);
+    void (*set_event_history)(NMPlatform *self, guint size);
+    char **(*get_events)(NMPlatform *self, gint64 max_age_msec);
 
     int (*link_add)(NMPlatform            *self,
                     NMLinkType             type,
@@ -1294,6 +1315,11 @@ typedef struct {
 
     gboolean (*object_delete)(NMPlatform *self, const NMPObject *obj);
 
+    /* Optional. Sends all operations to kernel in order, but without waiting for each
+     * response before sending the next request. If unimplemented, NMPlatform falls back
+     * to calling ip_route_add() and object_delete() one by one. */
+    void (*object_batch)(NMPlatform *self, NMPlatformObjBatchOp *ops, guint n_ops);
+
     gboolean (*ip4_address_add)(NMPlatform *self,
                                 int         ifindex,
                                 in_addr_t   address,
@@ -2026,6 +2052,9 @@ const char  *nm_platform_link_get_type_name(NMPlatform *self, int ifindex);
 
 gboolean nm_platform_link_refresh(NMPlatform *self, int ifindex);
 void     nm_platform_process_events(NMPlatform *self);
+void     nm_platform_set_event_history(NMPlatform *self, guint size);
+char   **nm_platform_get_events(NMPlatform *self, gint64 max_age_msec);
+void     nm_platform_dump_events(NMPlatform *self, gint64 max_age_msec);
 
 const NMPlatformLink *
 nm_platform_process_events_ensure_link(NMPlatform *self, int ifindex, const char *ifname);
@@ -2277,6 +2306,10 @@ int nm_platform_link_wireguard_change(NMPlatform                               *
                                       NMPlatformWireGuardChangeFlags            change_flags);
 
 gboolean nm_platform_object_delete(NMPlatform *self, const NMPObject *route);
+gboolean nm_platform_object_delete_many(NMPlatform             *self,
+                                        const NMPObject *const *objs,
+                                        guint                   n_objs,
+                                        int                    *out_results);
 
 gboolean nm_platform_ip4_address_add(NMPlatform *self,
                                      int         ifindex,
@@ -969,7 +969,6 @@ nmp_global_tracker_sync(NMPGlobalTracker *self, NMPObjectType obj_type, gboolean
     TrackObjData                *obj_data;
     TrackObjData                *obj_data_safe;
     CList                       *by_obj_lst_head;
-    guint                        i;
     const TrackData             *td_best;
 
     g_return_if_fail(NMP_IS_GLOBAL_TRACKER(self));
@@ -1034,8 +1033,10 @@ nmp_global_tracker_sync(NMPGlobalTracker *self, NMPObjectType obj_type, gboolean
     }
 
     if (objs_to_delete) {
-        for (i = 0; i < objs_to_delete->len; i++)
-            nm_platform_object_delete(self->platform, objs_to_delete->pdata[i]);
+        nm_platform_object_delete_many(self->platform,
+                                       (const NMPObject *const *) objs_to_delete->pdata,
+                                       objs_to_delete->len,
+                                       NULL);
     }
 
     by_obj_lst_head = _by_obj_lst_head(self, obj_type);
@@ -118,6 +118,8 @@ test_use_symbols(void)
         (void (*)(void)) nl_socket_set_msg_buf_size,
         (void (*)(void)) nlmsg_get_dst,
         (void (*)(void)) nl_socket_set_buffer_size,
+        (void (*)(void)) nl_socket_set_rcvbuf_force,
+        (void (*)(void)) nl_socket_get_rcvbuf,
         (void (*)(void)) nl_socket_add_memberships,
         (void (*)(void)) nl_wait_for_ack,
         (void (*)(void)) nl_recvmsgs,
@@ -474,6 +476,27 @@ test_nmpclass_consistency(void)
 
 /*****************************************************************************/
 
+static void
+test_nl_socket_rcvbuf(void)
+{
+    nm_auto_nlsock struct nl_sock *sk = NULL;
+    int                            r;
+
+    r = nl_socket_new(&sk, NETLINK_ROUTE, NL_SOCKET_FLAGS_NONE, 32768, 0);
+    if (r < 0) {
+        g_test_skip("cannot create netlink socket");
+        return;
+    }
+
+    g_assert_cmpint(nl_socket_get_rcvbuf(sk), ==, 32768);
+
+    r = nl_socket_set_rcvbuf_force(sk, 65536);
+    g_assert_cmpint(r, ==, 0);
+    g_assert_cmpint(nl_socket_get_rcvbuf(sk), ==, 65536);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -489,6 +512,7 @@ main(int argc, char **argv)
                     test_nmp_utils_bridge_vlans_normalize);
     g_test_add_func("/nm-platform/nmp-utils-bridge-vlans-equal",
                     test_nmp_utils_bridge_normalized_vlans_equal);
+    g_test_add_func("/nm-platform/nl-socket-rcvbuf", test_nl_socket_rcvbuf);
 
     return g_test_run();
 }